@@ -178,3 +178,20 @@ uint32_t rvLoadFirmware(addr_t BaseAddr, char * hexfile) {
    return EXIT_SUCCESS;
 }
 
+///////////////////////////////////
+// FUNCTION: 8) rvGetStats
+///////////////////////////////////
+//- Message instruction counter Idx of the picorv32 tile:
+//  2*c issued instructions and 2*c+1 waiting cycles of class c
+uint32_t rvGetStats(addr_t BaseAddr, uint32_t Idx) {
+  uint32_t stats_op = 5;
+  uint32_t status_offset = 0x0;
+  uint32_t command_offset = 0x4;
+  uint32_t address_offset = 0x8;
+  uint32_t data_offset = 0xc;
+
+  register_write_control_mytable((addr_t)(BaseAddr+address_offset), Idx);
+  register_write_control_mytable((addr_t)(BaseAddr+command_offset), stats_op);
+  return register_read_control_mytable((addr_t)(BaseAddr+data_offset));
+}
+
@@ -0,0 +1,111 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+/////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Hardware barrier network
+// File        : Barrier.sv
+// Notes       :
+//  - Sense-reversing barrier. Every tile toggles its arrive bit
+//    of group g when it executes mBarrier(g) and waits until the
+//    broadcast sense of g equals its arrive bit.
+//  - AND-reduce tree: one registered stage per row, one for the
+//    whole array. Both polarities are reduced so the pipeline
+//    never releases the same barrier twice.
+//  - Tiles that are not members of a group (mask configured by
+//    the host) are ignored by the reduction.
+////////////////////////////////////////////////////////////////
+
+`timescale 1 ps / 1 ps
+
+module Barrier#(
+   parameter ROW    = 2,
+   parameter COL    = 2,
+   parameter GROUPS = 4
+)(
+   input  logic                      clk_control,
+   input  logic                      clk_control_rst_low,
+   input  logic [ROW*COL*GROUPS-1:0] barrier_member,  //- {tile[t].group[g]}
+   input  logic [ROW*COL*GROUPS-1:0] barrier_arrive,  //- {tile[t].group[g]}
+   output logic         [GROUPS-1:0] barrier_sense    //- Broadcast to all tiles
+);
+
+logic [GROUPS-1:0] row_all1 [0:ROW-1]; //- All members in the row arrived with 1
+logic [GROUPS-1:0] row_all0 [0:ROW-1]; //- All members in the row arrived with 0
+logic [GROUPS-1:0] row_any  [0:ROW-1]; //- The row has members
+
+logic [GROUPS-1:0] all1;
+logic [GROUPS-1:0] all0;
+logic [GROUPS-1:0] any;
+logic [GROUPS-1:0] done;
+
+genvar i,j,g;
+
+generate
+  for (i=0; i<ROW; i=i+1) begin : barrier_row
+    for (g=0; g<GROUPS; g=g+1) begin : barrier_group
+      logic [COL-1:0] member;
+      logic [COL-1:0] arrive;
+      for (j=0; j<COL; j=j+1) begin : barrier_col
+        assign member[j] = barrier_member[(i*COL+j)*GROUPS+g];
+        assign arrive[j] = barrier_arrive[(i*COL+j)*GROUPS+g];
+      end
+      //- Stage 1: row reduction
+      always @(posedge clk_control or negedge clk_control_rst_low) begin
+        if (~clk_control_rst_low) begin
+          row_all1[i][g] <= 1'b0;
+          row_all0[i][g] <= 1'b0;
+          row_any[i][g]  <= 1'b0;
+        end else begin
+          row_all1[i][g] <= &( arrive | ~member);
+          row_all0[i][g] <= &(~arrive | ~member);
+          row_any[i][g]  <= |member;
+        end
+      end
+    end
+  end
+endgenerate
+
+//- Stage 2: array reduction
+always @( * ) begin
+   all1 = {GROUPS{1'b1}};
+   all0 = {GROUPS{1'b1}};
+   any  = {GROUPS{1'b0}};
+   for (int r=0; r<ROW; r=r+1) begin
+      all1 = all1 & row_all1[r];
+      all0 = all0 & row_all0[r];
+      any  = any  | row_any[r];
+   end
+end
+
+//- The barrier completes when every member toggled away from the current sense
+assign done = any & ((~barrier_sense & all1) | (barrier_sense & all0));
+
+always @(posedge clk_control or negedge clk_control_rst_low) begin
+   if (~clk_control_rst_low)
+      barrier_sense <= 'h0;
+   else
+      barrier_sense <= barrier_sense ^ done;
+end
+
+endmodule
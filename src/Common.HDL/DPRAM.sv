@@ -34,12 +34,15 @@
 //    https://docs.amd.com/r/en-US/ug974-vivado-ultrascale-libraries/XPM_MEMORY_SDPRAM
 //  - For ASIC synthesis replace this with an SRAM Macro.
 //    and set the `ASIC_SYNTH define
+//  - MEMORY_PRIMITIVE is passed to Vivado as the ram_style of the
+//    array: "auto", "block" or "ultra" (URAM, both ports on one clock).
 //////////////////////////////////////////////////////////////////////////////////////////
 
 module DPRAM #(
   parameter ADDR_W = 32,
   parameter DATA_W = 32,
-  parameter MEMSIZE_KB = 128
+  parameter MEMSIZE_KB = 128,
+  parameter MEMORY_PRIMITIVE = "auto"
 ) (
   input  wire  [1:0]          clk,
   input  wire  [1:0]          rst_n,
@@ -64,11 +67,13 @@ reg  [DATA_W-1:0]  doutb_i1, doutb_i2;
    //- TBD: Add SRAM macro
 `else
 
-reg  [DATA_W-1:0]  mem [(MAX_ADDRESS)-1:0];
+(* ram_style = MEMORY_PRIMITIVE *) reg  [DATA_W-1:0]  mem [(MAX_ADDRESS)-1:0];
 
-//- Only for simulation
+//- Only for simulation (URAM can not be initialized)
+`ifndef SYNTHESIS
 integer            i;
 initial for (i=0; i< (MAX_ADDRESS); i=i+1) mem[i] = 0;
+`endif
 
 assign clka   = clk[0];
 assign ena    = en[0];
@@ -0,0 +1,282 @@
+// *************************************************************************
+// 
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues 
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California, 
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+// 
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative 
+// works, and perform publicly and display publicly, and to permit others 
+// to do so.
+//
+// *************************************************************************
+
+/////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Fast behavioral AXI4 memory for simulation
+// File        : tb_axi_mem.sv
+// Notes       :
+//  - Replaces the DDR4 model when only the timing seen by
+//    the memory manager matters. INCR bursts of full beats,
+//    byte strobes on writes.
+//  - Sparse: only the beats written are stored (associative
+//    array). Icarus has no associative arrays, it uses a
+//    plain array of 2^MEM_LOG2 beats and wraps the address.
+//    Beats never written read 0.
+//  - Every burst takes LAT_MIN to LAT_MAX cycles (uniform,
+//    fixed when equal) from its address (reads) or last
+//    data beat (writes) to its response. Bursts respond in
+//    the order they are ready, any id.
+//  - Up to OUTSTANDING reads and OUTSTANDING writes in
+//    flight. Read and write beats share BW_PCT percent of
+//    one beat per cycle.
+////////////////////////////////////////////////////////////////
+
+module tb_axi_mem#(
+   parameter S_AXI_ID_SZ  = 11,
+   parameter S_AXI_ADR_SZ = 34, // ADDRESS
+   parameter S_AXI_LEN_SZ = 8,  // LENGTH
+   parameter S_AXI_DAT_SZ = 512,// DATA
+   parameter S_AXI_STB_SZ = 64, // STROBE
+   parameter S_AXI_RSP_SZ = 2,  // RESPONSE
+   parameter LAT_MIN      = 40, // Cycles
+   parameter LAT_MAX      = 40,
+   parameter BW_PCT       = 100,
+   parameter OUTSTANDING  = 16,
+   parameter MEM_LOG2     = 16  // Beats, Icarus only
+)(
+   input  logic                    clk,
+   input  logic                    rst,
+   //- ADDRESS WRITE
+   output logic                    s_axi_awready,
+   input  logic                    s_axi_awvalid,
+   input  logic [S_AXI_ID_SZ-1:0]  s_axi_awid,
+   input  logic [S_AXI_ADR_SZ-1:0] s_axi_awaddr,
+   input  logic [S_AXI_LEN_SZ-1:0] s_axi_awlen,
+   //- DATA WRITE
+   output logic                    s_axi_wready,
+   input  logic                    s_axi_wvalid,
+   input  logic                    s_axi_wlast,
+   input  logic [S_AXI_DAT_SZ-1:0] s_axi_wdata,
+   input  logic [S_AXI_STB_SZ-1:0] s_axi_wstrb,
+   //- VALID WRITE
+   input  logic                    s_axi_bready,
+   output logic                    s_axi_bvalid,
+   output logic [S_AXI_ID_SZ-1:0]  s_axi_bid,
+   output logic [S_AXI_RSP_SZ-1:0] s_axi_bresp,
+   //- ADDRESS READ
+   output logic                    s_axi_arready,
+   input  logic                    s_axi_arvalid,
+   input  logic [S_AXI_ID_SZ-1:0]  s_axi_arid,
+   input  logic [S_AXI_ADR_SZ-1:0] s_axi_araddr,
+   input  logic [S_AXI_LEN_SZ-1:0] s_axi_arlen,
+   //- RESPONSE READ
+   input  logic                    s_axi_rready,
+   output logic                    s_axi_rvalid,
+   output logic                    s_axi_rlast,
+   output logic [S_AXI_DAT_SZ-1:0] s_axi_rdata,
+   output logic [S_AXI_ID_SZ-1:0]  s_axi_rid,
+   output logic [S_AXI_RSP_SZ-1:0] s_axi_rresp
+);
+
+localparam BEAT_W = $clog2(S_AXI_DAT_SZ/8);
+
+//- Slot states
+localparam [1:0] FREE = 2'd0;
+localparam [1:0] DATA = 2'd1; //- Write waiting for its data
+localparam [1:0] WAIT = 2'd2; //- Waiting for its latency
+localparam [1:0] RESP = 2'd3; //- Read being returned
+
+//- Storage
+`ifdef __ICARUS__
+logic [S_AXI_DAT_SZ-1:0] mem [0:2**MEM_LOG2-1];
+
+initial begin
+   for (int i=0; i<2**MEM_LOG2; i=i+1) mem[i] = 'h0;
+end
+`else
+logic [S_AXI_DAT_SZ-1:0] mem [longint unsigned];
+`endif
+
+//- Reads and writes in flight
+logic              [1:0] rd_st   [0:OUTSTANDING-1];
+logic             [63:0] rd_beat [0:OUTSTANDING-1];
+logic [S_AXI_LEN_SZ-1:0] rd_left [0:OUTSTANDING-1];
+logic  [S_AXI_ID_SZ-1:0] rd_id   [0:OUTSTANDING-1];
+integer                  rd_time [0:OUTSTANDING-1];
+integer                  rd_seq  [0:OUTSTANDING-1];
+logic              [1:0] wr_st   [0:OUTSTANDING-1];
+logic             [63:0] wr_beat [0:OUTSTANDING-1];
+logic  [S_AXI_ID_SZ-1:0] wr_id   [0:OUTSTANDING-1];
+integer                  wr_time [0:OUTSTANDING-1];
+integer                  wr_seq  [0:OUTSTANDING-1];
+
+integer now;
+integer seq;
+integer credit;  //- Percent of a beat
+integer rd_cnt;
+integer wr_cnt;
+integer rd_cur;  //- Read on the R channel, -1 if none
+integer wr_cur;  //- Write taking data, -1 if none
+integer b_cur;   //- Write on the B channel, -1 if none
+
+function automatic integer latency();
+   latency = LAT_MIN + ((LAT_MAX > LAT_MIN) ? {$random} % (LAT_MAX-LAT_MIN+1) : 0);
+endfunction
+
+function automatic [S_AXI_DAT_SZ-1:0] mem_rd(input [63:0] beat);
+`ifdef __ICARUS__
+   mem_rd = mem[beat[MEM_LOG2-1:0]];
+`else
+   mem_rd = mem.exists(beat) ? mem[beat] : 'h0;
+`endif
+endfunction
+
+task automatic mem_wr(input [63:0] beat, input [S_AXI_DAT_SZ-1:0] data, input [S_AXI_STB_SZ-1:0] strb);
+   logic [S_AXI_DAT_SZ-1:0] line;
+   line = mem_rd(beat);
+   for (int i=0; i<S_AXI_STB_SZ; i=i+1)
+      if (strb[i]) line[i*8 +: 8] = data[i*8 +: 8];
+`ifdef __ICARUS__
+   mem[beat[MEM_LOG2-1:0]] = line;
+`else
+   mem[beat] = line;
+`endif
+endtask
+
+always @(posedge clk) begin
+   integer pick;
+   integer c;
+
+   if (rst) begin
+      now    = 0;
+      seq    = 0;
+      credit = 100;
+      rd_cnt = 0;
+      wr_cnt = 0;
+      rd_cur = -1;
+      wr_cur = -1;
+      b_cur  = -1;
+      for (int i=0; i<OUTSTANDING; i=i+1) begin
+         rd_st[i] = FREE;
+         wr_st[i] = FREE;
+      end
+      s_axi_rvalid <= 1'b0;
+      s_axi_rlast  <= 1'b0;
+      s_axi_rdata  <= 'h0;
+      s_axi_rid    <= 'h0;
+      s_axi_rresp  <= 'h0;
+      s_axi_bvalid <= 1'b0;
+      s_axi_bid    <= 'h0;
+      s_axi_bresp  <= 'h0;
+      s_axi_arready <= 1'b0;
+      s_axi_awready <= 1'b0;
+      s_axi_wready  <= 1'b0;
+   end else begin
+      now = now + 1;
+      c   = credit;
+
+      //- Addresses
+      if (s_axi_arvalid & s_axi_arready) begin
+         pick = 0;
+         while (rd_st[pick] != FREE) pick = pick + 1;
+         rd_st[pick]   = WAIT;
+         rd_beat[pick] = s_axi_araddr >> BEAT_W;
+         rd_left[pick] = s_axi_arlen;
+         rd_id[pick]   = s_axi_arid;
+         rd_time[pick] = now + latency();
+         rd_seq[pick]  = seq;
+         seq    = seq + 1;
+         rd_cnt = rd_cnt + 1;
+      end
+      if (s_axi_awvalid & s_axi_awready) begin
+         pick = 0;
+         while (wr_st[pick] != FREE) pick = pick + 1;
+         wr_st[pick]   = DATA;
+         wr_beat[pick] = s_axi_awaddr >> BEAT_W;
+         wr_id[pick]   = s_axi_awid;
+         wr_seq[pick]  = seq;
+         seq    = seq + 1;
+         wr_cnt = wr_cnt + 1;
+      end
+
+      //- Write data, in address order
+      if (s_axi_wvalid & s_axi_wready) begin
+         mem_wr(wr_beat[wr_cur], s_axi_wdata, s_axi_wstrb);
+         wr_beat[wr_cur] = wr_beat[wr_cur] + 1;
+         c = c - 100;
+         if (s_axi_wlast) begin
+            wr_st[wr_cur]   = WAIT;
+            wr_time[wr_cur] = now + latency();
+            wr_cur = -1;
+         end
+      end
+      if (wr_cur < 0) begin
+         for (int i=0; i<OUTSTANDING; i=i+1)
+            if (wr_st[i] == DATA & (wr_cur < 0 || wr_seq[i] < wr_seq[wr_cur])) wr_cur = i;
+      end
+
+      //- Write responses
+      if (s_axi_bvalid & s_axi_bready) begin
+         wr_st[b_cur] = FREE;
+         wr_cnt = wr_cnt - 1;
+         b_cur  = -1;
+      end
+      if (b_cur < 0) begin
+         for (int i=0; i<OUTSTANDING; i=i+1)
+            if (wr_st[i] == WAIT & wr_time[i] <= now & (b_cur < 0 || wr_seq[i] < wr_seq[b_cur])) b_cur = i;
+      end
+      s_axi_bvalid <= b_cur >= 0;
+      s_axi_bid    <= b_cur >= 0 ? wr_id[b_cur] : 'h0;
+      s_axi_bresp  <= 'h0;
+
+      //- Read data, one burst at a time
+      if (s_axi_rvalid & s_axi_rready) begin
+         if (s_axi_rlast) begin
+            rd_st[rd_cur] = FREE;
+            rd_cnt = rd_cnt - 1;
+            rd_cur = -1;
+         end else begin
+            rd_beat[rd_cur] = rd_beat[rd_cur] + 1;
+            rd_left[rd_cur] = rd_left[rd_cur] - 1;
+         end
+      end
+      if (rd_cur < 0) begin
+         for (int i=0; i<OUTSTANDING; i=i+1)
+            if (rd_st[i] == WAIT & rd_time[i] <= now & (rd_cur < 0 || rd_seq[i] < rd_seq[rd_cur])) rd_cur = i;
+         if (rd_cur >= 0) rd_st[rd_cur] = RESP;
+      end
+      if (~s_axi_rvalid | s_axi_rready) begin
+         if (rd_cur >= 0 & c >= 100) begin
+            c = c - 100;
+            s_axi_rvalid <= 1'b1;
+            s_axi_rdata  <= mem_rd(rd_beat[rd_cur]);
+            s_axi_rid    <= rd_id[rd_cur];
+            s_axi_rlast  <= rd_left[rd_cur] == 0;
+            s_axi_rresp  <= 'h0;
+         end else begin
+            s_axi_rvalid <= 1'b0;
+            s_axi_rlast  <= 1'b0;
+         end
+      end
+
+      credit = (c + BW_PCT > 100) ? 100 : c + BW_PCT;
+
+      //- Ready for the next cycle
+      s_axi_arready <= rd_cnt < OUTSTANDING;
+      s_axi_awready <= wr_cnt < OUTSTANDING;
+      s_axi_wready  <= wr_cur >= 0 & credit >= 100;
+   end
+end
+
+endmodule
@@ -459,6 +459,67 @@ for (rnk = 0; rnk < IDX; rnk++) begin:rankup
 end
 endgenerate
 
+`elsif DDR_FAST_MODEL
+   // Fast behavioral memory, see tb_axi_mem.sv
+   always begin 
+      #(333 / 2) clk_memory =  0; 
+      #(333 / 2) clk_memory =  1; 
+   end
+
+   initial begin 
+      clk_memory_rst = 1; 
+      #1000000 clk_memory_rst = 0; 
+   end
+
+   initial begin
+      c0_init_calib_complete = 1;
+   end
+
+   tb_axi_mem#(
+      .S_AXI_ID_SZ  (S_AXI_ID_SZ),
+      .S_AXI_ADR_SZ (S_AXI_ADR_SZ),
+      .S_AXI_LEN_SZ (S_AXI_LEN_SZ),
+      .S_AXI_DAT_SZ (S_AXI_DAT_SZ),
+      .S_AXI_STB_SZ (S_AXI_STB_SZ),
+      .S_AXI_RSP_SZ (S_AXI_RSP_SZ),
+      .LAT_MIN      (`DDR_LAT_MIN),
+      .LAT_MAX      (`DDR_LAT_MAX),
+      .BW_PCT       (`DDR_BW_PCT),
+      .OUTSTANDING  (`DDR_OUTSTANDING)
+   ) tb_axi_mem (
+      .clk           (clk_memory),
+      .rst           (clk_memory_rst),
+      //- ADDRESS WRITE
+      .s_axi_awready (s_axi_awready),
+      .s_axi_awvalid (s_axi_awvalid),
+      .s_axi_awid    (s_axi_awid),
+      .s_axi_awaddr  (s_axi_awaddr),
+      .s_axi_awlen   (s_axi_awlen),
+      //- DATA WRITE
+      .s_axi_wready  (s_axi_wready),
+      .s_axi_wvalid  (s_axi_wvalid),
+      .s_axi_wlast   (s_axi_wlast),
+      .s_axi_wdata   (s_axi_wdata),
+      .s_axi_wstrb   (s_axi_wstrb),
+      //- VALID WRITE
+      .s_axi_bready  (s_axi_bready),
+      .s_axi_bvalid  (s_axi_bvalid),
+      .s_axi_bid     (s_axi_bid),
+      .s_axi_bresp   (s_axi_bresp),
+      //- ADDRESS READ
+      .s_axi_arready (s_axi_arready),
+      .s_axi_arvalid (s_axi_arvalid),
+      .s_axi_arid    (s_axi_arid),
+      .s_axi_araddr  (s_axi_araddr),
+      .s_axi_arlen   (s_axi_arlen),
+      //- RESPONSE READ
+      .s_axi_rready  (s_axi_rready),
+      .s_axi_rvalid  (s_axi_rvalid),
+      .s_axi_rlast   (s_axi_rlast),
+      .s_axi_rdata   (s_axi_rdata),
+      .s_axi_rid     (s_axi_rid),
+      .s_axi_rresp   (s_axi_rresp));
+
 `else  
    // else VIVADO_IP_DRAM
    // If not using the memory model from Vivado 
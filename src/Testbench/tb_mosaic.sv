@@ -132,102 +132,117 @@ logic c0_init_calib_complete;
   parameter S_AXI_CAC_SZ = 4;  // RESPONSE
   parameter S_AXI_PRT_SZ = 3;  // RESPONSE
   parameter S_AXI_QOS_SZ = 4;   // RESPONSE
+  parameter DRAM_TILES   = `DRAM_TILES; //- One memory controller each
 
   //- ADDRESS WRITE
-  logic                    s_axi_awready;
-  logic                    s_axi_awvalid;
-  logic [S_AXI_ID_SZ-1:0]  s_axi_awid;
-  logic [S_AXI_ADR_SZ-1:0] s_axi_awaddr;
-  logic [S_AXI_LEN_SZ-1:0] s_axi_awlen;
-  logic [S_AXI_SZE_SZ-1:0] s_axi_awsize;
-  logic [S_AXI_BRT_SZ-1:0] s_axi_awburst;
-  logic                    s_axi_awlock;
-  logic [S_AXI_CAC_SZ-1:0] s_axi_awcache;
-  logic [S_AXI_PRT_SZ-1:0] s_axi_awprot;
-  logic [S_AXI_QOS_SZ-1:0] s_axi_awqos;
+  logic              [DRAM_TILES-1:0] s_axi_awready;
+  logic              [DRAM_TILES-1:0] s_axi_awvalid;
+  logic  [DRAM_TILES*S_AXI_ID_SZ-1:0] s_axi_awid;
+  logic [DRAM_TILES*S_AXI_ADR_SZ-1:0] s_axi_awaddr;
+  logic [DRAM_TILES*S_AXI_LEN_SZ-1:0] s_axi_awlen;
+  logic [DRAM_TILES*S_AXI_SZE_SZ-1:0] s_axi_awsize;
+  logic [DRAM_TILES*S_AXI_BRT_SZ-1:0] s_axi_awburst;
+  logic              [DRAM_TILES-1:0] s_axi_awlock;
+  logic [DRAM_TILES*S_AXI_CAC_SZ-1:0] s_axi_awcache;
+  logic [DRAM_TILES*S_AXI_PRT_SZ-1:0] s_axi_awprot;
+  logic [DRAM_TILES*S_AXI_QOS_SZ-1:0] s_axi_awqos;
   //- DATA WRITE
-  logic                    s_axi_wready;
-  logic                    s_axi_wvalid;
-  logic                    s_axi_wlast;
-  logic [S_AXI_DAT_SZ-1:0] s_axi_wdata;
-  logic [S_AXI_STB_SZ-1:0] s_axi_wstrb;
+  logic              [DRAM_TILES-1:0] s_axi_wready;
+  logic              [DRAM_TILES-1:0] s_axi_wvalid;
+  logic              [DRAM_TILES-1:0] s_axi_wlast;
+  logic [DRAM_TILES*S_AXI_DAT_SZ-1:0] s_axi_wdata;
+  logic [DRAM_TILES*S_AXI_STB_SZ-1:0] s_axi_wstrb;
   //- VALID WRITE
-  logic                    s_axi_bready;
-  logic                    s_axi_bvalid;
-  logic [S_AXI_ID_SZ-1:0]  s_axi_bid;
-  logic [S_AXI_RSP_SZ-1:0] s_axi_bresp;
+  logic              [DRAM_TILES-1:0] s_axi_bready;
+  logic              [DRAM_TILES-1:0] s_axi_bvalid;
+  logic  [DRAM_TILES*S_AXI_ID_SZ-1:0] s_axi_bid;
+  logic [DRAM_TILES*S_AXI_RSP_SZ-1:0] s_axi_bresp;
   //- ADDRESS READ
-  logic                    s_axi_arready;
-  logic                    s_axi_arvalid;
-  logic [S_AXI_ID_SZ-1:0]  s_axi_arid;
-  logic [S_AXI_ADR_SZ-1:0] s_axi_araddr;
-  logic [S_AXI_LEN_SZ-1:0] s_axi_arlen;
-  logic [S_AXI_SZE_SZ-1:0] s_axi_arsize;
-  logic [S_AXI_BRT_SZ-1:0] s_axi_arburst;
-  logic                    s_axi_arlock;
-  logic [S_AXI_CAC_SZ-1:0] s_axi_arcache;
-  logic [S_AXI_PRT_SZ-1:0] s_axi_arprot;
-  logic [S_AXI_QOS_SZ-1:0] s_axi_arqos;
+  logic              [DRAM_TILES-1:0] s_axi_arready;
+  logic              [DRAM_TILES-1:0] s_axi_arvalid;
+  logic  [DRAM_TILES*S_AXI_ID_SZ-1:0] s_axi_arid;
+  logic [DRAM_TILES*S_AXI_ADR_SZ-1:0] s_axi_araddr;
+  logic [DRAM_TILES*S_AXI_LEN_SZ-1:0] s_axi_arlen;
+  logic [DRAM_TILES*S_AXI_SZE_SZ-1:0] s_axi_arsize;
+  logic [DRAM_TILES*S_AXI_BRT_SZ-1:0] s_axi_arburst;
+  logic              [DRAM_TILES-1:0] s_axi_arlock;
+  logic [DRAM_TILES*S_AXI_CAC_SZ-1:0] s_axi_arcache;
+  logic [DRAM_TILES*S_AXI_PRT_SZ-1:0] s_axi_arprot;
+  logic [DRAM_TILES*S_AXI_QOS_SZ-1:0] s_axi_arqos;
   //- RESPONSE READ
-  logic                    s_axi_rready;
-  logic                    s_axi_rvalid;
-  logic                    s_axi_rlast;
-  logic [S_AXI_DAT_SZ-1:0] s_axi_rdata;
-  logic [S_AXI_ID_SZ-1:0]  s_axi_rid;
-  logic [S_AXI_RSP_SZ-1:0] s_axi_rresp;
+  logic              [DRAM_TILES-1:0] s_axi_rready;
+  logic              [DRAM_TILES-1:0] s_axi_rvalid;
+  logic              [DRAM_TILES-1:0] s_axi_rlast;
+  logic [DRAM_TILES*S_AXI_DAT_SZ-1:0] s_axi_rdata;
+  logic  [DRAM_TILES*S_AXI_ID_SZ-1:0] s_axi_rid;
+  logic [DRAM_TILES*S_AXI_RSP_SZ-1:0] s_axi_rresp;
 
   logic clk_memory;
   logic clk_memory_rst;
 
 
-  tb_memory_controller tb_memory_controller(
-    //- ADDRESS WRITE
-    .s_axi_awready      (s_axi_awready),
-    .s_axi_awvalid      (s_axi_awvalid),
-    .s_axi_awid         (s_axi_awid),
-    .s_axi_awaddr       (s_axi_awaddr),
-    .s_axi_awlen        (s_axi_awlen),
-    .s_axi_awsize       (s_axi_awsize),
-    .s_axi_awburst      (s_axi_awburst),
-    .s_axi_awlock       (s_axi_awlock),
-    .s_axi_awcache      (s_axi_awcache),
-    .s_axi_awprot       (s_axi_awprot),
-    .s_axi_awqos        (s_axi_awqos),
-    //- DATA WRITE
-    .s_axi_wready      (s_axi_wready),
-    .s_axi_wvalid      (s_axi_wvalid),
-    .s_axi_wlast       (s_axi_wlast),
-    .s_axi_wdata       (s_axi_wdata),
-    .s_axi_wstrb       (s_axi_wstrb),
-    //- VALID WRITE
-    .s_axi_bready      (s_axi_bready),
-    .s_axi_bvalid      (s_axi_bvalid),
-    .s_axi_bid         (s_axi_bid),
-    .s_axi_bresp       (s_axi_bresp),
-    //- ADDRESS READ
-    .s_axi_arready     (s_axi_arready),
-    .s_axi_arvalid     (s_axi_arvalid),
-    .s_axi_arid        (s_axi_arid),
-    .s_axi_araddr      (s_axi_araddr),
-    .s_axi_arlen       (s_axi_arlen),
-    .s_axi_arsize      (s_axi_arsize),
-    .s_axi_arburst     (s_axi_arburst),
-    .s_axi_arlock      (s_axi_arlock),
-    .s_axi_arcache     (s_axi_arcache),
-    .s_axi_arprot      (s_axi_arprot),
-    .s_axi_arqos       (s_axi_arqos),
-    //- RESPONSE READ
-    .s_axi_rready      (s_axi_rready),
-    .s_axi_rvalid      (s_axi_rvalid),
-    .s_axi_rlast       (s_axi_rlast),
-    .s_axi_rdata       (s_axi_rdata),
-    .s_axi_rid         (s_axi_rid),
-    .s_axi_rresp       (s_axi_rresp),
-    .c0_init_calib_complete (c0_init_calib_complete),
-    //- Clock & Reset
-    .clk_memory_rst    (clk_memory_rst),
-    .clk_memory        (clk_memory)
-  );
+  //- One controller per DRAM tile, the first one gives the clock
+  logic [DRAM_TILES-1:0] calib_complete;
+  logic [DRAM_TILES-1:0] clk_memory_k;
+  logic [DRAM_TILES-1:0] clk_memory_rst_k;
+
+  assign c0_init_calib_complete = &calib_complete;
+  assign clk_memory             = clk_memory_k[0];
+  assign clk_memory_rst         = clk_memory_rst_k[0];
+
+  genvar k;
+  generate
+  for (k = 0; k < DRAM_TILES; k = k + 1) begin: g_mem_ctrl
+    tb_memory_controller tb_memory_controller(
+      //- ADDRESS WRITE
+      .s_axi_awready      (s_axi_awready[k]),
+      .s_axi_awvalid      (s_axi_awvalid[k]),
+      .s_axi_awid         (s_axi_awid[k*S_AXI_ID_SZ +: S_AXI_ID_SZ]),
+      .s_axi_awaddr       (s_axi_awaddr[k*S_AXI_ADR_SZ +: S_AXI_ADR_SZ]),
+      .s_axi_awlen        (s_axi_awlen[k*S_AXI_LEN_SZ +: S_AXI_LEN_SZ]),
+      .s_axi_awsize       (s_axi_awsize[k*S_AXI_SZE_SZ +: S_AXI_SZE_SZ]),
+      .s_axi_awburst      (s_axi_awburst[k*S_AXI_BRT_SZ +: S_AXI_BRT_SZ]),
+      .s_axi_awlock       (s_axi_awlock[k]),
+      .s_axi_awcache      (s_axi_awcache[k*S_AXI_CAC_SZ +: S_AXI_CAC_SZ]),
+      .s_axi_awprot       (s_axi_awprot[k*S_AXI_PRT_SZ +: S_AXI_PRT_SZ]),
+      .s_axi_awqos        (s_axi_awqos[k*S_AXI_QOS_SZ +: S_AXI_QOS_SZ]),
+      //- DATA WRITE
+      .s_axi_wready      (s_axi_wready[k]),
+      .s_axi_wvalid      (s_axi_wvalid[k]),
+      .s_axi_wlast       (s_axi_wlast[k]),
+      .s_axi_wdata       (s_axi_wdata[k*S_AXI_DAT_SZ +: S_AXI_DAT_SZ]),
+      .s_axi_wstrb       (s_axi_wstrb[k*S_AXI_STB_SZ +: S_AXI_STB_SZ]),
+      //- VALID WRITE
+      .s_axi_bready      (s_axi_bready[k]),
+      .s_axi_bvalid      (s_axi_bvalid[k]),
+      .s_axi_bid         (s_axi_bid[k*S_AXI_ID_SZ +: S_AXI_ID_SZ]),
+      .s_axi_bresp       (s_axi_bresp[k*S_AXI_RSP_SZ +: S_AXI_RSP_SZ]),
+      //- ADDRESS READ
+      .s_axi_arready     (s_axi_arready[k]),
+      .s_axi_arvalid     (s_axi_arvalid[k]),
+      .s_axi_arid        (s_axi_arid[k*S_AXI_ID_SZ +: S_AXI_ID_SZ]),
+      .s_axi_araddr      (s_axi_araddr[k*S_AXI_ADR_SZ +: S_AXI_ADR_SZ]),
+      .s_axi_arlen       (s_axi_arlen[k*S_AXI_LEN_SZ +: S_AXI_LEN_SZ]),
+      .s_axi_arsize      (s_axi_arsize[k*S_AXI_SZE_SZ +: S_AXI_SZE_SZ]),
+      .s_axi_arburst     (s_axi_arburst[k*S_AXI_BRT_SZ +: S_AXI_BRT_SZ]),
+      .s_axi_arlock      (s_axi_arlock[k]),
+      .s_axi_arcache     (s_axi_arcache[k*S_AXI_CAC_SZ +: S_AXI_CAC_SZ]),
+      .s_axi_arprot      (s_axi_arprot[k*S_AXI_PRT_SZ +: S_AXI_PRT_SZ]),
+      .s_axi_arqos       (s_axi_arqos[k*S_AXI_QOS_SZ +: S_AXI_QOS_SZ]),
+      //- RESPONSE READ
+      .s_axi_rready      (s_axi_rready[k]),
+      .s_axi_rvalid      (s_axi_rvalid[k]),
+      .s_axi_rlast       (s_axi_rlast[k]),
+      .s_axi_rdata       (s_axi_rdata[k*S_AXI_DAT_SZ +: S_AXI_DAT_SZ]),
+      .s_axi_rid         (s_axi_rid[k*S_AXI_ID_SZ +: S_AXI_ID_SZ]),
+      .s_axi_rresp       (s_axi_rresp[k*S_AXI_RSP_SZ +: S_AXI_RSP_SZ]),
+      .c0_init_calib_complete (calib_complete[k]),
+      //- Clock & Reset
+      .clk_memory_rst    (clk_memory_rst_k[k]),
+      .clk_memory        (clk_memory_k[k])
+    );
+  end
+  endgenerate
 `else
 initial 
   c0_init_calib_complete = 1;
@@ -413,6 +428,10 @@ initial begin
 
     sim_done = 1;
 
+    `ifdef DDR4_CTRL
+    if (`DDR_STATS) dump_dram_stats();
+    `endif
+
     #500000 $display("Killing simulation %g", $time);
     
     wait(check_done);
@@ -627,10 +646,12 @@ task coordinates_init;
    end
 
    `ifdef DDR4_CTRL
-      addr = coord_addr_a[TILES];
-      data = coord_data_a[TILES];
+   for (i=TILES; i<AXI_TILES; i=i+1) begin
+      addr = coord_addr_a[i];
+      data = coord_data_a[i];
       $display("[%m AXI] READ from tile reg addr %d: = VALUE(hex) = %x",addr,data);
       SV_write_control_mytable(addr, data);
+   end
    `endif
 
 endtask
@@ -643,12 +664,13 @@ task set_pico;
    integer addr;
    integer data;
 
-   integer coord_addr_a [0:TILES];
+   integer coord_addr_a [0:AXI_TILES-1];
 
    $readmemh(`COORD1_ADR, coord_addr_a);
 
    `ifdef DDR4_CTRL
-      initialize_tile_AXI(coord_addr_a[TILES]);
+   for (i=TILES; i<AXI_TILES; i=i+1)
+      initialize_tile_AXI(coord_addr_a[i]);
    `endif
 
    for (i=0; i<TILES; i=i+1) begin
@@ -785,5 +807,79 @@ task read_memory_AXI;
    check_done = 1;
 endtask
 
+////////////////////////////////////////////
+//- Task 12) read_stat_AXI
+////////////////////////////////////////////
+task read_stat_AXI(input integer mask, input integer sel, output integer data);
+   integer addr;
+
+   //- Address first: the counters cross to clk_memory
+   addr = 32'h00000008 | mask;
+   SV_write_control_mytable(addr, sel);
+
+   addr = 32'h00000004 | mask;
+   SV_write_control_mytable(addr, 32'h00000005); //OP_STATS
+
+   addr = 32'h0000000C | mask;
+   SV_read_control_mytable(addr, data);
+endtask
+
+////////////////////////////////////////////
+//- Task 13) dump_dram_stats
+////////////////////////////////////////////
+task dump_dram_stats;
+   integer coord_addr_a [0:AXI_TILES-1];
+   integer t;
+   integer s;
+   integer data;
+   reg [8*24-1:0] name;
+
+   $readmemh(`COORD1_ADR, coord_addr_a);
+
+   for (t=TILES; t<AXI_TILES; t=t+1) begin
+      for (s=0; s<17; s=s+1) begin
+         case (s)
+            0:  name = "cycles";
+            1:  name = "MPUT packets";
+            2:  name = "MGET packets";
+            3:  name = "MLOAD packets";
+            4:  name = "MSTORE packets";
+            5:  name = "non-temporal packets";
+            6:  name = "host words";
+            7:  name = "cache words";
+            8:  name = "cache wait cycles";
+            9:  name = "hits";
+            10: name = "misses";
+            11: name = "secondary misses";
+            12: name = "write-backs";
+            13: name = "AXI reads";
+            14: name = "AXI writes";
+            15: name = "AXI read beats";
+            default: name = "AXI write beats";
+         endcase
+         read_stat_AXI(coord_addr_a[t], s, data);
+         $display("DRAM STATS tile %0d: %0s = %0d", t-TILES, name, data);
+      end
+      if (`DDR_PF_STREAMS > 0) begin
+         for (s=0; s<5; s=s+1) begin
+            read_stat_AXI(coord_addr_a[t], 8'h40+s, data);
+            $display("DRAM STATS tile %0d: prefetch counter %0d = %0d", t-TILES, s, data);
+         end
+      end
+      for (s=0; s<48; s=s+1) begin
+         read_stat_AXI(coord_addr_a[t], 8'h80+s, data);
+         if (data != 0)
+            $display("DRAM STATS tile %0d: %s latency %0d-%0d cycles = %0d", t-TILES,
+                     s < 16 ? "MGET" : s < 32 ? "MLOAD" : "MSTORE",
+                     s%16 == 0 ? 0 : 1 << (s%16), (2 << (s%16)) - 1, data);
+      end
+      for (s=0; s<64; s=s+1) begin
+         read_stat_AXI(coord_addr_a[t], 8'hC0+s, data);
+         if (data != 0)
+            $display("DRAM STATS tile %0d: packets from x%0d y%0d = %0d", t-TILES, s%8, s/8, data);
+      end
+   end
+endtask
+
 endmodule
 
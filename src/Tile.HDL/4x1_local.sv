@@ -32,6 +32,7 @@
 ////////////////////////////////////////////////
 
 `timescale 1 ps/ 1 ps
+`include "global_defines.sv"
 
 module grant_out#(
    parameter BW       = 32,
@@ -211,6 +212,7 @@ module in_dest#(
    parameter BIG = 0,
    parameter OFFSET = 0,
    parameter LEVEL  = 0,
+   parameter PORTS  = 4,  //- Columns of a DRAM tile
    //- 
    parameter XY_SZ = 3
 )(
@@ -241,6 +243,11 @@ localparam [2:0] RIGHT  = 2;
 localparam [2:0] BOTTOM = 1;
 localparam [2:0] NULL   = 0;
 
+`ifdef DDR4_CTRL
+localparam [XY_SZ-1:0] X_DRAM = `X_DRAM;
+localparam DRAM_COLS = `DRAM_COLS;
+`endif
+
 localparam BUFFER_DATA_SZ = BWB + BW + 1 + 3;
 
 logic [BUFFER_DATA_SZ-1:0] dout;
@@ -291,19 +298,40 @@ generate
                        
    end else if (BIG == 1) begin
       if (LEVEL==0) begin
-         assign tdest_t = stream_in_TDATA[XY_SZ-1:0] >= myX              ? LOCAL  :
-                          stream_in_TDATA[(2*XY_SZ)-1:XY_SZ] == 0+OFFSET ? BOTTOM :
-                          stream_in_TDATA[(2*XY_SZ)-1:XY_SZ] == 1+OFFSET ? RIGHT  :
-                          stream_in_TDATA[(2*XY_SZ)-1:XY_SZ] == 2+OFFSET ? TOP    : LEFT;
+         //- Columns OFFSET to OFFSET+PORTS-1 on ports 0 to PORTS-1. Other
+         //  columns leave through port 3, or the closest port of a DRAM
+         //  tile with less than 4 columns.
+         logic [XY_SZ-1:0] y_port;
+         assign y_port = stream_in_TDATA[(2*XY_SZ)-1:XY_SZ] < OFFSET        ? (PORTS == 4 ? 3 : 0) :
+                         stream_in_TDATA[(2*XY_SZ)-1:XY_SZ] >= OFFSET+PORTS ? PORTS-1 :
+                         stream_in_TDATA[(2*XY_SZ)-1:XY_SZ] - OFFSET;
+         assign tdest_t = stream_in_TDATA[XY_SZ-1:0] >= myX ? LOCAL  :
+                          y_port == 0                       ? BOTTOM :
+                          y_port == 1                       ? RIGHT  :
+                          y_port == 2                       ? TOP    : LEFT;
       end else begin
          assign tdest_t = stream_in_TDATA[XY_SZ-1:0] >= myX            ? LOCAL :
                           stream_in_TDATA[(2*XY_SZ)-1:XY_SZ] >= OFFSET ? RIGHT : BOTTOM;
       end      
    end else begin
+`ifdef DDR4_CTRL
+      //- To a DRAM tile (the row below the mesh): first to the columns
+      //  of the tile, then down. Only turns towards the bottom are added,
+      //  so XY routing stays deadlock free.
+      assign tdest_t = stream_in_TDATA[XY_SZ-1:0] == X_DRAM &
+                       stream_in_TDATA[(2*XY_SZ)-1:XY_SZ] > myY             ? RIGHT  :
+                       stream_in_TDATA[XY_SZ-1:0] == X_DRAM &
+                       myY >= stream_in_TDATA[(2*XY_SZ)-1:XY_SZ]+DRAM_COLS  ? LEFT   :
+                       stream_in_TDATA[XY_SZ-1:0] > myX         ? BOTTOM :
+                       stream_in_TDATA[XY_SZ-1:0] < myX         ? TOP    :
+                       stream_in_TDATA[(2*XY_SZ)-1:XY_SZ] > myY ? RIGHT  :
+                       stream_in_TDATA[(2*XY_SZ)-1:XY_SZ] < myY ? LEFT   : LOCAL;
+`else
       assign tdest_t = stream_in_TDATA[XY_SZ-1:0] > myX         ? BOTTOM :
                        stream_in_TDATA[XY_SZ-1:0] < myX         ? TOP    :
                        stream_in_TDATA[(2*XY_SZ)-1:XY_SZ] > myY ? RIGHT  :
                        stream_in_TDATA[(2*XY_SZ)-1:XY_SZ] < myY ? LEFT   : LOCAL;
+`endif
    end
 endgenerate
 
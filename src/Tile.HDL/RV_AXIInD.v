@@ -64,7 +64,10 @@ module RV_AXIInD #(
 
   output  [31:0]        tile_coordinates,
   input  [31:0]         rxPacketCount,
-  input  [31:0]         rxByteCount
+  input  [31:0]         rxByteCount,
+
+  output  [7:0]         stats_sel,
+  input   [31:0]        stats_dout
 );
 
 localparam  ADDR_STAT = 'h0,
@@ -75,7 +78,8 @@ localparam  ADDR_STAT = 'h0,
 localparam  OP_WRITE =  32'h1,
             OP_READ =   32'h2,
             OP_STATUS = 32'h3,
-            OP_RISCV =  32'h4;
+            OP_RISCV =  32'h4,
+            OP_STATS =  32'h5;
 
 wire                    csrAck, csrStatAck, csrEn;
 wire      [7:0]         csrStat, csrComOp;
@@ -173,7 +177,7 @@ Register #(
   .Reset(             ~aresetn),
   .Set(               1'b0),
   .Enable(            csrEn),
-  .In(                mem_dout),
+  .In(                (csrComOp == OP_STATS) ? stats_dout : mem_dout),
   .Out(               csrDOut)
 );
 
@@ -184,10 +188,13 @@ Register #(
   .Reset(             ~aresetn),
   .Set(               1'b0),
   .Enable(            1'b1),
-  .In(                csrEn && ((csrAddr == ADDR_DATA) || (csrComOp == OP_READ))),
+  .In(                csrEn && ((csrAddr == ADDR_DATA) || (csrComOp == OP_READ) || (csrComOp == OP_STATS))),
   .Out(               csrAck)
 );
 
+//- OP_STATS reads the message instruction counter selected by the address
+assign stats_sel =    csrAddr[7:0];
+
 assign mem_we =       (csrComOp == OP_WRITE);
 assign mem_en =       (csrComOp == OP_WRITE) || (csrComOp == OP_READ);
 
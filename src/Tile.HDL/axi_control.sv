@@ -76,7 +76,10 @@ module axi_control#(
   //- 
   output logic [7:0] rvControl,
   output logic [BW-1:0] tile_coordinates_line,     //- Tile identification
-  output logic [BW-1:0] tile_coordinates_ctrl     //- Tile identification
+  output logic [BW-1:0] tile_coordinates_ctrl,    //- Tile identification
+  //- Message instruction counters
+  output logic    [7:0] stats_sel,
+  input  logic [BW-1:0] stats_dout
 );
 
 
@@ -148,7 +151,9 @@ RV_AXIInD rvaxiIndirect_inst (
   .rv_control       (rvControl),               //- Output
   .tile_coordinates (tile_coordinates_ctrl),   //- Output
   .rxPacketCount    (rxPacketCount_sync),      //- Input
-  .rxByteCount      (rxByteCount_sync));       //- Input
+  .rxByteCount      (rxByteCount_sync),        //- Input
+  .stats_sel        (stats_sel),               //- Output
+  .stats_dout       (stats_dout));             //- Input
 
 ///////////////////////////////////
 // Packet Counters
@@ -126,7 +126,9 @@ RV_AXIInD rvaxiIndirect_inst (
   .rv_control       (rvControl),               //- Output
   .tile_coordinates (tile_coordinates_ctrl),   //- Output
   .rxPacketCount    (rxPacketCount_sync),      //- Input
-  .rxByteCount      (rxByteCount_sync));       //- Input
+  .rxByteCount      (rxByteCount_sync),        //- Input
+  .stats_sel        ( ),                       //- Output
+  .stats_dout       (32'h0));                  //- Input
 
 ///////////////////////////////////
 // Packet Counters
@@ -39,8 +39,9 @@
 
 module dm_cache_data#(
   parameter CACHE_LINES      = 8,                   //- 8 Words of 512 bits
-  parameter CACHE_LINE_WIDTH = $clog2(CACHE_LINES)  //bits to designate a cache 
+  parameter CACHE_LINE_WIDTH = $clog2(CACHE_LINES), //bits to designate a cache 
                                                     // line among others (i.e. log2(Cache_Lines)
+  parameter MEMORY_PRIMITIVE = "auto"               //- "auto", "block" or "ultra" (URAM)
 )(
   input  logic	                       clk,
   input  logic                        rst,
@@ -60,7 +61,7 @@ xpm_memory_spram #(
    .MEMORY_INIT_FILE("none"),       // String
    .MEMORY_INIT_PARAM("0"),         // String
    .MEMORY_OPTIMIZATION("true"),    // String
-   .MEMORY_PRIMITIVE("auto"),       // String
+   .MEMORY_PRIMITIVE(MEMORY_PRIMITIVE), // String
    //.MEMORY_SIZE(524288),          // DECIMAL
    .MEMORY_SIZE(CACHE_LINES * 512), // DECIMAL
    .MESSAGE_CONTROL(0),             // DECIMAL
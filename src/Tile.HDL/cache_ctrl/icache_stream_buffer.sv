@@ -0,0 +1,186 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+///////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Next-line prefetch stream buffer for
+//               the instruction cache
+// File        : icache_stream_buffer.sv
+// Notes       :
+//    - Sits between sa_icache and the NoC encoder.
+//      Holds the DEPTH lines that follow the last miss
+//      and keeps DEPTH line requests in flight.
+//    - A miss on the head line is served from the buffer
+//      (or as soon as it arrives) and the next line is
+//      requested. Any other miss flushes the buffer and
+//      restarts the stream after the missing line.
+//    - The DRAM tile answers in order: responses of a
+//      flushed stream are dropped.
+//    - stat_useful: a prefetched line was used.
+//      stat_useless: a prefetched line was discarded.
+////////////////////////////////////////////////////
+
+`timescale 1 ps / 1 ps
+
+module icache_stream_buffer#(
+  parameter MEM_BUS_SZ = 512,
+  parameter DEPTH      = 2   // 1 to 4 lines
+)(
+   input clk,
+   input rst,
+   //- Cache side
+   input  logic           [31:0] cache_req_addr,   //- line byte addr
+   input  logic                  cache_req_valid,
+   output logic                  cache_req_ready,
+   output logic [MEM_BUS_SZ-1:0] cache_data,
+   output logic                  cache_data_ready,
+   //- Memory side
+   output logic           [31:0] mem_req_addr,
+   output logic                  mem_req_valid,
+   input  logic                  mem_req_ready,
+   input  logic [MEM_BUS_SZ-1:0] mem_data_data,
+   input  logic                  mem_data_ready,
+   //- Statistics
+   output logic                  stat_useful,
+   output logic                  stat_useless
+);
+
+localparam LINE_W = $clog2(MEM_BUS_SZ/8);
+localparam SLOT_W = DEPTH > 1 ? $clog2(DEPTH) : 1;
+localparam CNT_W  = $clog2(DEPTH+1);
+
+logic [MEM_BUS_SZ-1:0] sb_data [0:DEPTH-1];
+
+logic                   sb_on;        //- A stream is active
+logic  [31-LINE_W:0]    base;         //- Line of the head entry
+logic  [SLOT_W-1:0]     head;
+logic  [CNT_W-1:0]      n_iss;        //- Entries requested (from the head)
+logic  [CNT_W-1:0]      n_rdy;        //- Entries filled (from the head)
+logic  [CNT_W+1:0]      drop_cnt;     //- Responses of a flushed stream
+logic  [CNT_W+1:0]      useless_cnt;  //- Discarded entries not yet counted
+logic                   demand_issue; //- The missing line must be requested
+logic                   demand_mem;   //- The missing line is in flight
+logic                   wait_head;    //- The miss waits for the head entry
+logic                   deliver_head; //- The head entry goes to the cache
+logic  [31-LINE_W:0]    demand_line;
+
+logic                   pop;
+logic                   fill;
+logic                   fill_head;
+logic                   issue_pf;
+logic                   flush;
+logic  [SLOT_W-1:0]     fill_slot;
+
+function automatic [SLOT_W-1:0] slot(input [SLOT_W-1:0] h, input [CNT_W-1:0] i);
+   slot = (h + i) % DEPTH;
+endfunction
+
+assign cache_req_ready = ~demand_issue & ~demand_mem & ~wait_head & ~deliver_head;
+
+assign flush    = cache_req_valid & cache_req_ready & ~(sb_on & (cache_req_addr[31:LINE_W] == base));
+//- No prefetch in a flush cycle: drop_cnt only counts what was issued before
+assign issue_pf = ~demand_issue & ~flush & sb_on & (n_iss < DEPTH) & mem_req_ready;
+
+//- Responses in order: flushed stream, missing line, stream entries
+assign fill      = mem_data_ready & (drop_cnt == 0) & ~demand_mem;
+assign fill_head = fill & wait_head & (n_rdy == 0);
+assign fill_slot = slot(head, n_rdy);
+
+assign pop = deliver_head | fill_head;
+
+assign mem_req_valid = demand_issue | (~flush & sb_on & (n_iss < DEPTH));
+assign mem_req_addr  = demand_issue ? {demand_line,{LINE_W{1'b0}}} :
+                                      {base + n_iss,{LINE_W{1'b0}}};
+
+assign cache_data_ready = (mem_data_ready & demand_mem & (drop_cnt == 0)) | pop;
+assign cache_data       = deliver_head ? sb_data[head] : mem_data_data;
+
+assign stat_useful  = pop;
+assign stat_useless = useless_cnt != 0;
+
+always @(posedge clk) begin
+   if (fill & ~fill_head) sb_data[fill_slot] <= mem_data_data;
+end
+
+always @(posedge clk or posedge rst) begin
+  if (rst) begin
+    sb_on        <= 1'b0;
+    base         <= 'h0;
+    head         <= 'h0;
+    n_iss        <= 'h0;
+    n_rdy        <= 'h0;
+    drop_cnt     <= 'h0;
+    useless_cnt  <= 'h0;
+    demand_issue <= 1'b0;
+    demand_mem   <= 1'b0;
+    wait_head    <= 1'b0;
+    deliver_head <= 1'b0;
+    demand_line  <= 'h0;
+  end else begin
+    deliver_head <= 1'b0;
+
+    //- Responses
+    if (mem_data_ready) begin
+      if (drop_cnt != 0) drop_cnt   <= drop_cnt - 'h1;
+      else if (demand_mem) demand_mem <= 1'b0;
+    end
+
+    if (flush) begin
+      //- Restart the stream after the missing line
+      drop_cnt     <= drop_cnt + (n_iss - n_rdy) - ((mem_data_ready & drop_cnt != 0) ? 'h1 : 'h0)
+                                                 - (fill ? 'h1 : 'h0);
+      useless_cnt  <= useless_cnt + n_iss - ((useless_cnt != 0) ? 'h1 : 'h0);
+      sb_on        <= 1'b1;
+      base         <= cache_req_addr[31:LINE_W] + 'h1;
+      head         <= 'h0;
+      n_iss        <= 'h0;
+      n_rdy        <= 'h0;
+      demand_issue <= 1'b1;
+      demand_line  <= cache_req_addr[31:LINE_W];
+    end else begin
+      if (useless_cnt != 0) useless_cnt <= useless_cnt - 'h1;
+
+      if (cache_req_valid & cache_req_ready) begin //- Head hit
+        if (n_rdy != 0) deliver_head <= 1'b1;
+        else            wait_head    <= 1'b1;
+      end
+
+      if (fill_head) wait_head <= 1'b0;
+
+      //- Pop the head, the freed entry is requested again as the tail
+      if (pop) begin
+        base <= base + 'h1;
+        head <= slot(head, 1);
+      end
+      n_iss <= n_iss + (issue_pf ? 'h1 : 'h0) - (pop ? 'h1 : 'h0);
+      n_rdy <= n_rdy + ((fill & ~fill_head) ? 'h1 : 'h0) - (deliver_head ? 'h1 : 'h0);
+    end
+
+    if (demand_issue & mem_req_ready) begin
+      demand_issue <= 1'b0;
+      demand_mem   <= 1'b1;
+    end
+  end
+end
+
+endmodule
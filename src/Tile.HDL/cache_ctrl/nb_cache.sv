@@ -0,0 +1,639 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+///////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Non-blocking set-associative cache of the
+//               DRAM tile
+// File        : nb_cache.sv
+// Notes       :
+//    - Write-back and write-allocate. CACHE_LINES lines
+//      in BANKS banks of WAYS ways, every way is a
+//      dm_cache_tag/dm_cache_data pair indexed by the set.
+//      Tree pseudo-LRU replacement, invalid ways first.
+//    - Consecutive lines go to consecutive banks. A bank
+//      has its own port: a line fill or a write hit only
+//      holds back requests to its bank.
+//    - A request is looked up the cycle after it is
+//      accepted, one request per cycle (write hits take
+//      two). A miss takes one of MSHRS miss registers and
+//      the lookup goes on with the next request (hit under
+//      miss, miss under miss).
+//    - Requests to a line that is being filled are added
+//      to the targets of its MSHR (up to TARGETS) and
+//      replayed in order when the line arrives. Misses to
+//      another line of the same set wait, as do hits to
+//      the way being replaced.
+//    - The line reads carry the MSHR as AXI id and can
+//      return in any order. Write-backs use id MSHRS, a
+//      line is not read again before its write-back is
+//      acknowledged.
+//    - Every request gets one response with its cpu_req_tag
+//      (data for reads), in completion order.
+//    - A line write (cpu_req_line, from mem_mgr_wcb) merges
+//      the bytes under cpu_req_lstrb on a hit. On a miss it
+//      is not allocated: it takes an MSHR only to go to
+//      memory with its strobes, no line read.
+//    - A prefetch (cpu_req_pf, PREFETCH=1) allocates a
+//      line that is not in the cache nor in an MSHR, with
+//      no target and no response. It is dropped otherwise,
+//      and when it would take the last free MSHR. Lines it
+//      brings are marked until a request hits them or they
+//      are replaced (pf_* events).
+////////////////////////////////////////////////////
+
+`timescale 1 ps / 1 ps
+
+module nb_cache#(
+  parameter CPU_BUS_SZ  = 32,
+  parameter MEM_BUS_SZ  = 512,
+  parameter CACHE_LINES = 16,
+  parameter WAYS        = 1,
+  parameter BANKS       = 1,
+  parameter DATA_PRIMITIVE = "auto", //- Data memories: "auto", "block" or "ultra"
+  parameter MSHRS       = 4,
+  parameter TARGETS     = 16,
+  parameter TAG_W       = 8,
+  parameter PREFETCH    = 0,
+  parameter S_AXI_ID_SZ = 11
+)(
+   input clk,
+   input rst,
+   //- CPU request (CPU -> Cache)
+   input  logic  [CPU_BUS_SZ-1:0]  cpu_req_addr,  // 32-bit request addr
+   input  logic  [CPU_BUS_SZ-1:0]  cpu_req_data,  // 32-bit request data (used when write)
+   input  logic                    cpu_req_rw,    // request type : 0 = read, 1 = write
+   input  logic                    cpu_req_valid, // request is valid
+   input  logic       [TAG_W-1:0]  cpu_req_tag,   // returned with the response
+   input  logic                    cpu_req_line,  // line write of cpu_req_ldata
+   input  logic  [MEM_BUS_SZ-1:0]  cpu_req_ldata,
+   input  logic [MEM_BUS_SZ/8-1:0] cpu_req_lstrb, // bytes of the line write
+   input  logic                    cpu_req_pf,    // line prefetch of cpu_req_addr
+   output logic                    cpu_req_ready,
+   //- Cache result (Cache->CPU)
+   output logic                    cpu_res_valid,
+   output logic  [CPU_BUS_SZ-1:0]  cpu_res_data,
+   output logic       [TAG_W-1:0]  cpu_res_tag,
+   //- Memory request (Cache->Memory)
+   output logic  [CPU_BUS_SZ-1:0]  mem_req_addr,  // request byte addr
+   output logic  [MEM_BUS_SZ-1:0]  mem_req_data,
+   output logic [MEM_BUS_SZ/8-1:0] mem_req_strb,
+   output logic                    mem_req_rw,    // request type : 0=read, 1=write
+   output logic                    mem_req_valid,
+   input  logic                    mem_req_ready,
+   output logic [S_AXI_ID_SZ-1:0]  mem_req_id,
+   //- Memory response (Memory -> Cache)
+   input  logic                    mem_rdata_valid,
+   input  logic  [MEM_BUS_SZ-1:0]  mem_data_data,
+   input  logic [S_AXI_ID_SZ-1:0]  mem_data_id,
+   input  logic                    mem_wresp_valid,
+   //- Prefetch events
+   output logic                    pf_fill,       // prefetch allocated
+   output logic                    pf_hit,        // hit on a prefetched line
+   output logic                    pf_late,       // miss on a line being prefetched
+   output logic                    pf_evict,      // prefetched line replaced unused
+   //- Counter events
+   output logic                    st_hit,
+   output logic                    st_miss,       // primary miss or line write miss
+   output logic                    st_merge,      // secondary miss
+   output logic                    st_wb          // dirty line written back
+);
+
+localparam LINE_W    = $clog2(MEM_BUS_SZ/8);          //- Byte in a line
+localparam WORD_W    = $clog2(MEM_BUS_SZ/CPU_BUS_SZ); //- Word in a line
+localparam LA_W      = 32 - LINE_W;                   //- Line address
+localparam SETS      = CACHE_LINES/(WAYS*BANKS);      //- Sets in a bank
+localparam SET_W     = $clog2(SETS);
+localparam IDX_W     = $clog2(CACHE_LINES/WAYS);      //- Set and bank
+localparam TAG_WIDTH = LA_W - IDX_W;
+localparam BK_W      = BANKS > 1 ? $clog2(BANKS) : 1;
+localparam WAY_W     = WAYS > 1 ? $clog2(WAYS) : 1;
+localparam PLRU_W    = WAYS > 1 ? WAYS-1 : 1;
+localparam M_W       = MSHRS > 1 ? $clog2(MSHRS) : 1;
+localparam T_W       = $clog2(TARGETS+1);
+
+//- MSHR states
+localparam [2:0] M_FREE   = 3'd0;
+localparam [2:0] M_WB     = 3'd1; //- Dirty victim to write back
+localparam [2:0] M_RD     = 3'd2; //- Line read to issue
+localparam [2:0] M_WAIT   = 3'd3; //- Waiting for the line
+localparam [2:0] M_REPLAY = 3'd4; //- Line here, replaying the targets
+localparam [2:0] M_WO     = 3'd5; //- Line write miss to send, no way
+
+//- Lookup stage
+logic                  s_valid;
+logic           [31:0] s_addr;
+logic           [31:0] s_data;
+logic                  s_rw;
+logic      [TAG_W-1:0] s_tag;
+logic                  s_lw;    //- Line write
+logic [MEM_BUS_SZ-1:0] s_ldata;
+logic [MEM_BUS_SZ/8-1:0] s_lstrb;
+logic                  s_pf;    //- Prefetch
+logic                  arr_ok;  //- The arrays were read for s_addr
+logic       [LA_W-1:0] s_line;
+logic      [IDX_W-1:0] s_idx;
+logic       [BK_W-1:0] s_bank;
+logic      [SET_W-1:0] s_set;
+logic  [TAG_WIDTH-1:0] s_ttag;
+logic     [WORD_W-1:0] s_woff;
+
+//- Arrays, way w of bank b at b*WAYS+w
+logic                  rd_valid [0:BANKS*WAYS-1];
+logic                  rd_dirty [0:BANKS*WAYS-1];
+logic  [TAG_WIDTH-1:0] rd_tag   [0:BANKS*WAYS-1];
+logic [MEM_BUS_SZ-1:0] rd_data  [0:BANKS*WAYS-1];
+logic      [SET_W-1:0] bk_idx   [0:BANKS-1];
+logic      [BANKS-1:0] bk_wr_hit;
+logic      [BANKS-1:0] bk_fill;
+logic       [BK_W-1:0] req_bank;
+logic       [BK_W-1:0] fill_bank;
+logic       [LA_W-1:0] fill_line;
+logic       [WAYS-1:0] way_hit;
+logic       [WAYS-1:0] way_busy;  //- Ways being replaced in the set of s_addr
+logic      [WAY_W-1:0] hit_way;
+logic                  hit;
+logic [MEM_BUS_SZ-1:0] hit_data;
+logic [MEM_BUS_SZ-1:0] data_merge;
+
+//- Replacement
+logic     [PLRU_W-1:0] plru [0:BANKS*SETS-1];
+logic     [PLRU_W-1:0] plru_upd;
+logic      [WAY_W-1:0] plru_way;
+logic      [WAY_W-1:0] victim;
+logic                  v_dirty;
+logic  [TAG_WIDTH-1:0] v_tag;
+
+//- MSHRs
+logic            [2:0] m_state   [0:MSHRS-1];
+logic       [LA_W-1:0] m_line    [0:MSHRS-1];
+logic       [LA_W-1:0] m_wb_line [0:MSHRS-1];
+logic [MEM_BUS_SZ-1:0] m_buf     [0:MSHRS-1]; //- Victim, then the filled line
+logic [MEM_BUS_SZ/8-1:0] m_strb  [0:MSHRS-1]; //- Bytes of the write
+logic      [WAY_W-1:0] m_way     [0:MSHRS-1];
+logic                  m_dirty   [0:MSHRS-1];
+logic        [T_W-1:0] m_cnt     [0:MSHRS-1];
+logic        [T_W-1:0] m_ptr     [0:MSHRS-1];
+logic                  m_pf      [0:MSHRS-1]; //- Prefetch, no request waits
+
+//- Targets, TARGETS per MSHR
+logic                  t_rw   [0:MSHRS*TARGETS-1];
+logic     [WORD_W-1:0] t_woff [0:MSHRS*TARGETS-1];
+logic           [31:0] t_data [0:MSHRS*TARGETS-1];
+logic      [TAG_W-1:0] t_tag  [0:MSHRS*TARGETS-1];
+
+//- Write-backs not acknowledged
+logic       [LA_W-1:0] wbq_line  [0:MSHRS-1];
+logic      [MSHRS-1:0] wbq_valid;
+logic        [M_W-1:0] wbq_head;
+logic        [M_W-1:0] wbq_tail;
+
+logic                  accept;
+logic                  cmp_done;
+logic                  cmp_res;
+logic                  cmp_wr_hit;
+logic                  cmp_alloc;
+logic                  cmp_append;
+logic                  cmp_wo;
+logic                  cmp_ack;
+logic                  line_hit;
+logic                  idx_hit;
+logic                  wo_hit;  //- Line write of s_addr not sent yet
+logic        [M_W-1:0] line_m;
+logic                  free_any;
+logic        [M_W-1:0] free_m;
+logic                  free_two; //- A prefetch leaves one MSHR free
+logic                  hit_pf;   //- Marks of the hit and replaced ways
+logic                  v_pf;
+
+logic                  rp_any;
+logic        [M_W-1:0] rp_m;
+logic                  rp_step;
+logic                  fill_wr;
+logic [$clog2(MSHRS*TARGETS)-1:0] rp_t;
+
+logic      [MSHRS-1:0] rd_block;
+logic                  iss_any;
+logic        [M_W-1:0] iss_m;
+logic                  iss;
+
+//- Banks take the low bits of the line address, then the set
+function automatic [BK_W-1:0] bank_of(input [LA_W-1:0] line);
+   bank_of = BANKS > 1 ? line[BK_W-1:0] : 'h0;
+endfunction
+
+function automatic [SET_W-1:0] set_of(input [LA_W-1:0] line);
+   set_of = line[IDX_W-1:IDX_W-SET_W];
+endfunction
+
+assign s_line = s_addr[31:LINE_W];
+assign s_idx  = s_line[IDX_W-1:0];
+assign s_bank = bank_of(s_line);
+assign s_set  = set_of(s_line);
+assign s_ttag = s_line[LA_W-1:IDX_W];
+assign s_woff = s_addr[LINE_W-1:2];
+
+//- MSHR lookup: same line, same set, first free. Line writes hold no way
+always @( * ) begin
+   line_hit = 1'b0;
+   idx_hit  = 1'b0;
+   wo_hit   = 1'b0;
+   way_busy = 'h0;
+   line_m   = 'h0;
+   free_any = 1'b0;
+   free_m   = 'h0;
+   free_two = 1'b0;
+   for (int m=MSHRS-1; m>=0; m=m-1) begin
+      if (m_state[m] != M_FREE & m_state[m] != M_WO & m_line[m] == s_line) begin
+         line_hit = 1'b1;
+         line_m   = m;
+      end
+      if (m_state[m] != M_FREE & m_state[m] != M_WO & m_line[m][IDX_W-1:0] == s_idx) begin
+         idx_hit            = 1'b1;
+         way_busy[m_way[m]] = 1'b1;
+      end
+      if (m_state[m] == M_WO & m_wb_line[m] == s_line)
+         wo_hit = 1'b1;
+      if (m_state[m] == M_FREE) begin
+         free_two = free_any;
+         free_any = 1'b1;
+         free_m   = m;
+      end
+   end
+end
+
+//- Lookup
+always @( * ) begin
+   cmp_done   = 1'b0;
+   cmp_res    = 1'b0;
+   cmp_wr_hit = 1'b0;
+   cmp_alloc  = 1'b0;
+   cmp_append = 1'b0;
+   cmp_wo     = 1'b0;
+   if (s_valid & arr_ok) begin
+      if (s_pf) begin //- Prefetch, dropped unless it is a clean miss
+         cmp_alloc = ~line_hit & ~hit & ~idx_hit & ~wo_hit & free_two;
+         cmp_done  = 1'b1;
+      end else if (line_hit) begin //- Secondary miss, a line write waits for the line
+         if (~s_lw & m_cnt[line_m] < TARGETS) begin
+            cmp_append = 1'b1;
+            cmp_done   = 1'b1;
+         end
+      end else if (hit & ~way_busy[hit_way]) begin
+         cmp_res    = 1'b1;
+         cmp_wr_hit = s_rw;
+         cmp_done   = 1'b1;
+      end else if (idx_hit) begin
+         //- Wait for the line of the MSHR
+      end else if (s_lw) begin
+         //- Line write miss, after the previous one of the line
+         if (free_any & ~wo_hit) begin
+            cmp_wo   = 1'b1;
+            cmp_done = 1'b1;
+         end
+      end else if (free_any) begin
+         cmp_alloc = 1'b1;
+         cmp_done  = 1'b1;
+      end
+   end
+end
+
+//- Replay: one target per cycle, the lookup responds first
+always @( * ) begin
+   rp_any = 1'b0;
+   rp_m   = 'h0;
+   for (int m=MSHRS-1; m>=0; m=m-1)
+      if (m_state[m] == M_REPLAY) begin
+         rp_any = 1'b1;
+         rp_m   = m;
+      end
+end
+
+assign rp_t      = rp_m*TARGETS + m_ptr[rp_m];
+assign fill_line = m_line[rp_m];
+assign fill_bank = bank_of(fill_line);
+assign req_bank  = bank_of(cpu_req_addr[31:LINE_W]);
+
+assign cmp_ack = cmp_res | cmp_wo;
+assign rp_step = rp_any & (m_ptr[rp_m] < m_cnt[rp_m]) & ~cmp_ack;
+assign fill_wr = rp_any & (m_ptr[rp_m] == m_cnt[rp_m]) & ~(cmp_wr_hit & s_bank == fill_bank) &
+                 ~(cmp_append & line_m == rp_m);
+
+assign cpu_req_ready = (~s_valid | cmp_done) & ~(cmp_wr_hit & s_bank == req_bank) &
+                       ~(fill_wr & fill_bank == req_bank);
+assign accept        = cpu_req_valid & cpu_req_ready;
+
+assign cpu_res_valid = cmp_ack | rp_step;
+assign cpu_res_tag   = cmp_ack ? s_tag : t_tag[rp_t];
+assign cpu_res_data  = cmp_ack ? (s_rw ? 'h0 : hit_data[s_woff*CPU_BUS_SZ +: CPU_BUS_SZ]) :
+                       t_rw[rp_t] ? 'h0 : m_buf[rp_m][t_woff[rp_t]*CPU_BUS_SZ +: CPU_BUS_SZ];
+
+//- Hit
+always @( * ) begin
+   hit_way = 'h0;
+   for (int w=0; w<WAYS; w=w+1) begin
+      way_hit[w] = rd_valid[s_bank*WAYS+w] & rd_tag[s_bank*WAYS+w] == s_ttag;
+      if (way_hit[w]) hit_way = w;
+   end
+end
+
+assign hit      = |way_hit;
+assign hit_data = rd_data[s_bank*WAYS+hit_way];
+
+always @( * ) begin
+   data_merge = hit_data;
+   if (s_lw) begin
+      for (int i=0; i<MEM_BUS_SZ/8; i=i+1)
+         if (s_lstrb[i]) data_merge[i*8 +: 8] = s_ldata[i*8 +: 8];
+   end else
+      data_merge[s_woff*CPU_BUS_SZ +: CPU_BUS_SZ] = s_data;
+end
+
+//- Tree pseudo-LRU as in sa_icache, invalid ways first
+always @( * ) begin
+   int node;
+   victim = 'h0;
+   if (WAYS > 1) begin
+      node = 0;
+      for (int l=0; l<WAY_W; l=l+1)
+         node = 2*node + 1 + plru[s_bank*SETS+s_set][node];
+      victim = node - (WAYS-1);
+      for (int i=WAYS-1; i>=0; i=i-1)
+         if (~rd_valid[s_bank*WAYS+i]) victim = i;
+   end
+end
+
+assign v_dirty = rd_valid[s_bank*WAYS+victim] & rd_dirty[s_bank*WAYS+victim];
+assign v_tag   = rd_tag[s_bank*WAYS+victim];
+
+assign pf_fill  = cmp_alloc & s_pf;
+assign pf_hit   = cmp_res & hit_pf;
+assign pf_late  = cmp_append & m_pf[line_m];
+assign pf_evict = cmp_alloc & v_pf;
+
+assign st_hit   = cmp_res;
+assign st_miss  = (cmp_alloc & ~s_pf) | cmp_wo;
+assign st_merge = cmp_append;
+assign st_wb    = iss & m_state[iss_m] == M_WB;
+
+//- Prefetched lines, way w of bank b at (b*WAYS+w)*SETS+set
+generate
+if (PREFETCH) begin : pf_marks
+  logic pf_mark [0:BANKS*WAYS*SETS-1];
+
+  assign hit_pf = pf_mark[(s_bank*WAYS+hit_way)*SETS+s_set];
+  assign v_pf   = rd_valid[s_bank*WAYS+victim] & pf_mark[(s_bank*WAYS+victim)*SETS+s_set];
+
+  always @(posedge clk or posedge rst) begin
+    if (rst) begin
+      for (int i=0; i<BANKS*WAYS*SETS; i=i+1)
+        pf_mark[i] <= 1'b0;
+    end else begin
+      if (fill_wr) pf_mark[(fill_bank*WAYS+m_way[rp_m])*SETS+set_of(fill_line)] <= m_pf[rp_m];
+      if (pf_hit)  pf_mark[(s_bank*WAYS+hit_way)*SETS+s_set] <= 1'b0;
+    end
+  end
+end else begin : no_pf_marks
+  assign hit_pf = 1'b0;
+  assign v_pf   = 1'b0;
+end
+endgenerate
+
+//- Point the path away from the hit or replaced way
+assign plru_way = cmp_alloc ? victim : hit_way;
+
+always @( * ) begin
+   int node;
+   plru_upd = plru[s_bank*SETS+s_set];
+   if (WAYS > 1) begin
+      node = 0;
+      for (int l=WAY_W-1; l>=0; l=l-1) begin
+         plru_upd[node] = ~plru_way[l];
+         node = 2*node + 1 + plru_way[l];
+      end
+   end
+end
+
+always @(posedge clk or posedge rst) begin
+  if (rst) begin
+    for (int i=0; i<BANKS*SETS; i=i+1)
+      plru[i] <= 'h0;
+  end else if (cmp_res | cmp_alloc) begin
+    plru[s_bank*SETS+s_set] <= plru_upd;
+  end
+end
+
+//- Bank ports: write hit, then line fill, then lookup read
+always @( * ) begin
+   for (int b=0; b<BANKS; b=b+1) begin
+      bk_wr_hit[b] = cmp_wr_hit & s_bank == b;
+      bk_fill[b]   = fill_wr & fill_bank == b;
+      bk_idx[b]    = bk_wr_hit[b]             ? s_set :
+                     bk_fill[b]               ? set_of(fill_line) :
+                     (accept & req_bank == b) ? set_of(cpu_req_addr[31:LINE_W]) : s_set;
+   end
+end
+
+genvar b,w;
+
+generate
+  for (b=0; b<BANKS; b=b+1) begin : cache_bank
+    for (w=0; w<WAYS; w=w+1) begin : cache_way
+      logic way_we;
+
+      assign way_we = (bk_wr_hit[b] & hit_way == w) | (bk_fill[b] & m_way[rp_m] == w);
+
+      dm_cache_tag#(
+        .CACHE_LINES (SETS),
+        .TAG_WIDTH   (TAG_WIDTH)
+      ) ctag (
+        .clk             (clk),
+        .rst             (rst),
+        .tag_req_index   (bk_idx[b]),
+        .tag_req_we      (way_we),
+        .tag_write_valid (1'b1),
+        .tag_write_dirty (bk_wr_hit[b] | m_dirty[rp_m]),
+        .tag_write_tag   (bk_wr_hit[b] ? s_ttag : fill_line[LA_W-1:IDX_W]),
+        .tag_read_valid  (rd_valid[b*WAYS+w]),
+        .tag_read_dirty  (rd_dirty[b*WAYS+w]),
+        .tag_read_tag    (rd_tag[b*WAYS+w])
+      );
+
+      dm_cache_data#(
+        .CACHE_LINES      (SETS),
+        .MEMORY_PRIMITIVE (DATA_PRIMITIVE)
+      ) cdata (
+        .clk            (clk),
+        .rst            (rst),
+        .data_req_index (bk_idx[b]),
+        .data_req_we    (way_we),
+        .data_write     (bk_wr_hit[b] ? data_merge : m_buf[rp_m]),
+        .data_read      (rd_data[b*WAYS+w])
+      );
+    end
+  end
+endgenerate
+
+//- Memory requests: write-backs first, a read waits for the writes of its line
+always @( * ) begin
+   for (int m=0; m<MSHRS; m=m+1) begin
+      rd_block[m] = 1'b0;
+      for (int w=0; w<MSHRS; w=w+1) begin
+         if (wbq_valid[w] & wbq_line[w] == m_line[m]) rd_block[m] = 1'b1;
+         if (m_state[w] == M_WO & m_wb_line[w] == m_line[m]) rd_block[m] = 1'b1;
+      end
+   end
+end
+
+always @( * ) begin
+   iss_any = 1'b0;
+   iss_m   = 'h0;
+   for (int m=MSHRS-1; m>=0; m=m-1)
+      if (((m_state[m] == M_WB | m_state[m] == M_WO) & ~wbq_valid[wbq_tail]) |
+          (m_state[m] == M_RD & ~rd_block[m])) begin
+         iss_any = 1'b1;
+         iss_m   = m;
+      end
+end
+
+assign iss           = iss_any & mem_req_ready;
+assign mem_req_valid = iss;
+assign mem_req_rw    = m_state[iss_m] == M_WB | m_state[iss_m] == M_WO;
+assign mem_req_addr  = {mem_req_rw ? m_wb_line[iss_m] : m_line[iss_m], {LINE_W{1'b0}}};
+assign mem_req_data  = m_buf[iss_m];
+assign mem_req_strb  = m_strb[iss_m];
+assign mem_req_id    = mem_req_rw ? MSHRS : iss_m;
+
+always @(posedge clk or posedge rst) begin
+  if (rst) begin
+    s_valid   <= 1'b0;
+    s_addr    <= 'h0;
+    s_data    <= 'h0;
+    s_rw      <= 1'b0;
+    s_tag     <= 'h0;
+    s_lw      <= 1'b0;
+    s_ldata   <= 'h0;
+    s_lstrb   <= 'h0;
+    s_pf      <= 1'b0;
+    arr_ok    <= 1'b0;
+    wbq_valid <= 'h0;
+    wbq_head  <= 'h0;
+    wbq_tail  <= 'h0;
+    for (int m=0; m<MSHRS; m=m+1) begin
+      m_state[m] <= M_FREE;
+      m_dirty[m] <= 1'b0;
+      m_cnt[m]   <= 'h0;
+      m_ptr[m]   <= 'h0;
+      m_pf[m]    <= 1'b0;
+    end
+  end else begin
+    arr_ok <= accept | ~(fill_wr & fill_bank == s_bank);
+
+    if (accept) begin
+      s_valid <= 1'b1;
+      s_addr  <= cpu_req_addr;
+      s_data  <= cpu_req_data;
+      s_rw    <= cpu_req_rw;
+      s_tag   <= cpu_req_tag;
+      s_lw    <= cpu_req_line;
+      s_ldata <= cpu_req_ldata;
+      s_lstrb <= cpu_req_lstrb;
+      s_pf    <= cpu_req_pf;
+    end else if (cmp_done) s_valid <= 1'b0;
+
+    //- Primary miss
+    if (cmp_alloc) begin
+      m_state[free_m]   <= v_dirty ? M_WB : M_RD;
+      m_line[free_m]    <= s_line;
+      m_wb_line[free_m] <= {v_tag, s_idx};
+      m_buf[free_m]     <= rd_data[s_bank*WAYS+victim];
+      m_strb[free_m]    <= {(MEM_BUS_SZ/8){1'b1}};
+      m_way[free_m]     <= victim;
+      m_dirty[free_m]   <= 1'b0;
+      m_cnt[free_m]     <= s_pf ? 'h0 : 'h1;
+      m_ptr[free_m]     <= 'h0;
+      m_pf[free_m]      <= s_pf;
+      t_rw[free_m*TARGETS]   <= s_rw;
+      t_woff[free_m*TARGETS] <= s_woff;
+      t_data[free_m*TARGETS] <= s_data;
+      t_tag[free_m*TARGETS]  <= s_tag;
+    end
+
+    //- Line write miss
+    if (cmp_wo) begin
+      m_state[free_m]   <= M_WO;
+      m_line[free_m]    <= s_line;
+      m_wb_line[free_m] <= s_line;
+      m_buf[free_m]     <= s_ldata;
+      m_strb[free_m]    <= s_lstrb;
+      m_cnt[free_m]     <= 'h0;
+      m_ptr[free_m]     <= 'h0;
+      m_pf[free_m]      <= 1'b0;
+    end
+
+    //- Secondary miss
+    if (cmp_append) begin
+      t_rw[line_m*TARGETS+m_cnt[line_m]]   <= s_rw;
+      t_woff[line_m*TARGETS+m_cnt[line_m]] <= s_woff;
+      t_data[line_m*TARGETS+m_cnt[line_m]] <= s_data;
+      t_tag[line_m*TARGETS+m_cnt[line_m]]  <= s_tag;
+      m_cnt[line_m] <= m_cnt[line_m] + 'h1;
+      m_pf[line_m]  <= 1'b0;
+    end
+
+    //- Memory requests
+    if (iss) begin
+      if (mem_req_rw) begin
+        m_state[iss_m]      <= m_state[iss_m] == M_WO ? M_FREE : M_RD;
+        wbq_line[wbq_tail]  <= m_wb_line[iss_m];
+        wbq_valid[wbq_tail] <= 1'b1;
+        wbq_tail            <= (wbq_tail == MSHRS-1) ? 'h0 : wbq_tail + 'h1;
+      end else
+        m_state[iss_m] <= M_WAIT;
+    end
+    if (mem_wresp_valid & wbq_valid[wbq_head]) begin
+      wbq_valid[wbq_head] <= 1'b0;
+      wbq_head            <= (wbq_head == MSHRS-1) ? 'h0 : wbq_head + 'h1;
+    end
+
+    //- Line fill
+    if (mem_rdata_valid & mem_data_id < MSHRS) begin
+      if (m_state[mem_data_id[M_W-1:0]] == M_WAIT) begin
+        m_state[mem_data_id[M_W-1:0]] <= M_REPLAY;
+        m_buf[mem_data_id[M_W-1:0]]   <= mem_data_data;
+      end
+    end
+
+    //- Replay
+    if (rp_step) begin
+      if (t_rw[rp_t]) begin
+        m_buf[rp_m][t_woff[rp_t]*CPU_BUS_SZ +: CPU_BUS_SZ] <= t_data[rp_t];
+        m_dirty[rp_m] <= 1'b1;
+      end
+      m_ptr[rp_m] <= m_ptr[rp_m] + 'h1;
+    end
+    if (fill_wr) m_state[rp_m] <= M_FREE;
+  end
+end
+
+endmodule
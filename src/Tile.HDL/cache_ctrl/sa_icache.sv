@@ -0,0 +1,260 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+///////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Set-associative instruction cache
+// File        : sa_icache.sv
+// Notes       :
+//    - Read only, 64-byte lines. CACHE_KB (1-16) and
+//      WAYS (1,2,4,8) set the geometry, SETS must be
+//      at least 2.
+//    - Every way is a dm_cache_tag/dm_cache_data pair
+//      indexed by the set. Tree pseudo-LRU replacement,
+//      invalid ways are filled first.
+//    - Same timing as dm_cache_fsm: a hit answers two
+//      cycles after the request.
+////////////////////////////////////////////////////
+
+`timescale 1 ps / 1 ps
+
+module sa_icache#(
+  parameter CPU_BUS_SZ = 32,
+  parameter MEM_BUS_SZ = 512,
+  parameter CACHE_KB   = 4,
+  parameter WAYS       = 2
+)(
+   input clk,
+   input rst,
+   //- CPU request (CPU -> Cache)
+   input  logic [CPU_BUS_SZ-1:0] cpu_req_addr,   //- 32-bit request addr
+   input  logic                  cpu_req_valid,  //- request is valid
+   //- Cache result (Cache->CPU)
+   output logic [CPU_BUS_SZ-1:0] cpu_res_data,   //- 32-bit data
+   output logic                  cpu_res_valid,  //- result is ready
+   //- Memory request (Cache->Memory)
+   output logic [CPU_BUS_SZ-1:0] mem_req_addr,   //- line byte addr
+   output logic                  mem_req_valid,  //- held until mem_req_ready
+   input  logic                  mem_req_ready,
+   //- Memory response (Memory -> Cache)
+   input  logic [MEM_BUS_SZ-1:0] mem_data_data,
+   input  logic                  mem_data_ready,
+   //- Statistics
+   output logic                  stat_hit,
+   output logic                  stat_miss
+);
+
+localparam LINE_BYTES = MEM_BUS_SZ/8;
+localparam LINE_W     = $clog2(LINE_BYTES);
+localparam SETS       = (CACHE_KB*1024)/(LINE_BYTES*WAYS);
+localparam SET_W      = $clog2(SETS);
+localparam TAG_W      = 32 - SET_W - LINE_W;
+localparam WAY_W      = WAYS > 1 ? $clog2(WAYS) : 1;
+localparam PLRU_W     = WAYS > 1 ? WAYS-1 : 1;
+
+localparam [2:0] C_IDLE    = 3'd0;
+localparam [2:0] C_LOOKUP  = 3'd1; //- Tag and data memories are read
+localparam [2:0] C_COMPARE = 3'd2;
+localparam [2:0] C_MISS    = 3'd3; //- Line request to memory
+localparam [2:0] C_FILL    = 3'd4; //- Wait for the line
+
+logic [2:0] state;
+logic [2:0] next_state;
+
+logic [CPU_BUS_SZ-1:0] cpu_req_addr_reg;
+logic      [SET_W-1:0] req_set;
+logic      [TAG_W-1:0] req_tag;
+logic            [3:0] req_word;
+logic                  refill;
+logic                  next_refill;
+
+//- Ways
+logic            [WAYS-1:0] way_valid;
+logic       [TAG_W-1:0] way_tag  [0:WAYS-1];
+logic  [MEM_BUS_SZ-1:0] way_data [0:WAYS-1];
+logic            [WAYS-1:0] way_hit;
+logic            [WAYS-1:0] way_we;
+logic           [WAY_W-1:0] hit_way;
+logic                       hit;
+
+//- Replacement
+logic [PLRU_W-1:0] plru [0:SETS-1];
+logic [PLRU_W-1:0] plru_upd;
+logic  [WAY_W-1:0] victim;
+logic  [WAY_W-1:0] victim_reg;
+logic  [WAY_W-1:0] next_victim_reg;
+
+assign req_set  = cpu_req_addr_reg[SET_W+LINE_W-1:LINE_W];
+assign req_tag  = cpu_req_addr_reg[31:SET_W+LINE_W];
+assign req_word = cpu_req_addr_reg[5:2];
+
+always @(posedge clk or posedge rst) begin
+  if (rst) begin
+    cpu_req_addr_reg <= 'h0;
+  end else if (cpu_req_valid & state == C_IDLE) begin
+    cpu_req_addr_reg <= cpu_req_addr;
+  end
+end
+
+genvar w;
+
+generate
+  for (w=0; w<WAYS; w=w+1) begin : cache_way
+
+    dm_cache_tag#(
+      .CACHE_LINES (SETS)
+    ) ctag (
+      .clk             (clk),
+      .rst             (rst),
+      .tag_req_index   (req_set),
+      .tag_req_we      (way_we[w]),
+      .tag_write_valid (1'b1),
+      .tag_write_dirty (1'b0),
+      .tag_write_tag   (req_tag),
+      .tag_read_valid  (way_valid[w]),
+      .tag_read_dirty  (),
+      .tag_read_tag    (way_tag[w])
+    );
+
+    dm_cache_data#(
+      .CACHE_LINES (SETS)
+    ) cdata (
+      .clk            (clk),
+      .rst            (rst),
+      .data_req_index (req_set),
+      .data_req_we    (way_we[w]),
+      .data_write     (mem_data_data),
+      .data_read      (way_data[w])
+    );
+
+    assign way_hit[w] = way_valid[w] & (way_tag[w] == req_tag);
+    assign way_we[w]  = (state == C_FILL) & mem_data_ready & (victim_reg == w);
+  end
+endgenerate
+
+always @(*) begin
+   hit_way = 'h0;
+   for (int i=0; i<WAYS; i=i+1)
+      if (way_hit[i]) hit_way = i;
+end
+
+assign hit = |way_hit;
+
+//- Word out of the hit way
+assign cpu_res_data = way_data[hit_way][{req_word,5'h0} +: 32];
+
+//- Tree pseudo-LRU. Node n has children 2n+1 and 2n+2, a node
+//  bit of 0 points the victim to the lower half.
+always @(*) begin
+   int node;
+   victim = 'h0;
+   if (WAYS > 1) begin
+      node = 0;
+      for (int l=0; l<WAY_W; l=l+1)
+         node = 2*node + 1 + plru[req_set][node];
+      victim = node - (WAYS-1);
+      //- Invalid ways first
+      for (int i=WAYS-1; i>=0; i=i-1)
+         if (~way_valid[i]) victim = i;
+   end
+end
+
+//- Point every node of the path away from the accessed way
+always @(*) begin
+   int node;
+   plru_upd = plru[req_set];
+   if (WAYS > 1) begin
+      node = 0;
+      for (int l=WAY_W-1; l>=0; l=l-1) begin
+         plru_upd[node] = ~hit_way[l];
+         node = 2*node + 1 + hit_way[l];
+      end
+   end
+end
+
+always @(posedge clk or posedge rst) begin
+  if (rst) begin
+    for (int i=0; i<SETS; i=i+1)
+      plru[i] <= 'h0;
+  end else if (state == C_COMPARE & hit) begin
+    plru[req_set] <= plru_upd;
+  end
+end
+
+always @(posedge clk or posedge rst) begin
+  if (rst) begin
+    state      <= C_IDLE;
+    refill     <= 1'b0;
+    victim_reg <= 'h0;
+  end else begin
+    state      <= next_state;
+    refill     <= next_refill;
+    victim_reg <= next_victim_reg;
+  end
+end
+
+assign mem_req_addr = {cpu_req_addr_reg[31:LINE_W],{LINE_W{1'b0}}};
+
+always @(*) begin
+   next_state      = state;
+   next_refill     = refill;
+   next_victim_reg = victim_reg;
+
+   cpu_res_valid = 1'b0;
+   mem_req_valid = 1'b0;
+   stat_hit      = 1'b0;
+   stat_miss     = 1'b0;
+
+   case (state)
+      C_IDLE: begin
+         if (cpu_req_valid) next_state = C_LOOKUP;
+      end
+      C_LOOKUP: begin
+         next_state = C_COMPARE;
+      end
+      C_COMPARE: begin
+         if (hit) begin
+            cpu_res_valid = 1'b1;
+            stat_hit      = ~refill;
+            next_refill   = 1'b0;
+            next_state    = C_IDLE;
+         end else begin
+            stat_miss       = 1'b1;
+            next_victim_reg = victim;
+            next_state      = C_MISS;
+         end
+      end
+      C_MISS: begin
+         mem_req_valid = 1'b1;
+         if (mem_req_ready) next_state = C_FILL;
+      end
+      C_FILL: begin
+         if (mem_data_ready) begin
+            next_refill = 1'b1;
+            next_state  = C_LOOKUP; //- Read the new line
+         end
+      end
+   endcase
+end
+
+endmodule
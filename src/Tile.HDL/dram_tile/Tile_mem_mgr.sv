@@ -29,12 +29,16 @@
 // Notes       :
 //    - Modified to resemble the new structure for
 //      the 4x4 mosaic
+//    - With several DRAM tiles each one takes COL
+//      columns starting at Y0 and one memory channel
 ////////////////////////////////////////////////////
 
 `timescale 1 ps / 1 ps
 `include "global_defines.sv"
 module Tile_mem_mgr#(
-   parameter COL          = 4,
+   parameter COL          = 4,  //- Columns served by this DRAM tile
+   parameter Y0           = 0,  //- First column
+   parameter CHANNEL      = 0,  //- Memory channel (interleaving)
    parameter S_AXI_ID_SZ  = 11,
    parameter S_AXI_ADR_SZ = 34, // ADDRESS
    parameter S_AXI_LEN_SZ = 8,  // LENGTH
@@ -161,6 +165,10 @@ logic [S_AXI_ID_SZ-1:0] mem_req_id_axi;
 //- Registers
 logic   [7:0] rvControl;
 logic   [7:0] rvControl_memory;
+logic   [7:0] stats_sel;
+logic   [7:0] stats_sel_memory;
+logic  [31:0] stats_dout;
+logic  [31:0] stats_dout_memory;
 logic [BW_AXI-1:0] tile_coordinates_line;
 logic [BW_AXI-1:0] tile_coordinates_ctrl;
 logic [BW_AXI-1:0] tile_coordinates_memory;
@@ -234,7 +242,9 @@ axi_control#(
    .mem_rdata_axi          (32'h0), //-FIXME the results is too fast, how to sample it.
    .rvControl              (rvControl),
    .tile_coordinates_line  (tile_coordinates_line),
-   .tile_coordinates_ctrl  (tile_coordinates_ctrl));
+   .tile_coordinates_ctrl  (tile_coordinates_ctrl),
+   .stats_sel              (stats_sel),
+   .stats_dout             (stats_dout));
 
 ///////////////////////////////////
 // Accelerator Begin
@@ -261,7 +271,29 @@ xpm_cdc_array_single #(
   .dest_clk (clk_memory),
   .dest_out (rvControl_memory));
 
+//- Counters of the memory manager: the host writes the address before the command
+xpm_cdc_array_single #(
+  .WIDTH(8),
+  .SIM_ASSERT_CHK(`SIM_ASSERT_CHK)
+) stats_sel_cdc (
+  // Module ports
+  .src_clk  (clk_control),
+  .src_in   (stats_sel),
+  .dest_clk (clk_memory),
+  .dest_out (stats_sel_memory));
+
+xpm_cdc_array_single #(
+  .WIDTH(32),
+  .SIM_ASSERT_CHK(`SIM_ASSERT_CHK)
+) stats_dout_cdc (
+  // Module ports
+  .src_clk  (clk_memory),
+  .src_in   (stats_dout_memory),
+  .dest_clk (clk_control),
+  .dest_out (stats_dout));
+
 acc_mem_mgr#(
+   .CHANNEL   (CHANNEL),
    .OFFSET_SZ (12),
    .XY_SZ     (XY_SZ),
    .S_AXI_ID_SZ (S_AXI_ID_SZ),
@@ -280,6 +312,8 @@ acc_mem_mgr#(
    .HsrcId            ({myY_memory,myX_memory}),
    //.rvControl         (rvControl_memory_temp),
    .rvControl         (rvControl_memory),
+   .stats_sel         (stats_sel_memory),
+   .stats_dout        (stats_dout_memory),
   //- AXI Bus memory interface (From open-nic-shell to be clear, or less clear)
    .mem_valid_axi     (mem_valid_axi),
    .mem_addr_axi      (mem_addr_axi),
@@ -604,8 +638,10 @@ end else begin
 end
 
 tile_noc#(
-   .BW  (BW),
-   .BIG (1)
+   .BW     (BW),
+   .BIG    (1),
+   .OFFSET (Y0),
+   .PORTS  (COL < 4 ? COL : 4)
 ) tile_noc_0 (
    .HsrcId                       ({myY_line,myX_line}), 
    .stream_in_TVALID             (stream_in_TVALID_l0),
@@ -31,6 +31,7 @@
 `timescale 1 ps/ 1 ps
 `include "global_defines.sv"
 module acc_mem_mgr#(
+   parameter CHANNEL      = 0,  //- Memory channel of this DRAM tile
    parameter OFFSET_SZ    = 12,
    parameter XY_SZ        =  3,
    parameter S_AXI_ID_SZ  = 11,
@@ -59,6 +60,8 @@ module acc_mem_mgr#(
    input  logic                 clk_line_rst_high,
    input  logic [(XY_SZ*2)-1:0] HsrcId,     //- Tile identification
    input  logic          [7:0] rvControl,
+   input  logic          [7:0] stats_sel,  //- Counter read by the AXI bus
+   output logic         [31:0] stats_dout,
    
    //---NOC interface---//
    //- Input Interface
@@ -132,6 +135,21 @@ module acc_mem_mgr#(
 localparam CACHE_LINES  = `CACHE_LINES;
 localparam  CPU_BUS_SZ = 32;
 localparam  MEM_BUS_SZ = 512;
+localparam DDR_MSHRS   = `DDR_MSHRS;   //- 0: blocking cache (dm_cache_fsm)
+localparam CACHE_WAYS  = `DDR_CACHE_WAYS;
+localparam CACHE_BANKS = `DDR_CACHE_BANKS;
+localparam CACHE_PRIM  = `DDR_CACHE_URAM ? "ultra" : "auto";
+localparam RES_SLOTS   = DDR_MSHRS > 0 ? 2*DDR_MSHRS : 2;
+localparam RES_TAG_W   = 1 + $clog2(RES_SLOTS) + 4;
+localparam DDR_WCB     = `DDR_WCB;     //- Write-combining lines, 0: none
+localparam WCB_TIMEOUT = `DDR_WCB_TIMEOUT;
+localparam DRAM_TILES  = `DRAM_TILES;  //- Channels, DRAM_IL bytes each in turn
+localparam DRAM_IL     = `DRAM_IL;
+localparam CH_W        = DRAM_TILES > 1 ? $clog2(DRAM_TILES) : 1;
+localparam PF_STREAMS  = `DDR_PF_STREAMS; //- Prefetch streams, 0: none
+localparam PF_DIST     = `DDR_PF_DIST;
+localparam PF_DEGREE   = `DDR_PF_DEGREE;
+localparam DDR_STATS   = `DDR_STATS;      //- Performance counters
 
 logic           stream_in_TVALID_int;
 logic  [BW-1:0] stream_in_TDATA_int;
@@ -145,6 +163,18 @@ logic [ BWB-1:0] stream_out_TKEEP_int;
 logic            stream_out_TLAST_int;
 logic            stream_out_TREADY_int;
 
+//- Responses of the cache and of mem_mgr_bulk
+logic            stream_cache_TVALID;
+logic   [BW-1:0] stream_cache_TDATA;
+logic [ BWB-1:0] stream_cache_TKEEP;
+logic            stream_cache_TLAST;
+logic            stream_cache_TREADY;
+logic            stream_bulk_TVALID;
+logic   [BW-1:0] stream_bulk_TDATA;
+logic [ BWB-1:0] stream_bulk_TKEEP;
+logic            stream_bulk_TLAST;
+logic            stream_bulk_TREADY;
+
 //- CPU-CACHE interface
 logic cpu_req_valid; //- Cache input
 logic cpu_req_rw;    //- Cache input
@@ -164,8 +194,11 @@ logic [S_AXI_LEN_SZ-1:0] cpu_req_len_dec;   //-
 
 
 logic [BW-1:0] cpu_res_data;
+logic          cpu_res_valid;
+logic          cpu_res_ready;
 logic [BW-1:0] header1; 
 logic [BW-1:0] data1;
+logic [BW-1:0] cpu_req_reply;
 
 //- MEM. CTRL - CACHE
 logic [MEM_BUS_SZ-1:0] mem_data_data;  //- Cache input
@@ -174,10 +207,36 @@ logic                  mem_data_ready; //- Cache input
 //- CACHE-MEM. CTRL saved interface
 logic [CPU_BUS_SZ-1:0] mem_req_addr;   //- Cache output
 logic [MEM_BUS_SZ-1:0] mem_req_data;   //- Cache output 
+logic [MEM_BUS_SZ/8-1:0] mem_req_strb; //- Cache output
 logic mem_req_rw;     //- Cache output 
 logic mem_req_valid;  //- Cache output 
 logic  [S_AXI_ID_SZ-1:0] mem_req_id;     //- Cache output 
 logic [S_AXI_LEN_SZ-1:0] mem_req_len; //-
+logic                    mem_req_ready;
+logic                    mem_rdata_valid;
+logic  [S_AXI_ID_SZ-1:0] mem_data_id;
+logic                    mem_wresp_valid;
+
+//- Non-temporal long MPUT/MGET
+logic                    bulk_cmd_valid;
+logic                    bulk_cmd_rw;
+logic [BW-1:0]           bulk_cmd_addr;
+logic                    bulk_cmd_ready;
+logic                    bulk_wr_valid;
+logic [BW-1:0]           bulk_wr_data;
+logic                    bulk_wr_last;
+logic                    bulk_wr_ready;
+logic                    bulk_req_valid;
+logic                    bulk_req_rw;
+logic [31:0]             bulk_req_addr;
+logic [S_AXI_LEN_SZ-1:0] bulk_req_len;
+logic                    bulk_req_ready;
+logic                    bulk_wvalid;
+logic [MEM_BUS_SZ-1:0]   bulk_wdata;
+logic [MEM_BUS_SZ/8-1:0] bulk_wstrb;
+logic                    bulk_wlast;
+logic                    bulk_wready;
+logic                    bulk_rvalid;
 
 //- AXI control bus
 logic mem_valid_axi_fast;
@@ -187,6 +246,20 @@ logic [S_AXI_ID_SZ-1:0] mem_req_id_axi_fast;
 logic axi_in_en;
 logic [31:0] mem_addr_axi_last;
 logic mem_valid_axi_one;
+logic axi_in_hold;
+logic axi_in_hit;  //- The host word belongs to this channel
+
+//- Counters: mem_mgr_stats, prefetcher at 8'h40
+logic [31:0] pf_dout;
+logic [31:0] st_dout;
+logic        st_hit;
+logic        st_miss;
+logic        st_merge;
+logic        st_wb;
+logic        lat_valid;
+logic  [2:0] lat_code;
+logic [15:0] lat_cycles;
+logic        pkt_in;     //- Inside a NoC packet
 
 always @(posedge clk_ctrl) begin
    if (clk_ctrl_rst_high)
@@ -206,19 +279,32 @@ end
 always @(posedge clk_mem) begin
    if (~clk_mem_rst_low) axi_in_en <= 1'b0;
    else if (axi_in_en) axi_in_en <= 1'b0;
-   else if (~axi_in_empty & cpu_req_ready) axi_in_en <= 1'b1;
+   else if (~axi_in_empty & cpu_req_ready & ~axi_in_hold) axi_in_en <= 1'b1;
+end
+
+//- nb_cache takes a request only when ready: hold it until then
+assign axi_in_hold = DDR_MSHRS > 0 & mem_valid_axi_fast & axi_in_hit & ~cpu_req_ready;
+
+//- The host writes the whole image to every DRAM tile,
+//- each one keeps the words of its channel
+generate
+if (DRAM_TILES > 1) begin: g_axi_in_hit
+   assign axi_in_hit = mem_addr_axi_fast[DRAM_IL-2 +: CH_W] == CHANNEL;
+end else begin: g_axi_in_all
+   assign axi_in_hit = 1'b1;
 end
+endgenerate
 
 //- Delayed version of axi_in_en
 always @(posedge clk_mem) begin
    if (~clk_mem_rst_low) mem_valid_axi_fast <= 1'b0;
-   else mem_valid_axi_fast <= axi_in_en;
+   else mem_valid_axi_fast <= axi_in_en | axi_in_hold;
 end
 
 
 always @(posedge clk_mem) begin
   if (clk_mem_rst_high) mem_req_id_axi_fast <= 'h0;
-  else if (mem_valid_axi_fast) mem_req_id_axi_fast <= mem_req_id_axi_fast + 'h1;
+  else if (mem_valid_axi_fast & ~axi_in_hold) mem_req_id_axi_fast <= mem_req_id_axi_fast + 'h1;
 end
 
 
@@ -275,7 +361,7 @@ xpm_fifo_async# (
 
 
 /*Temporal MacGyver*/
-assign cpu_req_valid = ~rvControl[0] ? mem_valid_axi_fast : cpu_req_valid_dec;
+assign cpu_req_valid = ~rvControl[0] ? mem_valid_axi_fast & axi_in_hit : cpu_req_valid_dec;
 assign cpu_req_data  = ~rvControl[0] ? mem_wdata_axi_fast  : cpu_req_data_dec;
 assign cpu_req_rw    = ~rvControl[0] ? 1  : cpu_req_rw_dec; 
 assign cpu_req_addr  = ~rvControl[0] ? mem_addr_axi_fast << 2 : cpu_req_addr_dec;  
@@ -321,6 +407,16 @@ mem_mgr_noc_decoder mem_mgr_noc_decoder(
    .cpu_req_ready  (cpu_req_ready), 
    .cpu_req_id     (cpu_req_id_dec),
    .cpu_req_len    (cpu_req_len_dec),
+   .cpu_req_reply  (cpu_req_reply),
+   .bulk_en        (rvControl[0]),
+   .bulk_cmd_valid (bulk_cmd_valid),
+   .bulk_cmd_rw    (bulk_cmd_rw),
+   .bulk_cmd_addr  (bulk_cmd_addr),
+   .bulk_cmd_ready (bulk_cmd_ready),
+   .bulk_wr_valid  (bulk_wr_valid),
+   .bulk_wr_data   (bulk_wr_data),
+   .bulk_wr_last   (bulk_wr_last),
+   .bulk_wr_ready  (bulk_wr_ready),
    .header1        (header1),
    .data1          (data1)
 );
@@ -329,34 +425,359 @@ mem_mgr_noc_decoder mem_mgr_noc_decoder(
 // Cache
 //////////////////////////////
 
-dm_cache_fsm #(
-  .CPU_BUS_SZ (CPU_BUS_SZ),
-  .MEM_BUS_SZ (MEM_BUS_SZ)
-)dm_cache_fsm_inst(
-   .clk            (clk_mem),
-   .rst            (~clk_mem_rst_low),
-   //- CPU request (CPU -> Cache)
-   .cpu_req_addr   (cpu_req_addr),  // 32-bit request addr
-   .cpu_req_data   (cpu_req_data),  // 32-bit request data (used when write)
-   .cpu_req_rw     (cpu_req_rw),    // request type : 0 = read, 1 = write 
-   .cpu_req_valid  (cpu_req_valid), // request is valid
-   .cpu_req_ready  (cpu_req_ready), // Output 
-   .cpu_req_id     (cpu_req_id),
-   .cpu_req_len    (cpu_req_len),
-   //- Memory response (Memory -> Cache)
-   .mem_data_data  (mem_data_data),
-   .mem_data_ready (mem_data_ready),
-   //- Memory request (Cache->Memory)
-   .mem_req_addr   (mem_req_addr),  // request byte addr
-   .mem_req_data   (mem_req_data),  // 128-.request data (used when write)
-   .mem_req_rw     (mem_req_rw),    // request type : 0=read, 1=write
-   .mem_req_valid  (mem_req_valid), // request is valid
-   .mem_req_id     (mem_req_id),
-   .mem_req_len    (mem_req_len),
-   //- Cache result (Cache->CPU)
-   .cpu_res_data   (cpu_res_data),  //32-bit data
-   .cpu_res_ready  (cpu_res_ready), //
-   .cpu_res_valid  (cpu_res_valid)  // result is ready
+generate
+if (DDR_MSHRS == 0) begin : blocking
+
+  dm_cache_fsm #(
+    .CPU_BUS_SZ  (CPU_BUS_SZ),
+    .MEM_BUS_SZ  (MEM_BUS_SZ),
+    .CACHE_LINES (CACHE_LINES)
+  )dm_cache_fsm_inst(
+     .clk            (clk_mem),
+     .rst            (~clk_mem_rst_low),
+     //- CPU request (CPU -> Cache)
+     .cpu_req_addr   (cpu_req_addr),  // 32-bit request addr
+     .cpu_req_data   (cpu_req_data),  // 32-bit request data (used when write)
+     .cpu_req_rw     (cpu_req_rw),    // request type : 0 = read, 1 = write 
+     .cpu_req_valid  (cpu_req_valid), // request is valid
+     .cpu_req_ready  (cpu_req_ready), // Output 
+     .cpu_req_id     (cpu_req_id),
+     .cpu_req_len    (cpu_req_len),
+     //- Memory response (Memory -> Cache)
+     .mem_data_data  (mem_data_data),
+     .mem_data_ready (mem_data_ready),
+     //- Memory request (Cache->Memory)
+     .mem_req_addr   (mem_req_addr),  // request byte addr
+     .mem_req_data   (mem_req_data),  // 128-.request data (used when write)
+     .mem_req_rw     (mem_req_rw),    // request type : 0=read, 1=write
+     .mem_req_valid  (mem_req_valid), // request is valid
+     .mem_req_id     (mem_req_id),
+     .mem_req_len    (mem_req_len),
+     //- Cache result (Cache->CPU)
+     .cpu_res_data   (cpu_res_data),  //32-bit data
+     .cpu_res_ready  (cpu_res_ready), //
+     .cpu_res_valid  (cpu_res_valid)  // result is ready
+  );
+
+  assign mem_req_strb = {(MEM_BUS_SZ/8){1'b1}};
+  assign pf_dout      = 'h0;
+  assign st_hit       = 1'b0;
+  assign st_miss      = 1'b0;
+  assign st_merge     = 1'b0;
+  assign st_wb        = 1'b0;
+  assign lat_valid    = 1'b0;
+  assign lat_code     = 'h0;
+  assign lat_cycles   = 'h0;
+
+end else begin : non_blocking
+
+  logic                 cpu_req_ready_c; //- Cache
+  logic                 cpu_req_ready_r; //- Response slots
+  logic [RES_TAG_W-1:0] cpu_req_tag;
+  logic [RES_TAG_W-1:0] cpu_res_tag;
+  logic                 cpu_req_en;
+
+  //- Cache requests, through the write-combining buffer
+  logic                    c_valid;
+  logic                    c_rw;
+  logic   [CPU_BUS_SZ-1:0] c_addr;
+  logic   [CPU_BUS_SZ-1:0] c_data;
+  logic    [RES_TAG_W-1:0] c_tag;
+  logic                    c_line;
+  logic   [MEM_BUS_SZ-1:0] c_ldata;
+  logic [MEM_BUS_SZ/8-1:0] c_lstrb;
+  logic                    c_ready;
+
+  //- Prefetches, sent when the cache has no other request
+  logic                    pf_valid;
+  logic   [CPU_BUS_SZ-1:0] pf_addr;
+  logic                    pf_sel;
+  logic                    pf_fill;
+  logic                    pf_hit;
+  logic                    pf_late;
+  logic                    pf_evict;
+
+  //- MGET, MLOAD and MSTORE get a response
+  assign cpu_req_en    = rvControl[0] & (header1[27:25] == 3'd5 || header1[27:25] == 3'd6 || header1[27:25] == 3'd7);
+  assign cpu_req_ready = cpu_req_ready_c & cpu_req_ready_r;
+  assign mem_req_len   = 'h1;
+
+  if (DDR_WCB > 0) begin : wcb
+
+    mem_mgr_wcb #(
+      .CPU_BUS_SZ (CPU_BUS_SZ),
+      .MEM_BUS_SZ (MEM_BUS_SZ),
+      .LINES      (DDR_WCB),
+      .TIMEOUT    (WCB_TIMEOUT),
+      .TAG_W      (RES_TAG_W)
+    ) mem_mgr_wcb (
+       .clk_ctrl         (clk_mem),
+       .clk_ctrl_rst_low (clk_mem_rst_low),
+       //- Word requests
+       .req_valid        (cpu_req_valid & cpu_req_ready_r),
+       .req_rw           (cpu_req_rw),
+       .req_addr         (cpu_req_addr),
+       .req_data         (cpu_req_data),
+       .req_tag          (cpu_req_tag),
+       .req_fence        (rvControl[0] & header1[27:25] == 3'd7), //- MSTORE
+       .req_ready        (cpu_req_ready_c),
+       //- Cache requests
+       .c_valid          (c_valid),
+       .c_rw             (c_rw),
+       .c_addr           (c_addr),
+       .c_data           (c_data),
+       .c_tag            (c_tag),
+       .c_line           (c_line),
+       .c_ldata          (c_ldata),
+       .c_lstrb          (c_lstrb),
+       .c_ready          (c_ready)
+    );
+
+  end else begin : no_wcb
+
+    assign c_valid         = cpu_req_valid & cpu_req_ready_r;
+    assign c_rw            = cpu_req_rw;
+    assign c_addr          = cpu_req_addr;
+    assign c_data          = cpu_req_data;
+    assign c_tag           = cpu_req_tag;
+    assign c_line          = 1'b0;
+    assign c_ldata         = 'h0;
+    assign c_lstrb         = 'h0;
+    assign cpu_req_ready_c = c_ready;
+
+  end
+
+  if (PF_STREAMS > 0) begin : pf
+
+    mem_mgr_pf #(
+      .CPU_BUS_SZ (CPU_BUS_SZ),
+      .MEM_BUS_SZ (MEM_BUS_SZ),
+      .STREAMS    (PF_STREAMS),
+      .DIST       (PF_DIST),
+      .DEGREE     (PF_DEGREE),
+      .SRC_W      (6),
+      .DRAM_TILES (DRAM_TILES),
+      .DRAM_IL    (DRAM_IL),
+      .CHANNEL    (CHANNEL)
+    ) mem_mgr_pf (
+       .clk_ctrl         (clk_mem),
+       .clk_ctrl_rst_low (clk_mem_rst_low),
+       //- Demand reads
+       .d_valid          (c_valid & c_ready & ~c_rw),
+       .d_addr           (c_addr),
+       .d_src            (header1[23:18]),
+       //- Prefetches
+       .pf_valid         (pf_valid),
+       .pf_addr          (pf_addr),
+       .pf_ready         (~c_valid & c_ready),
+       //- Cache events
+       .ev_fill          (pf_fill),
+       .ev_hit           (pf_hit),
+       .ev_late          (pf_late),
+       .ev_evict         (pf_evict),
+       //- Counters
+       .stat_sel         (stats_sel[2:0]),
+       .stat_dout        (pf_dout)
+    );
+
+  end else begin : no_pf
+
+    assign pf_valid = 1'b0;
+    assign pf_addr  = 'h0;
+    assign pf_dout  = 'h0;
+
+  end
+
+  assign pf_sel = ~c_valid & pf_valid;
+
+  nb_cache #(
+    .CPU_BUS_SZ  (CPU_BUS_SZ),
+    .MEM_BUS_SZ  (MEM_BUS_SZ),
+    .CACHE_LINES (CACHE_LINES),
+    .WAYS        (CACHE_WAYS),
+    .BANKS       (CACHE_BANKS),
+    .DATA_PRIMITIVE (CACHE_PRIM),
+    .MSHRS       (DDR_MSHRS),
+    .TAG_W       (RES_TAG_W),
+    .PREFETCH    (PF_STREAMS > 0),
+    .S_AXI_ID_SZ (S_AXI_ID_SZ)
+  ) nb_cache_inst (
+     .clk             (clk_mem),
+     .rst             (~clk_mem_rst_low),
+     //- CPU request (CPU -> Cache)
+     .cpu_req_addr    (pf_sel ? pf_addr : c_addr),
+     .cpu_req_data    (c_data),
+     .cpu_req_rw      (c_rw & ~pf_sel),
+     .cpu_req_valid   (c_valid | pf_valid),
+     .cpu_req_tag     (pf_sel ? 'h0 : c_tag),
+     .cpu_req_line    (c_line & ~pf_sel),
+     .cpu_req_ldata   (c_ldata),
+     .cpu_req_lstrb   (c_lstrb),
+     .cpu_req_pf      (pf_sel),
+     .cpu_req_ready   (c_ready),
+     //- Cache result (Cache->CPU)
+     .cpu_res_valid   (cpu_res_valid),
+     .cpu_res_data    (cpu_res_data),
+     .cpu_res_tag     (cpu_res_tag),
+     //- Memory request (Cache->Memory)
+     .mem_req_addr    (mem_req_addr),
+     .mem_req_data    (mem_req_data),
+     .mem_req_strb    (mem_req_strb),
+     .mem_req_rw      (mem_req_rw),
+     .mem_req_valid   (mem_req_valid),
+     .mem_req_ready   (mem_req_ready),
+     .mem_req_id      (mem_req_id),
+     //- Memory response (Memory -> Cache)
+     .mem_rdata_valid (mem_rdata_valid),
+     .mem_data_data   (mem_data_data),
+     .mem_data_id     (mem_data_id),
+     .mem_wresp_valid (mem_wresp_valid),
+     //- Prefetch events
+     .pf_fill         (pf_fill),
+     .pf_hit          (pf_hit),
+     .pf_late         (pf_late),
+     .pf_evict        (pf_evict),
+     //- Counter events
+     .st_hit          (st_hit),
+     .st_miss         (st_miss),
+     .st_merge        (st_merge),
+     .st_wb           (st_wb)
+  );
+
+  mem_mgr_resp #(
+    .S_AXI_ID_SZ (S_AXI_ID_SZ),
+    .SLOTS       (RES_SLOTS),
+    .TAG_W       (RES_TAG_W)
+  ) mem_mgr_resp (
+     .clk_ctrl          (clk_mem),
+     .clk_ctrl_rst_low  (clk_mem_rst_low),
+     //- Tile identification
+     .HsrcId            (HsrcId),
+     .stream_out_TVALID (stream_cache_TVALID),
+     .stream_out_TDATA  (stream_cache_TDATA),
+     .stream_out_TKEEP  (stream_cache_TKEEP),
+     .stream_out_TLAST  (stream_cache_TLAST),
+     .stream_out_TREADY (stream_cache_TREADY),
+     //- Word requests
+     .req_valid         (cpu_req_valid & cpu_req_ready),
+     .req_en            (cpu_req_en),
+     .req_id            (cpu_req_id),
+     .req_hdr           (header1),
+     .req_reply         (cpu_req_reply),
+     .req_ready         (cpu_req_ready_r),
+     .req_tag           (cpu_req_tag),
+     //- Cache responses
+     .res_valid         (cpu_res_valid),
+     .res_tag           (cpu_res_tag),
+     .res_data          (cpu_res_data),
+     //- Packet latency
+     .lat_valid         (lat_valid),
+     .lat_code          (lat_code),
+     .lat_cycles        (lat_cycles)
+  );
+
+end
+endgenerate
+
+///////////////////////////////
+// Counters
+///////////////////////////////
+
+always @(posedge clk_mem) begin
+   if (~clk_mem_rst_low) pkt_in <= 1'b0;
+   else if (stream_in_TVALID_int & stream_in_TREADY_int) pkt_in <= ~stream_in_TLAST_int;
+end
+
+generate
+if (DDR_STATS) begin : stats
+
+  mem_mgr_stats #(
+    .SRC_W (6)
+  ) mem_mgr_stats (
+     .clk_ctrl         (clk_mem),
+     .clk_ctrl_rst_low (clk_mem_rst_low),
+     //- Packets, counted at their header
+     .pkt_valid        (stream_in_TVALID_int & stream_in_TREADY_int & ~pkt_in),
+     .pkt_code         (stream_in_TDATA_int[27:25]),
+     .pkt_src          (stream_in_TDATA_int[23:18]),
+     .pkt_bulk         (bulk_cmd_valid & bulk_cmd_ready),
+     //- Word requests
+     .host_word        (~rvControl[0] & cpu_req_valid & cpu_req_ready),
+     .cache_word       (cpu_req_valid & cpu_req_ready),
+     .cache_wait       (cpu_req_valid & ~cpu_req_ready),
+     //- Cache events
+     .ev_hit           (st_hit),
+     .ev_miss          (st_miss),
+     .ev_merge         (st_merge),
+     .ev_wb            (st_wb),
+     //- AXI
+     .axi_ar           (s_axi_arvalid & s_axi_arready),
+     .axi_aw           (s_axi_awvalid & s_axi_awready),
+     .axi_r            (s_axi_rvalid & s_axi_rready),
+     .axi_w            (s_axi_wvalid & s_axi_wready),
+     //- Packet latency
+     .lat_valid        (lat_valid),
+     .lat_code         (lat_code),
+     .lat_cycles       (lat_cycles),
+     //- Counters
+     .stat_sel         (stats_sel),
+     .stat_dout        (st_dout)
+  );
+
+end else begin : no_stats
+
+  assign st_dout = 'h0;
+
+end
+endgenerate
+
+always @(posedge clk_mem) begin
+   if (~clk_mem_rst_low) stats_dout <= 'h0;
+   else stats_dout <= (stats_sel[7:3] == 5'h08) ? pf_dout : st_dout;
+end
+
+///////////////////////////////
+// Non-temporal bursts
+///////////////////////////////
+
+mem_mgr_bulk#(
+   .MEM_BUS_SZ   (MEM_BUS_SZ),
+   .S_AXI_LEN_SZ (S_AXI_LEN_SZ)
+) mem_mgr_bulk (
+   .clk_ctrl          (clk_mem),
+   .clk_ctrl_rst_low  (clk_mem_rst_low),
+   //- Tile identification
+   .HsrcId            (HsrcId),
+   //- Packet from the decoder
+   .cmd_valid         (bulk_cmd_valid),
+   .cmd_rw            (bulk_cmd_rw),
+   .cmd_addr          (bulk_cmd_addr),
+   .cmd_hdr           (header1),
+   .cmd_reply         (data1),
+   .cmd_ready         (bulk_cmd_ready),
+   .wr_valid          (bulk_wr_valid),
+   .wr_data           (bulk_wr_data),
+   .wr_last           (bulk_wr_last),
+   .wr_ready          (bulk_wr_ready),
+   //- Bursts
+   .bulk_req_valid    (bulk_req_valid),
+   .bulk_req_rw       (bulk_req_rw),
+   .bulk_req_addr     (bulk_req_addr),
+   .bulk_req_len      (bulk_req_len),
+   .bulk_req_ready    (bulk_req_ready),
+   .bulk_wvalid       (bulk_wvalid),
+   .bulk_wdata        (bulk_wdata),
+   .bulk_wstrb        (bulk_wstrb),
+   .bulk_wlast        (bulk_wlast),
+   .bulk_wready       (bulk_wready),
+   .bulk_rvalid       (bulk_rvalid),
+   .bulk_rdata        (mem_data_data),
+   //- MPUT response of a MGET
+   .stream_out_TVALID (stream_bulk_TVALID),
+   .stream_out_TDATA  (stream_bulk_TDATA),
+   .stream_out_TKEEP  (stream_bulk_TKEEP),
+   .stream_out_TLAST  (stream_bulk_TLAST),
+   .stream_out_TREADY (stream_bulk_TREADY)
 );
 
 ///////////////////////////////
@@ -364,6 +785,8 @@ dm_cache_fsm #(
 ///////////////////////////////
 
 mem_mgr_axi#(
+   .DRAM_TILES   (DRAM_TILES),
+   .DRAM_IL      (DRAM_IL),
    .S_AXI_ADR_SZ (S_AXI_ADR_SZ)
 ) mem_mgr_axi (
    .clk_ctrl         (clk_mem),
@@ -374,10 +797,27 @@ mem_mgr_axi#(
    //- Memory request (Cache->Memory)
    .mem_req_addr   (mem_req_addr),  // request byte addr
    .mem_req_data   (mem_req_data),  // 128-.request data (used when write)
+   .mem_req_strb   (mem_req_strb),
    .mem_req_rw     (mem_req_rw),    // request type : 0=read, 1=write
    .mem_req_valid  (mem_req_valid), // request is valid
    .mem_req_id     (mem_req_id),
    .mem_req_len    (mem_req_len),
+   .mem_req_ready  (mem_req_ready),
+   .mem_rdata_valid(mem_rdata_valid),
+   .mem_data_id    (mem_data_id),
+   .mem_wresp_valid(mem_wresp_valid),
+   //- Bursts (mem_mgr_bulk)
+   .bulk_req_valid (bulk_req_valid),
+   .bulk_req_rw    (bulk_req_rw),
+   .bulk_req_addr  (bulk_req_addr),
+   .bulk_req_len   (bulk_req_len),
+   .bulk_req_ready (bulk_req_ready),
+   .bulk_wvalid    (bulk_wvalid),
+   .bulk_wdata     (bulk_wdata),
+   .bulk_wstrb     (bulk_wstrb),
+   .bulk_wlast     (bulk_wlast),
+   .bulk_wready    (bulk_wready),
+   .bulk_rvalid    (bulk_rvalid),
   //- MEMORY CONTROLLER
   //- ADDRESS WRITE
    .s_axi_awready  (s_axi_awready),
@@ -426,21 +866,56 @@ mem_mgr_axi#(
 // NOC encoder
 ///////////////////////////////
 
-mem_mgr_noc_encoder mem_mgr_noc_encoder(
-   .clk_ctrl          (clk_mem),
-   .clk_ctrl_rst_low  (clk_mem_rst_low),
-   //- Tile identification
-   .HsrcId            (HsrcId),
-   .header1           (header1),
-   .data1             (data1),
-   .stream_out_TVALID (stream_out_TVALID_int),
-   .stream_out_TDATA  (stream_out_TDATA_int),
-   .stream_out_TKEEP  (stream_out_TKEEP_int),
-   .stream_out_TLAST  (stream_out_TLAST_int),
-   .stream_out_TREADY (stream_out_TREADY_int),
-   .cpu_res_valid     (cpu_res_valid & rvControl[0]),
-   .cpu_res_data      (cpu_res_data),
-   .cpu_res_ready     (cpu_res_ready)
+generate
+if (DDR_MSHRS == 0) begin : encoder
+  mem_mgr_noc_encoder mem_mgr_noc_encoder(
+     .clk_ctrl          (clk_mem),
+     .clk_ctrl_rst_low  (clk_mem_rst_low),
+     //- Tile identification
+     .HsrcId            (HsrcId),
+     .header1           (header1),
+     .data1             (data1),
+     .stream_out_TVALID (stream_cache_TVALID),
+     .stream_out_TDATA  (stream_cache_TDATA),
+     .stream_out_TKEEP  (stream_cache_TKEEP),
+     .stream_out_TLAST  (stream_cache_TLAST),
+     .stream_out_TREADY (stream_cache_TREADY),
+     .cpu_res_valid     (cpu_res_valid & rvControl[0]),
+     .cpu_res_data      (cpu_res_data),
+     .cpu_res_ready     (cpu_res_ready)
+  );
+end
+endgenerate
+
+//- Cache and bulk responses share the output
+noc_out_arbiter noc_out_arbiter(
+   .clk_line              (clk_mem),
+   .clk_line_rst_low      (clk_mem_rst_low),
+   .stream_in_pcpi_TREADY (stream_bulk_TREADY),
+   .stream_in_pcpi_TVALID (stream_bulk_TVALID),
+   .stream_in_pcpi_TDATA  (stream_bulk_TDATA),
+   .stream_in_pcpi_TKEEP  (stream_bulk_TKEEP),
+   .stream_in_pcpi_TLAST  (stream_bulk_TLAST),
+   .stream_in_mem_TREADY  (stream_cache_TREADY),
+   .stream_in_mem_TVALID  (stream_cache_TVALID),
+   .stream_in_mem_TDATA   (stream_cache_TDATA),
+   .stream_in_mem_TKEEP   (stream_cache_TKEEP),
+   .stream_in_mem_TLAST   (stream_cache_TLAST),
+   .stream_in_spy_TREADY  (),
+   .stream_in_spy_TVALID  (1'b0),
+   .stream_in_spy_TDATA   ('h0),
+   .stream_in_spy_TKEEP   ('h0),
+   .stream_in_spy_TLAST   (1'b0),
+   .stream_in_noc_TREADY  (),
+   .stream_in_noc_TVALID  (1'b0),
+   .stream_in_noc_TDATA   ('h0),
+   .stream_in_noc_TKEEP   ('h0),
+   .stream_in_noc_TLAST   (1'b0),
+   .stream_out_TREADY     (stream_out_TREADY_int),
+   .stream_out_TVALID     (stream_out_TVALID_int),
+   .stream_out_TDATA      (stream_out_TDATA_int),
+   .stream_out_TKEEP      (stream_out_TKEEP_int),
+   .stream_out_TLAST      (stream_out_TLAST_int)
 );
 
 //////////////////////////////
@@ -26,11 +26,22 @@
 // Date        : Oct 11 2022
 // Description : AXI signals
 // File        : mem_mgr_axi.sv
+// Notes       :
+//    - Cache requests are single beat transactions. Bulk
+//      requests (mem_mgr_bulk) are INCR bursts of
+//      bulk_req_len+1 beats, the cache goes first.
+//    - The MSB of the AXI id tells the bulk responses from
+//      the cache responses.
+//    - With DRAM_TILES channels the channel bits of the
+//      address (DRAM_IL and up) are taken out, so each
+//      channel sees a dense memory.
 ////////////////////////////////////////////////
 
 `timescale 1 ps/ 1 ps
 
 module mem_mgr_axi#(
+   parameter DRAM_TILES   = 1,   //- Interleaved channels
+   parameter DRAM_IL      = 12,  //- log2 of the interleaving granule (bytes)
    parameter OFFSET_SZ    = 12,
    parameter XY_SZ        =  3,
    parameter MEM_BUS_SZ   = 512,
@@ -94,13 +105,30 @@ module mem_mgr_axi#(
    //- Memory request
    input logic [31:0] mem_req_addr,
    input logic [MEM_BUS_SZ-1:0] mem_req_data,
+   input logic [S_AXI_STB_SZ-1:0] mem_req_strb, //- Bytes of a cache write
    input logic mem_req_rw,
    input logic mem_req_valid,
    input logic [S_AXI_ID_SZ-1:0] mem_req_id,
    input logic [S_AXI_LEN_SZ-1:0] mem_req_len,
+   output logic mem_req_ready,   //- A new request is taken
    //- Memory response
    output logic [MEM_BUS_SZ-1:0] mem_data_data,
-   output logic  mem_data_ready
+   output logic  mem_data_ready,
+   output logic  mem_rdata_valid, //- Read data, with its id
+   output logic [S_AXI_ID_SZ-1:0] mem_data_id,
+   output logic  mem_wresp_valid, //- Write response
+   //- Bulk request (bursts)
+   input  logic                    bulk_req_valid,
+   input  logic                    bulk_req_rw,
+   input  logic             [31:0] bulk_req_addr,
+   input  logic [S_AXI_LEN_SZ-1:0] bulk_req_len,   //- Beats - 1
+   output logic                    bulk_req_ready,
+   input  logic                    bulk_wvalid,
+   input  logic [S_AXI_DAT_SZ-1:0] bulk_wdata,
+   input  logic [S_AXI_STB_SZ-1:0] bulk_wstrb,
+   input  logic                    bulk_wlast,
+   output logic                    bulk_wready,
+   output logic                    bulk_rvalid     //- Read data of a burst (mem_data_data)
 );
 
 /***************************
@@ -119,7 +147,21 @@ localparam    CPU_BUS_SZ = 32;
 
 logic [CPU_BUS_SZ-1:0] mem_req_addr_reg;   // Cache output
 logic [MEM_BUS_SZ-1:0] mem_req_data_reg;   // Cache output
+logic [S_AXI_STB_SZ-1:0] mem_req_strb_reg; // Cache output
 logic                  mem_req_rw_reg;     // Cache output: 0=read, 1=write
+logic [S_AXI_ID_SZ-1:0] mem_req_id_reg;
+logic                  cache_pend;         //- Cache request that came while busy
+logic                  cache_req;
+logic                  cache_rw;
+logic [S_AXI_ID_SZ-1:0] cache_id;
+
+logic                  req_bulk;           //- The transaction is a bulk burst
+logic                  next_req_bulk;
+logic           [31:0] bulk_addr_reg;
+logic           [31:0] next_bulk_addr_reg;
+
+logic           [31:0] axi_addr;           //- Address of the transaction
+logic           [31:0] chan_addr;          //- Address within the channel
 
 logic [2:0] s_axi_state_in;
 logic [2:0] next_s_axi_state_in;
@@ -130,6 +172,7 @@ logic [S_AXI_LEN_SZ-1:0] next_s_axi_awlen;
 logic [S_AXI_ID_SZ-1:0]  next_s_axi_awid;
 logic [S_AXI_SZE_SZ-1:0] next_s_axi_awsize;
 
+logic [S_AXI_STB_SZ-1:0]      s_axi_wstrb_reg;
 logic [S_AXI_STB_SZ-1:0] next_s_axi_wstrb;
 
 logic [S_AXI_LEN_SZ-1:0]      s_axi_awlen_ctr;
@@ -148,14 +191,46 @@ always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
   if (~clk_ctrl_rst_low)begin
     mem_req_addr_reg  <= 'h0;   
     mem_req_data_reg  <= 'h0;   
+    mem_req_strb_reg  <= 'h0;
     mem_req_rw_reg    <= 'h0;   
+    mem_req_id_reg    <= 'h0;
   end else if (mem_req_valid) begin
     mem_req_addr_reg  <= mem_req_addr;   
     mem_req_data_reg  <= mem_req_data;   
+    mem_req_strb_reg  <= mem_req_strb;
     mem_req_rw_reg    <= mem_req_rw;   
+    mem_req_id_reg    <= mem_req_id;
    end
 end
 
+//- The legacy cache does not wait for mem_req_ready: a request
+//- during a burst waits here
+always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
+  if (~clk_ctrl_rst_low)
+    cache_pend <= 1'b0;
+  else if (mem_req_valid & s_axi_state_in != IDLE)
+    cache_pend <= 1'b1;
+  else if (s_axi_state_in == IDLE)
+    cache_pend <= 1'b0;
+end
+
+assign cache_req = mem_req_valid | cache_pend;
+assign cache_rw  = cache_pend ? mem_req_rw_reg : mem_req_rw;
+assign cache_id  = {1'b0, cache_pend ? mem_req_id_reg[S_AXI_ID_SZ-2:0] : mem_req_id[S_AXI_ID_SZ-2:0]};
+
+//- Channel bits out of the address
+localparam CH_W = DRAM_TILES > 1 ? $clog2(DRAM_TILES) : 1;
+
+assign axi_addr = req_bulk ? bulk_addr_reg : mem_req_addr_reg;
+
+generate
+if (DRAM_TILES > 1) begin: g_chan_addr
+   assign chan_addr = {{CH_W{1'b0}}, axi_addr[31:DRAM_IL+CH_W], axi_addr[DRAM_IL-1:0]};
+end else begin: g_one_chan
+   assign chan_addr = axi_addr;
+end
+endgenerate
+
 assign s_axi_awburst = 'h1; //- Burst type: INC. can change.
 assign s_axi_awlock  = 'h0;
 assign s_axi_awcache = 'h0;
@@ -178,7 +253,9 @@ always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
     s_axi_awsize <= 'h0;
     s_axi_awlen_ctr  = 'h0;  
 
-    s_axi_wstrb <= 'h0;
+    s_axi_wstrb_reg <= 'h0;
+    req_bulk <= 1'b0;
+    bulk_addr_reg <= 'h0;
 
     s_axi_arid <= 'h0;
     s_axi_arlen <= 'h0;
@@ -191,7 +268,9 @@ always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
     s_axi_awsize <= next_s_axi_awsize;
     s_axi_awlen_ctr  = next_s_axi_awlen_ctr;
 
-    s_axi_wstrb <= next_s_axi_wstrb;
+    s_axi_wstrb_reg <= next_s_axi_wstrb;
+    req_bulk <= next_req_bulk;
+    bulk_addr_reg <= next_bulk_addr_reg;
 
     s_axi_arid <= next_s_axi_arid;
     s_axi_arlen <= next_s_axi_arlen;
@@ -216,7 +295,9 @@ always @( * ) begin
    next_s_axi_awsize = s_axi_awsize;
    next_s_axi_awlen_ctr = s_axi_awlen_ctr;
 
-   next_s_axi_wstrb = s_axi_wstrb;
+   next_s_axi_wstrb = s_axi_wstrb_reg;
+   next_req_bulk = req_bulk;
+   next_bulk_addr_reg = bulk_addr_reg;
 
    next_s_axi_arid = s_axi_arid;
    next_s_axi_arlen = s_axi_arlen; 
@@ -234,6 +315,8 @@ always @( * ) begin
    s_axi_wvalid = 1'b0;
    s_axi_wlast  = 1'b0;
    s_axi_wdata  = 'h0;
+   bulk_wready  = 1'b0;
+   bulk_req_ready = 1'b0;
 
 
    end_mem_valid_req = 1'b0;
@@ -241,29 +324,45 @@ always @( * ) begin
    case (s_axi_state_in)
       IDLE: begin
         //if (mem_req_valid_reg1) begin
-        if (mem_req_valid) begin
-          if (mem_req_rw) begin
+        next_req_bulk = 1'b0;
+        if (cache_req) begin
+          if (cache_rw) begin
             next_s_axi_awlen  = 'h0; //- Transfers in a write burst
-            next_s_axi_awid   = mem_req_id;        //- Transaction ID
+            next_s_axi_awid   = cache_id;          //- Transaction ID
             next_s_axi_awsize = 'h6;               //- Bytes in a transaction 6->64bytes->512bits
-            next_s_axi_wstrb  = 64'hFFFFFFFFFFFFFFFF;
+            next_s_axi_wstrb  = cache_pend ? mem_req_strb_reg : mem_req_strb;
 
             next_s_axi_awlen_ctr = 'h1;      
             next_s_axi_state_in = WRITE_AW;
           end else begin
             next_s_axi_arlen = 'h0;  //- Transfers in a read burst
-            next_s_axi_arid = mem_req_id;          //- Transaction ID
+            next_s_axi_arid = cache_id;            //- Transaction ID
             next_s_axi_arsize = 'h6;               //- Bytes in a transaction 6->64bytes->512bits
 
             next_s_axi_state_in = READ_AR;
           end
-        end 
+        end else if (bulk_req_valid) begin
+          bulk_req_ready     = 1'b1;
+          next_req_bulk      = 1'b1;
+          next_bulk_addr_reg = bulk_req_addr;
+          if (bulk_req_rw) begin
+            next_s_axi_awlen  = bulk_req_len;
+            next_s_axi_awid   = {1'b1, {(S_AXI_ID_SZ-1){1'b0}}};
+            next_s_axi_awsize = 'h6;
+            next_s_axi_state_in = WRITE_AW;
+          end else begin
+            next_s_axi_arlen  = bulk_req_len;
+            next_s_axi_arid   = {1'b1, {(S_AXI_ID_SZ-1){1'b0}}};
+            next_s_axi_arsize = 'h6;
+            next_s_axi_state_in = READ_AR;
+          end
+        end
      end
      READ_AR: begin //3
         if (s_axi_arready) begin
           s_axi_arvalid = 1'b1;
           end_mem_valid_req = 1'b1;
-          s_axi_araddr  = {2'b00,mem_req_addr_reg};
+          s_axi_araddr  = {2'b00,chan_addr};
           next_s_axi_state_in = IDLE;
         end
       end
@@ -271,12 +370,18 @@ always @( * ) begin
         if (s_axi_awready) begin
           s_axi_awvalid = 1'b1;
           //end_mem_valid_req = 1'b1;
-          s_axi_awaddr  = {2'b00,mem_req_addr_reg};
+          s_axi_awaddr  = {2'b00,chan_addr};
           next_s_axi_state_in = WRITE_W;
         end
       end
       WRITE_W:begin
-         if (s_axi_wready) begin
+         if (req_bulk) begin
+            s_axi_wvalid = bulk_wvalid;
+            s_axi_wlast  = bulk_wlast;
+            s_axi_wdata  = bulk_wdata;
+            bulk_wready  = s_axi_wready;
+            if (bulk_wvalid & s_axi_wready & bulk_wlast) next_s_axi_state_in = IDLE;
+         end else if (s_axi_wready) begin
             s_axi_wvalid        = 1'b1;
             s_axi_wlast         = 1'b1;
             s_axi_wdata         = mem_req_data_reg;
@@ -287,8 +392,15 @@ always @( * ) begin
    endcase
 end
 
+assign s_axi_wstrb = req_bulk ? bulk_wstrb : s_axi_wstrb_reg;
+
 assign mem_data_data = s_axi_rdata;
-assign mem_data_ready = s_axi_rvalid || s_axi_bvalid;
+assign mem_data_ready = (s_axi_rvalid & ~s_axi_rid[S_AXI_ID_SZ-1]) || (s_axi_bvalid & ~s_axi_bid[S_AXI_ID_SZ-1]);
+assign mem_rdata_valid = s_axi_rvalid & ~s_axi_rid[S_AXI_ID_SZ-1];
+assign mem_data_id     = s_axi_rid;
+assign mem_wresp_valid = s_axi_bvalid & ~s_axi_bid[S_AXI_ID_SZ-1];
+assign mem_req_ready   = s_axi_state_in == IDLE & ~cache_pend;
+assign bulk_rvalid     = s_axi_rvalid & s_axi_rid[S_AXI_ID_SZ-1];
 assign s_axi_rready = 1'b1; //FIXME
 
 endmodule
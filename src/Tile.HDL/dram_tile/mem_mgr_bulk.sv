@@ -0,0 +1,317 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+///////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Non-temporal long packets to AXI
+//               bursts
+// File        : mem_mgr_bulk.sv
+// Notes       :
+//    - Long MPUT/MGET packets with the non-temporal bit
+//      (header bit 30) bypass the cache. One packet at a
+//      time.
+//    - The range of the packet is split in INCR bursts of
+//      up to 256 beats that do not cross a 4KB boundary
+//      (64 beats of 512 bits).
+//    - MPUT: words are packed in beats, partial first and
+//      last lines use the write strobes. No response.
+//    - MGET: bursts are requested while their beats fit in
+//      the FIFO_BEATS beat buffer (rready is always high),
+//      the words go back in a long MPUT as the encoder
+//      builds it.
+//    - The cache is not looked up: the program must not
+//      keep the same lines in the cache (no coherence).
+////////////////////////////////////////////////
+
+`timescale 1 ps/ 1 ps
+
+module mem_mgr_bulk#(
+   parameter XY_SZ        =  3,
+   parameter MEM_BUS_SZ   = 512,
+   parameter S_AXI_LEN_SZ =  8,
+   parameter FIFO_BEATS   = 64
+)(
+   input  logic [(XY_SZ*2)-1:0] HsrcId,     //- Tile identification
+   input  logic                 clk_ctrl,
+   input  logic                 clk_ctrl_rst_low,
+   //- Packet from the decoder
+   input  logic                    cmd_valid,
+   input  logic                    cmd_rw,      //- 1: MPUT, 0: MGET
+   input  logic             [31:0] cmd_addr,    //- Byte address
+   input  logic             [31:0] cmd_hdr,
+   input  logic             [31:0] cmd_reply,
+   output logic                    cmd_ready,
+   input  logic                    wr_valid,    //- MPUT words
+   input  logic             [31:0] wr_data,
+   input  logic                    wr_last,
+   output logic                    wr_ready,
+   //- Bursts (mem_mgr_axi)
+   output logic                    bulk_req_valid,
+   output logic                    bulk_req_rw,
+   output logic             [31:0] bulk_req_addr,
+   output logic [S_AXI_LEN_SZ-1:0] bulk_req_len,   //- Beats - 1
+   input  logic                    bulk_req_ready,
+   output logic                    bulk_wvalid,
+   output logic   [MEM_BUS_SZ-1:0] bulk_wdata,
+   output logic [MEM_BUS_SZ/8-1:0] bulk_wstrb,
+   output logic                    bulk_wlast,
+   input  logic                    bulk_wready,
+   input  logic                    bulk_rvalid,
+   input  logic   [MEM_BUS_SZ-1:0] bulk_rdata,
+   //- MPUT response of a MGET
+   output logic                    stream_out_TVALID,
+   output logic             [31:0] stream_out_TDATA,
+   output logic              [3:0] stream_out_TKEEP,
+   output logic                    stream_out_TLAST,
+   input  logic                    stream_out_TREADY
+);
+
+localparam [2:0] MPUT = 3'd4;
+
+localparam LINE_W    = $clog2(MEM_BUS_SZ/8);
+localparam WORDS     = MEM_BUS_SZ/32;
+localparam WORD_W    = $clog2(WORDS);
+localparam LA_W      = 32 - LINE_W;
+localparam MAX_BEATS = (4096/(MEM_BUS_SZ/8)) < (1 << S_AXI_LEN_SZ) ? 4096/(MEM_BUS_SZ/8) : (1 << S_AXI_LEN_SZ);
+localparam BEAT_W    = $clog2(MAX_BEATS+1);
+localparam FIFO_W    = $clog2(FIFO_BEATS);
+
+//- Burst state machine
+localparam [1:0] B_IDLE    = 2'd0;
+localparam [1:0] B_WR_AW   = 2'd1;
+localparam [1:0] B_WR_DATA = 2'd2;
+localparam [1:0] B_RD      = 2'd3;
+
+//- MPUT response state machine
+localparam [1:0] O_IDLE = 2'd0;
+localparam [1:0] O_HDR  = 2'd1;
+localparam [1:0] O_HDR2 = 2'd2;
+localparam [1:0] O_DATA = 2'd3;
+
+logic [1:0] state;
+logic [1:0] next_state;
+logic [1:0] o_state;
+logic [1:0] next_o_state;
+
+logic           [31:0] hdr;
+logic           [31:0] reply;
+logic       [LA_W-1:0] b_line;    //- Next line to request (write: to send)
+logic       [LA_W-1:0] b_last;    //- Last line of the packet
+logic           [16:0] b_words;   //- MPUT words left
+logic     [WORD_W-1:0] b_woff;
+logic     [BEAT_W-1:0] b_beats;   //- Beats of the write burst
+logic     [BEAT_W-1:0] b_beat;
+logic                  rd_more;   //- MGET lines left to request
+
+logic           [16:0] cmd_words;
+logic       [LA_W-1:0] lines_left;
+logic     [BEAT_W-1:0] to_4k;
+logic     [BEAT_W-1:0] burst;
+
+//- MPUT beat
+logic [MEM_BUS_SZ-1:0] w_buf;
+logic [MEM_BUS_SZ/8-1:0] w_strb;
+logic                  w_full;
+logic                  w_take;
+logic                  w_send;
+
+//- MGET beats
+logic [MEM_BUS_SZ-1:0] fifo [0:FIFO_BEATS-1];
+logic       [FIFO_W:0] fifo_cnt;
+logic     [FIFO_W-1:0] fifo_wp;
+logic     [FIFO_W-1:0] fifo_rp;
+logic       [FIFO_W:0] rd_credit; //- Beats requested and not popped
+logic                  ar_take;
+logic                  o_pop;
+logic           [16:0] o_left;
+logic     [WORD_W-1:0] o_woff;
+
+assign cmd_words = 17'h1 << (cmd_rw ? cmd_hdr[11:8] : cmd_hdr[15:12]);
+
+//- Beats of the next burst: up to the end of the packet or the 4KB boundary
+assign lines_left = b_last - b_line + 'h1;
+assign to_4k      = MAX_BEATS - b_line[$clog2(MAX_BEATS)-1:0];
+assign burst      = lines_left < to_4k ? lines_left : to_4k;
+
+assign cmd_ready = state == B_IDLE & o_state == O_IDLE;
+
+always @( * ) begin
+   next_state = state;
+
+   bulk_req_valid = 1'b0;
+   bulk_req_rw    = 1'b0;
+   bulk_req_addr  = {b_line, {LINE_W{1'b0}}};
+   bulk_req_len   = burst - 'h1;
+   ar_take        = 1'b0;
+
+   case (state)
+      B_IDLE: begin
+         if (cmd_valid & cmd_ready)
+            next_state = cmd_rw ? B_WR_AW : B_RD;
+      end
+      B_WR_AW: begin
+         bulk_req_valid = 1'b1;
+         bulk_req_rw    = 1'b1;
+         if (bulk_req_ready) next_state = B_WR_DATA;
+      end
+      B_WR_DATA: begin
+         if (w_send & bulk_wlast)
+            next_state = b_words == 0 ? B_IDLE : B_WR_AW;
+      end
+      B_RD: begin
+         if (rd_more & (rd_credit + burst <= FIFO_BEATS)) begin
+            bulk_req_valid = 1'b1;
+            ar_take        = bulk_req_ready;
+         end
+         if (o_state == O_DATA & o_pop & o_left == 'h1) next_state = B_IDLE;
+      end
+   endcase
+end
+
+//- MPUT words to beats
+assign wr_ready    = state == B_WR_DATA & ~w_full;
+assign w_take      = wr_valid & wr_ready;
+assign bulk_wvalid = state == B_WR_DATA & w_full;
+assign bulk_wdata  = w_buf;
+assign bulk_wstrb  = w_strb;
+assign bulk_wlast  = b_beat == b_beats - 'h1;
+assign w_send      = bulk_wvalid & bulk_wready;
+
+//- MPUT response
+always @( * ) begin
+   next_o_state = o_state;
+   o_pop        = 1'b0;
+
+   stream_out_TVALID = 1'b0;
+   stream_out_TDATA  = 'h0;
+   stream_out_TKEEP  = 'h0;
+   stream_out_TLAST  = 1'b0;
+
+   case (o_state)
+      O_IDLE: begin
+         if (cmd_valid & cmd_ready & ~cmd_rw) next_o_state = O_HDR;
+      end
+      O_HDR: begin
+         stream_out_TVALID = 1'b1;
+         stream_out_TDATA  = {3'b0,1'b1,MPUT,1'b1,HsrcId,6'b000000,hdr[15:12],2'b00,hdr[23:21],hdr[20:18]};
+         stream_out_TKEEP  = 'hF;
+         if (stream_out_TREADY) next_o_state = O_HDR2;
+      end
+      O_HDR2: begin
+         stream_out_TVALID = 1'b1;
+         stream_out_TDATA  = reply;
+         stream_out_TKEEP  = 'hF;
+         if (stream_out_TREADY) next_o_state = O_DATA;
+      end
+      O_DATA: begin
+         if (fifo_cnt != 0) begin
+            stream_out_TVALID = 1'b1;
+            stream_out_TDATA  = fifo[fifo_rp][o_woff*32 +: 32];
+            stream_out_TKEEP  = 'hF;
+            stream_out_TLAST  = o_left == 'h1;
+            if (stream_out_TREADY) begin
+               o_pop = 1'b1;
+               if (o_left == 'h1) next_o_state = O_IDLE;
+            end
+         end
+      end
+   endcase
+end
+
+always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
+   if (~clk_ctrl_rst_low) begin
+      state     <= B_IDLE;
+      o_state   <= O_IDLE;
+      hdr       <= 'h0;
+      reply     <= 'h0;
+      b_line    <= 'h0;
+      b_last    <= 'h0;
+      b_words   <= 'h0;
+      b_woff    <= 'h0;
+      b_beats   <= 'h0;
+      b_beat    <= 'h0;
+      rd_more   <= 1'b0;
+      w_buf     <= 'h0;
+      w_strb    <= 'h0;
+      w_full    <= 1'b0;
+      fifo_cnt  <= 'h0;
+      fifo_wp   <= 'h0;
+      fifo_rp   <= 'h0;
+      rd_credit <= 'h0;
+      o_left    <= 'h0;
+      o_woff    <= 'h0;
+   end else begin
+      state   <= next_state;
+      o_state <= next_o_state;
+
+      if (cmd_valid & cmd_ready) begin
+         hdr     <= cmd_hdr;
+         reply   <= cmd_reply;
+         b_line  <= cmd_addr[31:LINE_W];
+         b_last  <= (cmd_addr + {cmd_words, 2'b00} - 'h1) >> LINE_W;
+         b_words <= cmd_words;
+         b_woff  <= cmd_addr[LINE_W-1:2];
+         rd_more <= ~cmd_rw;
+         o_left  <= cmd_words;
+         o_woff  <= cmd_addr[LINE_W-1:2];
+      end
+
+      //- MPUT
+      if (state == B_WR_AW & bulk_req_ready) begin
+         b_beats <= burst;
+         b_beat  <= 'h0;
+      end
+      if (w_take) begin
+         w_buf[b_woff*32 +: 32] <= wr_data;
+         w_strb[b_woff*4 +: 4]  <= 4'hF;
+         b_woff                 <= b_woff + 'h1;
+         b_words                <= b_words - 'h1;
+         if (b_woff == WORDS-1 | wr_last | b_words == 'h1) w_full <= 1'b1;
+      end
+      if (w_send) begin
+         w_full <= 1'b0;
+         w_strb <= 'h0;
+         b_line <= b_line + 'h1;
+         b_beat <= b_beat + 'h1;
+      end
+
+      //- MGET
+      if (ar_take) begin
+         b_line <= b_line + burst;
+         if (b_line + burst > b_last) rd_more <= 1'b0;
+      end
+      if (bulk_rvalid) begin
+         fifo[fifo_wp] <= bulk_rdata;
+         fifo_wp       <= fifo_wp + 'h1;
+      end
+      if (o_pop) begin
+         o_woff <= o_woff + 'h1;
+         o_left <= o_left - 'h1;
+      end
+      fifo_cnt  <= fifo_cnt + (bulk_rvalid ? 'h1 : 'h0) - ((o_pop & (o_woff == WORDS-1 | o_left == 'h1)) ? 'h1 : 'h0);
+      rd_credit <= rd_credit + (ar_take ? burst : 'h0) - ((o_pop & (o_woff == WORDS-1 | o_left == 'h1)) ? 'h1 : 'h0);
+      if (o_pop & (o_woff == WORDS-1 | o_left == 'h1)) fifo_rp <= fifo_rp + 'h1;
+   end
+end
+
+endmodule
@@ -51,7 +51,18 @@ module mem_mgr_noc_decoder #(
    output logic [31:0]             cpu_req_addr,  //- Cache input
    output logic [S_AXI_ID_SZ-1:0]  cpu_req_id,    //- Cache input
    output logic [S_AXI_LEN_SZ-1:0] cpu_req_len,   //-
+   output logic [31:0]             cpu_req_reply, //- Reply address (long) or data (short) of the packet
    input  logic                    cpu_req_ready, //- Cache output
+   //- Non-temporal long MPUT/MGET (mem_mgr_bulk)
+   input  logic                    bulk_en,
+   output logic                    bulk_cmd_valid,
+   output logic                    bulk_cmd_rw,   //- 1: MPUT, 0: MGET
+   output logic [31:0]             bulk_cmd_addr, //- Byte address
+   input  logic                    bulk_cmd_ready,
+   output logic                    bulk_wr_valid, //- MPUT words
+   output logic [31:0]             bulk_wr_data,
+   output logic                    bulk_wr_last,
+   input  logic                    bulk_wr_ready,
    //- Miscellaneus data
    output logic [31:0]             header1,
    output logic [31:0]             data1
@@ -70,13 +81,16 @@ localparam [2:0] MACK    = 3'd1;  //- This Tile issued a MEM_STORE to a far-away
 localparam [2:0] MDATA   = 3'd2;  //- This Tile issued a LOAD to a far-away-galaxy and is waiting for this MEM_DATA from the far-away-galaxy.
 
 //- NOC Input state machine : state_noc_in
-localparam [2:0] IDLE        = 3'd0;
-localparam [2:0] SECOND_WORD = 3'd2;
-localparam [2:0] THIRD_WORD  = 3'd3;
-localparam [2:0] WRITE       = 3'd4;
-localparam [2:0] IGNORE      = 3'd6;
-localparam [2:0] READ        = 3'd1;
-localparam [2:0] FINISH      = 3'd7;
+localparam [3:0] IDLE        = 4'd0;
+localparam [3:0] SECOND_WORD = 4'd2;
+localparam [3:0] THIRD_WORD  = 4'd3;
+localparam [3:0] WRITE       = 4'd4;
+localparam [3:0] IGNORE      = 4'd6;
+localparam [3:0] READ        = 4'd1;
+localparam [3:0] FINISH      = 4'd7;
+localparam [3:0] BULK_REPLY  = 4'd8;  //- Reply address of a non-temporal MGET
+localparam [3:0] BULK_CMD    = 4'd9;  //- Hands the packet to mem_mgr_bulk
+localparam [3:0] BULK_WR     = 4'd10; //- Words of a non-temporal MPUT
 
 /***************************
 * Connections
@@ -84,8 +98,8 @@ localparam [2:0] FINISH      = 3'd7;
 
 //- state machines
 
-logic [2:0] state_noc_in;
-logic [2:0] next_state_noc_in;
+logic [3:0] state_noc_in;
+logic [3:0] next_state_noc_in;
 
 //- CPU-CACHE interface
 logic [31:0]             cpu_req_addr_reg;    //- Cache input
@@ -100,6 +114,8 @@ logic [2:0] noc_code;
 
 assign noc_code = header1[27:25];
 assign hl       = header1[28];
+assign xa       = header1[29]; //- Extended address: second word is a 32-bit word address
+assign nt       = header1[30]; //- Non-temporal: long MPUT/MGET bypass the cache
 
 assign noc_inst_put   = noc_code == MPUT;
 assign noc_inst_get   = noc_code == MGET;
@@ -152,6 +168,13 @@ always @( * ) begin
    cpu_req_addr  = 'h0;
    cpu_req_len  = 'h0;
 
+   bulk_cmd_valid = 1'b0;
+   bulk_cmd_rw    = noc_inst_put;
+   bulk_cmd_addr  = cpu_req_addr_reg;
+   bulk_wr_valid  = 1'b0;
+   bulk_wr_data   = stream_in_TDATA;
+   bulk_wr_last   = stream_in_TLAST;
+
 
    case (state_noc_in)
       IDLE: begin //0
@@ -163,10 +186,13 @@ always @( * ) begin
          end
       end
       SECOND_WORD: begin //Second header (long packet) or data (short packet)
-         if (stream_in_TVALID) begin
+         if (stream_in_TVALID & cpu_req_ready) begin
             if (hl) begin //- Long packet
-               next_cpu_req_addr = stream_in_TDATA;
-               if (noc_inst_store || noc_inst_put) begin
+               if (xa) next_cpu_req_addr = {stream_in_TDATA[29:0],2'b00};
+               else    next_cpu_req_addr = stream_in_TDATA;
+               if (nt & bulk_en & (noc_inst_put || noc_inst_get)) begin
+                  next_state_noc_in = noc_inst_put ? BULK_CMD : BULK_REPLY;
+               end else if (noc_inst_store || noc_inst_put) begin
                   cpu_req_len       = 'h1 << header1[11:8];
                   next_cpu_req_ctr  = 'h1 << header1[11:8];
                   next_state_noc_in = WRITE;
@@ -191,7 +217,7 @@ always @( * ) begin
          end
       end
       THIRD_WORD: begin // only long packets for qGet/MLOAD (Third and fourth)
-         if (stream_in_TVALID) begin
+         if (stream_in_TVALID & cpu_req_ready) begin
             if (stream_in_TLAST)
                next_state_noc_in = READ;
             else begin
@@ -204,6 +230,20 @@ always @( * ) begin
             end
          end
       end
+      BULK_REPLY: begin //8
+         if (stream_in_TVALID & cpu_req_ready) begin
+            next_data1 = stream_in_TDATA;
+            next_state_noc_in = stream_in_TLAST ? IDLE : BULK_CMD;
+         end
+      end
+      BULK_CMD: begin //9
+         bulk_cmd_valid = 1'b1;
+         if (bulk_cmd_ready) next_state_noc_in = noc_inst_put ? BULK_WR : IGNORE;
+      end
+      BULK_WR: begin //10
+         bulk_wr_valid = stream_in_TVALID;
+         if (stream_in_TVALID & bulk_wr_ready & stream_in_TLAST) next_state_noc_in = IDLE;
+      end
       IGNORE: begin //6
          if (stream_in_TVALID) begin
             if (stream_in_TLAST) next_state_noc_in = IDLE;
@@ -248,7 +288,10 @@ always @( * ) begin
    endcase
 end
 
-assign stream_in_TREADY = cpu_req_ready & state_noc_in != READ;
+assign stream_in_TREADY = state_noc_in == BULK_WR ? bulk_wr_ready :
+                          cpu_req_ready & state_noc_in != READ & state_noc_in != BULK_CMD;
+
+assign cpu_req_reply = next_data1;
 
 
 
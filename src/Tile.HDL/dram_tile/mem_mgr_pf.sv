@@ -0,0 +1,231 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+///////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Stride prefetcher of the DRAM tile cache
+// File        : mem_mgr_pf.sv
+// Notes       :
+//    - Watches the demand reads (d_*) and keeps up to
+//      STREAMS streams. A stream belongs to a requester
+//      (the source of the packet) and follows its reads
+//      within WINDOW lines, so one tile can run several.
+//    - The same line stride seen twice locks the stream.
+//      A locked stream keeps DEGREE line prefetches in
+//      flight from DIST strides ahead of its last read.
+//      Any other stride unlocks it.
+//    - Prefetches are line reads for nb_cache, sent when
+//      there is no demand request. Lines of another
+//      channel are skipped.
+//    - Counters, read by stat_sel: 0 prefetches sent,
+//      1 lines filled, 2 filled lines then hit, 3 lines
+//      still in flight when read (late), 4 filled lines
+//      replaced unused.
+////////////////////////////////////////////////
+
+`timescale 1 ps/ 1 ps
+
+module mem_mgr_pf#(
+   parameter CPU_BUS_SZ = 32,
+   parameter MEM_BUS_SZ = 512,
+   parameter STREAMS    = 4,
+   parameter DIST       = 4,   //- Lines ahead of the last read
+   parameter DEGREE     = 2,   //- Lines in flight per stream
+   parameter SRC_W      = 6,
+   parameter DRAM_TILES = 1,
+   parameter DRAM_IL    = 12,
+   parameter CHANNEL    = 0
+)(
+   input  logic                  clk_ctrl,
+   input  logic                  clk_ctrl_rst_low,
+   //- Demand reads
+   input  logic                  d_valid,
+   input  logic [CPU_BUS_SZ-1:0] d_addr,
+   input  logic      [SRC_W-1:0] d_src,
+   //- Prefetches (nb_cache)
+   output logic                  pf_valid,
+   output logic [CPU_BUS_SZ-1:0] pf_addr,
+   input  logic                  pf_ready,
+   //- Cache events
+   input  logic                  ev_fill,
+   input  logic                  ev_hit,
+   input  logic                  ev_late,
+   input  logic                  ev_evict,
+   //- Counters
+   input  logic            [2:0] stat_sel,
+   output logic           [31:0] stat_dout
+);
+
+localparam LINE_W = $clog2(MEM_BUS_SZ/8);
+localparam LA_W   = CPU_BUS_SZ - LINE_W;
+localparam ST_W   = 5;                       //- Stride in lines, signed
+localparam WINDOW = 2**(ST_W-1) - 1;
+localparam E_W    = STREAMS > 1 ? $clog2(STREAMS) : 1;
+localparam AGE_W  = E_W + 1;
+localparam N_W    = $clog2(DIST+DEGREE+1);
+localparam CH_W   = DRAM_TILES > 1 ? $clog2(DRAM_TILES) : 1;
+
+//- Streams
+logic                  s_valid  [0:STREAMS-1];
+logic      [SRC_W-1:0] s_src    [0:STREAMS-1];
+logic       [LA_W-1:0] s_line   [0:STREAMS-1]; //- Last read
+logic       [ST_W-1:0] s_stride [0:STREAMS-1];
+logic                  s_lock   [0:STREAMS-1];
+logic       [LA_W-1:0] s_pf     [0:STREAMS-1]; //- Next line to prefetch
+logic        [N_W-1:0] s_pf_n   [0:STREAMS-1]; //- Strides from s_line to s_pf
+logic      [AGE_W-1:0] s_age    [0:STREAMS-1];
+
+logic       [LA_W-1:0] d_line;
+logic       [LA_W-1:0] delta    [0:STREAMS-1];
+logic       [LA_W-1:0] stride   [0:STREAMS-1]; //- s_stride, sign extended
+logic      [STREAMS-1:0] near;
+logic      [STREAMS-1:0] on;    //- The read follows the stride
+logic                  u_any;
+logic        [E_W-1:0] u_e;     //- Stream of the read
+logic        [E_W-1:0] v_e;     //- Stream to replace
+logic       [LA_W-1:0] start;   //- First prefetch of a (re)started stream
+
+logic                  p_any;
+logic        [E_W-1:0] p_e;
+logic                  p_in;    //- Line of this channel
+logic                  p_step;
+
+logic           [31:0] cnt [0:4];
+
+assign d_line = d_addr[CPU_BUS_SZ-1:LINE_W];
+
+//- Stream of the read: on its stride first, then near its last read
+always @( * ) begin
+   u_any = 1'b0;
+   u_e   = 'h0;
+   v_e   = 'h0;
+   for (int e=STREAMS-1; e>=0; e=e-1) begin
+      stride[e] = {{(LA_W-ST_W){s_stride[e][ST_W-1]}}, s_stride[e]};
+      delta[e]  = d_line - s_line[e];
+      near[e]   = s_valid[e] & s_src[e] == d_src &
+                  ($signed(delta[e]) <= WINDOW) & ($signed(delta[e]) >= -WINDOW);
+      on[e]     = near[e] & s_stride[e] != 0 & delta[e] == stride[e];
+      if (near[e]) begin
+         u_any = 1'b1;
+         u_e   = e;
+      end
+   end
+   for (int e=STREAMS-1; e>=0; e=e-1)
+      if (on[e]) u_e = e;
+   for (int e=0; e<STREAMS; e=e+1)
+      if (s_age[e] >= s_age[v_e]) v_e = e;
+   for (int e=STREAMS-1; e>=0; e=e-1)
+      if (~s_valid[e]) v_e = e;
+end
+
+assign start = d_line + stride[u_e]*DIST;
+
+//- Prefetch: first stream with lines to send
+always @( * ) begin
+   p_any = 1'b0;
+   p_e   = 'h0;
+   for (int e=STREAMS-1; e>=0; e=e-1)
+      if (s_valid[e] & s_lock[e] & s_pf_n[e] < DIST+DEGREE) begin
+         p_any = 1'b1;
+         p_e   = e;
+      end
+end
+
+generate
+if (DRAM_TILES > 1) begin: g_p_in
+   assign p_in = pf_addr[DRAM_IL +: CH_W] == CHANNEL;
+end else begin: g_p_all
+   assign p_in = 1'b1;
+end
+endgenerate
+
+assign pf_addr  = {s_pf[p_e], {LINE_W{1'b0}}};
+assign pf_valid = p_any & p_in;
+assign p_step   = p_any & (~p_in | pf_ready);
+
+always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
+  if (~clk_ctrl_rst_low) begin
+    for (int e=0; e<STREAMS; e=e+1) begin
+      s_valid[e]  <= 1'b0;
+      s_src[e]    <= 'h0;
+      s_line[e]   <= 'h0;
+      s_stride[e] <= 'h0;
+      s_lock[e]   <= 1'b0;
+      s_pf[e]     <= 'h0;
+      s_pf_n[e]   <= 'h0;
+      s_age[e]    <= 'h0;
+    end
+  end else begin
+    if (p_step) begin
+      s_pf[p_e]   <= s_pf[p_e] + stride[p_e];
+      s_pf_n[p_e] <= s_pf_n[p_e] + 'h1;
+    end
+
+    if (d_valid) begin
+      for (int e=0; e<STREAMS; e=e+1)
+        if (~(&s_age[e])) s_age[e] <= s_age[e] + 'h1;
+
+      if (u_any) begin
+        s_age[u_e] <= 'h0;
+        if (on[u_e]) begin
+          //- One stride further: restart if the prefetches fell behind
+          s_line[u_e] <= d_line;
+          s_lock[u_e] <= 1'b1;
+          if (~s_lock[u_e] | s_pf_n[u_e] + (p_step & p_e == u_e) <= DIST) begin
+            s_pf[u_e]   <= start;
+            s_pf_n[u_e] <= DIST;
+          end else
+            s_pf_n[u_e] <= s_pf_n[u_e] + (p_step & p_e == u_e) - 'h1;
+        end else if (delta[u_e] != 0) begin
+          s_line[u_e]   <= d_line;
+          s_stride[u_e] <= delta[u_e][ST_W-1:0];
+          s_lock[u_e]   <= 1'b0;
+        end
+      end else begin
+        s_valid[v_e]  <= 1'b1;
+        s_src[v_e]    <= d_src;
+        s_line[v_e]   <= d_line;
+        s_stride[v_e] <= 'h0;
+        s_lock[v_e]   <= 1'b0;
+        s_age[v_e]    <= 'h0;
+      end
+    end
+  end
+end
+
+//- Counters
+always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
+  if (~clk_ctrl_rst_low) begin
+    for (int i=0; i<5; i=i+1)
+      cnt[i] <= 'h0;
+  end else begin
+    if (pf_valid & pf_ready) cnt[0] <= cnt[0] + 'h1;
+    if (ev_fill)             cnt[1] <= cnt[1] + 'h1;
+    if (ev_hit)              cnt[2] <= cnt[2] + 'h1;
+    if (ev_late)             cnt[3] <= cnt[3] + 'h1;
+    if (ev_evict)            cnt[4] <= cnt[4] + 'h1;
+  end
+end
+
+assign stat_dout = stat_sel < 5 ? cnt[stat_sel] : 'h0;
+
+endmodule
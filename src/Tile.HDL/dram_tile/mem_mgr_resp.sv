@@ -0,0 +1,321 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+///////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Forms the NoC responses of the
+//               non-blocking cache
+// File        : mem_mgr_resp.sv
+// Notes       :
+//    - Replaces mem_mgr_noc_encoder with nb_cache. Same
+//      response packets.
+//    - Each MGET/MLOAD/MSTORE packet takes a slot when its
+//      first word request goes to the cache. The request
+//      tag (req_tag) carries the slot and the word, the
+//      cache responses fill the slot in any order.
+//    - A slot is sent when all its words are back, so the
+//      responses of different packets leave in completion
+//      order. Packets longer than 16 words are sent once
+//      16 words are back, the rest is streamed.
+//    - A long MSTORE gets a single MACK when all its words
+//      are written.
+//    - lat_* gives the cycles of each packet, from its
+//      first word request to the last flit of its response.
+////////////////////////////////////////////////
+
+`timescale 1 ps/ 1 ps
+
+module mem_mgr_resp#(
+   parameter XY_SZ       =  3,
+   parameter OFFSET_SZ   = 12,
+   parameter S_AXI_ID_SZ = 11,
+   parameter SLOTS       =  8,
+   parameter TAG_W       =  8   //- 1 + $clog2(SLOTS) + 4
+)(
+   input  logic [(XY_SZ*2)-1:0] HsrcId,     //- Tile identification
+   input  logic                 clk_ctrl,
+   input  logic                 clk_ctrl_rst_low,
+   output logic                 stream_out_TVALID,
+   output logic          [31:0] stream_out_TDATA,
+   output logic           [3:0] stream_out_TKEEP,
+   output logic                 stream_out_TLAST,
+   input  logic                 stream_out_TREADY,
+   //- Word requests to the cache
+   input  logic                   req_valid,
+   input  logic                   req_en,     //- The packet of the request gets a response
+   input  logic [S_AXI_ID_SZ-1:0] req_id,
+   input  logic            [31:0] req_hdr,
+   input  logic            [31:0] req_reply,
+   output logic                   req_ready,
+   output logic       [TAG_W-1:0] req_tag,
+   //- Cache responses
+   input  logic                   res_valid,
+   input  logic       [TAG_W-1:0] res_tag,
+   input  logic            [31:0] res_data,
+   //- Packet latency
+   output logic                   lat_valid,
+   output logic             [2:0] lat_code,
+   output logic            [15:0] lat_cycles
+);
+
+/***************************
+* Local parameters for FSMs
+****************************/
+
+//- NOC Instruction decoder
+localparam [2:0] MPUT    = 3'd4;
+localparam [2:0] MGET    = 3'd5;
+localparam [2:0] MLOAD   = 3'd6;
+localparam [2:0] MSTORE  = 3'd7;
+localparam [2:0] MACK    = 3'd1;
+localparam [2:0] MDATA   = 3'd2;
+
+//- NOC Output state machine
+localparam [1:0] O_IDLE = 2'd0;
+localparam [1:0] O_HDR2 = 2'd1;
+localparam [1:0] O_DATA = 2'd2;
+
+localparam SLOT_W = $clog2(SLOTS);
+
+//- Slots
+logic      [SLOTS-1:0] s_busy;
+logic      [SLOTS-1:0] s_rd;
+logic           [31:0] s_hdr   [0:SLOTS-1];
+logic           [31:0] s_reply [0:SLOTS-1];
+logic           [15:0] s_nw    [0:SLOTS-1]; //- Words of the packet
+logic           [15:0] s_done  [0:SLOTS-1]; //- Words back from the cache
+logic           [15:0] s_sent  [0:SLOTS-1]; //- Words sent
+logic           [31:0] s_buf   [0:SLOTS*16-1];
+logic   [SLOTS*16-1:0] s_rdy;
+logic           [15:0] s_t0    [0:SLOTS-1]; //- Cycle of the first request
+logic           [15:0] t_now;
+
+//- Packet being requested
+logic                   cur_active;
+logic [S_AXI_ID_SZ-1:0] cur_id;
+logic      [SLOT_W-1:0] cur_slot;
+logic            [15:0] cur_idx;
+
+logic                   new_pkt;
+logic                   free_any;
+logic      [SLOT_W-1:0] free_s;
+logic                   req_rd;
+logic            [15:0] req_nw;
+logic                   req_take;
+
+logic                   res_en;
+logic      [SLOT_W-1:0] res_s;
+logic             [3:0] res_w;
+
+//- Output
+logic             [1:0] o_state;
+logic             [1:0] next_o_state;
+logic      [SLOT_W-1:0] o_slot;
+logic      [SLOT_W-1:0] next_o_slot;
+logic                   e_any;
+logic      [SLOT_W-1:0] e_s;
+logic      [SLOT_W-1:0] h_s;
+logic             [3:0] o_w;
+logic                   o_send;
+logic                   o_free;
+
+logic           [2:0] noc_out_code;
+logic          [31:0] noc_out_header;
+logic                 noc_out_pt;
+logic [OFFSET_SZ-1:0] noc_out_offset;
+logic     [XY_SZ-1:0] noc_out_x_dest;
+logic     [XY_SZ-1:0] noc_out_y_dest;
+logic                 noc_out_hl;
+logic           [2:0] h_code;
+
+//- Requests
+always @( * ) begin
+   free_any = 1'b0;
+   free_s   = 'h0;
+   for (int s=SLOTS-1; s>=0; s=s-1)
+      if (~s_busy[s]) begin
+         free_any = 1'b1;
+         free_s   = s;
+      end
+end
+
+assign new_pkt = ~(cur_active & req_id == cur_id);
+assign req_rd  = req_hdr[27:25] == MGET || req_hdr[27:25] == MLOAD;
+assign req_nw  = ~req_hdr[28] ? 'h1 :
+                 req_rd       ? 'h1 << req_hdr[15:12] : 'h1 << req_hdr[11:8];
+
+assign req_ready = ~req_en | (new_pkt ? free_any : (cur_idx - s_sent[cur_slot]) < 16);
+assign req_tag   = {req_en, new_pkt ? free_s : cur_slot, new_pkt ? 4'h0 : cur_idx[3:0]};
+assign req_take  = req_valid & req_en;
+
+assign {res_en, res_s, res_w} = res_tag;
+
+//- Output
+always @( * ) begin
+   e_any = 1'b0;
+   e_s   = 'h0;
+   for (int s=SLOTS-1; s>=0; s=s-1)
+      if (s_busy[s] & (s_done[s] == s_nw[s] | (s_rd[s] & s_done[s] >= 16))) begin
+         e_any = 1'b1;
+         e_s   = s;
+      end
+end
+
+assign h_s = o_state == O_IDLE ? e_s : o_slot;
+assign o_w = s_sent[o_slot][3:0];
+
+always @( * ) begin
+   next_o_state = o_state;
+   next_o_slot  = o_slot;
+   o_send       = 1'b0;
+   o_free       = 1'b0;
+
+   stream_out_TVALID = 1'b0;
+   stream_out_TDATA  =  'h0;
+   stream_out_TKEEP  =  'h0;
+   stream_out_TLAST  = 1'b0;
+
+   case (o_state)
+      O_IDLE: begin
+         if (e_any) begin
+            stream_out_TVALID = 1'b1;
+            stream_out_TDATA  = noc_out_header;
+            stream_out_TKEEP  = 'hF;
+            if (stream_out_TREADY) begin
+               next_o_slot  = e_s;
+               next_o_state = (s_hdr[e_s][28] & s_rd[e_s]) ? O_HDR2 : O_DATA;
+            end
+         end
+      end
+      O_HDR2: begin
+         stream_out_TVALID = 1'b1;
+         stream_out_TDATA  = s_reply[o_slot];
+         stream_out_TKEEP  = 'hF;
+         if (stream_out_TREADY) next_o_state = O_DATA;
+      end
+      O_DATA: begin
+         if (~s_rd[o_slot]) begin //- MACK
+            stream_out_TVALID = 1'b1;
+            stream_out_TKEEP  = 'hF;
+            stream_out_TLAST  = 1'b1;
+            if (stream_out_TREADY) begin
+               o_free       = 1'b1;
+               next_o_state = O_IDLE;
+            end
+         end else if (s_rdy[o_slot*16+o_w]) begin
+            stream_out_TVALID = 1'b1;
+            stream_out_TDATA  = s_buf[o_slot*16+o_w];
+            stream_out_TKEEP  = 'hF;
+            stream_out_TLAST  = s_sent[o_slot] + 'h1 == s_nw[o_slot];
+            if (stream_out_TREADY) begin
+               o_send = 1'b1;
+               if (stream_out_TLAST) begin
+                  o_free       = 1'b1;
+                  next_o_state = O_IDLE;
+               end
+            end
+         end
+      end
+      default: next_o_state = O_IDLE;
+   endcase
+end
+
+always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
+   if (~clk_ctrl_rst_low) begin
+      o_state    <= O_IDLE;
+      o_slot     <= 'h0;
+      s_busy     <= 'h0;
+      s_rd       <= 'h0;
+      s_rdy      <= 'h0;
+      cur_active <= 1'b0;
+      cur_id     <= 'h0;
+      cur_slot   <= 'h0;
+      cur_idx    <= 'h0;
+      t_now      <= 'h0;
+   end else begin
+      t_now   <= t_now + 'h1;
+      o_state <= next_o_state;
+      o_slot  <= next_o_slot;
+
+      //- Requests
+      if (req_take) begin
+         if (new_pkt) begin
+            s_busy[free_s]  <= 1'b1;
+            s_rd[free_s]    <= req_rd;
+            s_hdr[free_s]   <= req_hdr;
+            s_reply[free_s] <= req_reply;
+            s_nw[free_s]    <= req_nw;
+            s_done[free_s]  <= 'h0;
+            s_sent[free_s]  <= 'h0;
+            s_t0[free_s]    <= t_now;
+            cur_active      <= req_nw != 'h1;
+            cur_id          <= req_id;
+            cur_slot        <= free_s;
+            cur_idx         <= 'h1;
+         end else begin
+            cur_idx <= cur_idx + 'h1;
+            if (cur_idx + 'h1 == s_nw[cur_slot]) cur_active <= 1'b0;
+         end
+      end
+
+      //- Cache responses
+      if (res_valid & res_en) begin
+         s_done[res_s] <= s_done[res_s] + 'h1;
+         if (s_rd[res_s]) begin
+            s_buf[res_s*16+res_w] <= res_data;
+            s_rdy[res_s*16+res_w] <= 1'b1;
+         end
+      end
+
+      //- Output
+      if (o_send) begin
+         s_rdy[o_slot*16+o_w] <= 1'b0;
+         s_sent[o_slot]       <= s_sent[o_slot] + 'h1;
+      end
+      if (o_free) s_busy[o_slot] <= 1'b0;
+   end
+end
+
+assign lat_valid  = o_free;
+assign lat_code   = s_hdr[o_slot][27:25];
+assign lat_cycles = t_now - s_t0[o_slot];
+
+assign h_code     = s_hdr[h_s][27:25];
+assign noc_out_pt = 1;
+
+assign noc_out_hl = h_code == MGET ? s_hdr[h_s][28] : 1'b0;
+
+assign noc_out_code = h_code == MSTORE ? MACK  :
+                      h_code == MLOAD  ? MDATA :
+                      h_code == MGET   ? MPUT  : 'h0;
+
+assign noc_out_offset = h_code == MSTORE ? 'h0 :
+                        h_code == MLOAD  ? s_reply[h_s][OFFSET_SZ-1:0] :
+                        h_code == MGET   ?
+                        s_hdr[h_s][28] ? {6'b000000,s_hdr[h_s][15:12],2'b00} : s_reply[h_s][OFFSET_SZ-1:0] : 'h0;
+
+assign noc_out_x_dest = s_hdr[h_s][20:18];
+assign noc_out_y_dest = s_hdr[h_s][23:21];
+assign noc_out_header = {3'b0,noc_out_hl,noc_out_code,noc_out_pt,HsrcId,noc_out_offset,noc_out_y_dest,noc_out_x_dest};
+
+endmodule
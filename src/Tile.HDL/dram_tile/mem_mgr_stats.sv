@@ -0,0 +1,144 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+///////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Performance counters of the DRAM tile
+// File        : mem_mgr_stats.sv
+// Notes       :
+//    - 32-bit counters read by stat_sel (OP_STATS address
+//      of the tile), cleared by reset only:
+//        8'h00       clk_memory cycles
+//        8'h01-8'h04 MPUT, MGET, MLOAD, MSTORE packets
+//        8'h05       non-temporal packets (also in 01-04)
+//        8'h06       host words (AXI image writes)
+//        8'h07       word requests to the cache
+//        8'h08       cycles a request waits for the cache
+//        8'h09-8'h0C hits, misses, secondary misses and
+//                    write-backs (non-blocking cache)
+//        8'h0D-8'h10 AXI reads, writes, read beats and
+//                    write beats
+//        8'h80-8'hAF log2 latency histograms of MGET, MLOAD
+//                    and MSTORE packets, 16 bins each. Bin
+//                    i counts 2^i to 2^(i+1)-1 cycles (bin 0
+//                    from 0)
+//        8'hC0-8'hFF packets by source, {y,x}
+//    - Other addresses read 0.
+////////////////////////////////////////////////
+
+`timescale 1 ps/ 1 ps
+
+module mem_mgr_stats#(
+   parameter SRC_W = 6
+)(
+   input  logic             clk_ctrl,
+   input  logic             clk_ctrl_rst_low,
+   //- Packets
+   input  logic             pkt_valid,
+   input  logic       [2:0] pkt_code,
+   input  logic [SRC_W-1:0] pkt_src,
+   input  logic             pkt_bulk,   //- Non-temporal packet started
+   //- Word requests
+   input  logic             host_word,
+   input  logic             cache_word,
+   input  logic             cache_wait,
+   //- Cache events
+   input  logic             ev_hit,
+   input  logic             ev_miss,
+   input  logic             ev_merge,
+   input  logic             ev_wb,
+   //- AXI
+   input  logic             axi_ar,
+   input  logic             axi_aw,
+   input  logic             axi_r,
+   input  logic             axi_w,
+   //- Packet latency
+   input  logic             lat_valid,
+   input  logic       [2:0] lat_code,
+   input  logic      [15:0] lat_cycles,
+   //- Counters
+   input  logic       [7:0] stat_sel,
+   output logic      [31:0] stat_dout
+);
+
+//- NOC Instruction decoder
+localparam [2:0] MPUT    = 3'd4;
+localparam [2:0] MGET    = 3'd5;
+localparam [2:0] MLOAD   = 3'd6;
+localparam [2:0] MSTORE  = 3'd7;
+
+localparam CNT     = 17;
+localparam CLASSES = 3;      //- MGET, MLOAD, MSTORE
+localparam SRCS    = 2**SRC_W;
+
+logic [31:0] cnt  [0:CNT-1];
+logic [31:0] hist [0:CLASSES*16-1];
+logic [31:0] src  [0:SRCS-1];
+
+logic  [3:0] lat_bin;
+logic        lat_en;
+
+//- Bin: most significant bit of the latency
+always @( * ) begin
+   lat_bin = 'h0;
+   for (int i=1; i<16; i=i+1)
+      if (lat_cycles[i]) lat_bin = i;
+end
+
+assign lat_en = lat_valid & (lat_code == MGET || lat_code == MLOAD || lat_code == MSTORE);
+
+always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
+  if (~clk_ctrl_rst_low) begin
+    for (int i=0; i<CNT; i=i+1)
+      cnt[i] <= 'h0;
+    for (int i=0; i<CLASSES*16; i=i+1)
+      hist[i] <= 'h0;
+    for (int i=0; i<SRCS; i=i+1)
+      src[i] <= 'h0;
+  end else begin
+    cnt[0] <= cnt[0] + 'h1;
+    if (pkt_valid) begin
+      if (pkt_code >= MPUT) cnt[pkt_code-MPUT+1] <= cnt[pkt_code-MPUT+1] + 'h1;
+      src[pkt_src] <= src[pkt_src] + 'h1;
+    end
+    if (pkt_bulk)   cnt[5]  <= cnt[5]  + 'h1;
+    if (host_word)  cnt[6]  <= cnt[6]  + 'h1;
+    if (cache_word) cnt[7]  <= cnt[7]  + 'h1;
+    if (cache_wait) cnt[8]  <= cnt[8]  + 'h1;
+    if (ev_hit)     cnt[9]  <= cnt[9]  + 'h1;
+    if (ev_miss)    cnt[10] <= cnt[10] + 'h1;
+    if (ev_merge)   cnt[11] <= cnt[11] + 'h1;
+    if (ev_wb)      cnt[12] <= cnt[12] + 'h1;
+    if (axi_ar)     cnt[13] <= cnt[13] + 'h1;
+    if (axi_aw)     cnt[14] <= cnt[14] + 'h1;
+    if (axi_r)      cnt[15] <= cnt[15] + 'h1;
+    if (axi_w)      cnt[16] <= cnt[16] + 'h1;
+
+    if (lat_en) hist[(lat_code-MGET)*16+lat_bin] <= hist[(lat_code-MGET)*16+lat_bin] + 'h1;
+  end
+end
+
+assign stat_dout = stat_sel < CNT                                ? cnt[stat_sel] :
+                   stat_sel[7:6] == 2'b10 & stat_sel[5:4] != 2'b11 ? hist[stat_sel[5:0]] :
+                   stat_sel[7:6] == 2'b11 & stat_sel[5:0] < SRCS   ? src[stat_sel[5:0]] : 'h0;
+
+endmodule
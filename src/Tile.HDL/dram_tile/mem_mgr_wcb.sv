@@ -0,0 +1,211 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+///////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Write-combining buffer in front of
+//               the DRAM tile cache
+// File        : mem_mgr_wcb.sv
+// Notes       :
+//    - Word writes are merged in LINES line buffers and
+//      go to nb_cache as one line write with byte strobes:
+//      a hit is a single line update, a miss is written
+//      to memory under the strobes, without a line read.
+//    - A line is flushed when all its words are written,
+//      TIMEOUT cycles after its first write, before a read
+//      of the line (conflict) and when a write to a new
+//      line finds no free buffer (oldest first).
+//    - A fence write (MSTORE) waits until every line is
+//      flushed, so its MACK covers the writes before it.
+//    - Reads and fences go straight to the cache. Line
+//      writes carry tag 0: nobody waits for them.
+////////////////////////////////////////////////
+
+`timescale 1 ps/ 1 ps
+
+module mem_mgr_wcb#(
+   parameter CPU_BUS_SZ = 32,
+   parameter MEM_BUS_SZ = 512,
+   parameter LINES      = 2,
+   parameter TIMEOUT    = 64,
+   parameter TAG_W      = 8
+)(
+   input  logic                    clk_ctrl,
+   input  logic                    clk_ctrl_rst_low,
+   //- Word requests
+   input  logic                    req_valid,
+   input  logic                    req_rw,      //- 0: read, 1: write
+   input  logic   [CPU_BUS_SZ-1:0] req_addr,    //- Byte address
+   input  logic   [CPU_BUS_SZ-1:0] req_data,
+   input  logic        [TAG_W-1:0] req_tag,
+   input  logic                    req_fence,   //- Flush every line first
+   output logic                    req_ready,
+   //- Cache requests (nb_cache)
+   output logic                    c_valid,
+   output logic                    c_rw,
+   output logic   [CPU_BUS_SZ-1:0] c_addr,
+   output logic   [CPU_BUS_SZ-1:0] c_data,
+   output logic        [TAG_W-1:0] c_tag,
+   output logic                    c_line,      //- Line write
+   output logic   [MEM_BUS_SZ-1:0] c_ldata,
+   output logic [MEM_BUS_SZ/8-1:0] c_lstrb,
+   input  logic                    c_ready
+);
+
+localparam LINE_W  = $clog2(MEM_BUS_SZ/8);
+localparam WORDS   = MEM_BUS_SZ/CPU_BUS_SZ;
+localparam WORD_W  = $clog2(WORDS);
+localparam LA_W    = CPU_BUS_SZ - LINE_W;
+localparam E_W     = LINES > 1 ? $clog2(LINES) : 1;
+localparam AGE_W   = $clog2(TIMEOUT+1);
+
+//- Line buffers
+logic                  e_valid [0:LINES-1];
+logic       [LA_W-1:0] e_line  [0:LINES-1];
+logic [MEM_BUS_SZ-1:0] e_data  [0:LINES-1];
+logic      [WORDS-1:0] e_mask  [0:LINES-1];
+logic      [AGE_W-1:0] e_age   [0:LINES-1];
+
+logic       [LA_W-1:0] req_line;
+logic     [WORD_W-1:0] req_woff;
+logic                  comb;    //- The request is a word write to merge
+logic                  m_any;
+logic        [E_W-1:0] m_e;
+logic                  free_any;
+logic        [E_W-1:0] free_e;
+logic                  valid_any;
+logic        [E_W-1:0] valid_e;
+logic                  bg_any;  //- Full or old line
+logic        [E_W-1:0] bg_e;
+logic        [E_W-1:0] old_e;   //- Oldest line
+
+logic                  f_any;   //- Line flush this cycle
+logic        [E_W-1:0] f_e;
+logic                  f_take;
+logic                  pass;    //- The request goes to the cache
+logic                  absorb;  //- The request is merged
+
+assign req_line = req_addr[CPU_BUS_SZ-1:LINE_W];
+assign req_woff = req_addr[LINE_W-1:2];
+assign comb     = req_rw & ~req_fence;
+
+//- Line of the request, free line, any line, line to flush on its own
+always @( * ) begin
+   m_any     = 1'b0;
+   m_e       = 'h0;
+   free_any  = 1'b0;
+   free_e    = 'h0;
+   valid_any = 1'b0;
+   valid_e   = 'h0;
+   bg_any    = 1'b0;
+   bg_e      = 'h0;
+   old_e     = 'h0;
+   for (int e=LINES-1; e>=0; e=e-1) begin
+      if (e_valid[e] & e_line[e] == req_line) begin
+         m_any = 1'b1;
+         m_e   = e;
+      end
+      if (~e_valid[e]) begin
+         free_any = 1'b1;
+         free_e   = e;
+      end else begin
+         valid_any = 1'b1;
+         valid_e   = e;
+      end
+      if (e_valid[e] & (&e_mask[e] | e_age[e] == TIMEOUT)) begin
+         bg_any = 1'b1;
+         bg_e   = e;
+      end
+      if (e_age[e] >= e_age[old_e]) old_e = e;
+   end
+end
+
+//- A request that cannot go on forces a flush: its line, the oldest or any
+always @( * ) begin
+   f_any = bg_any;
+   f_e   = bg_e;
+   if (req_valid) begin
+      if (comb & ~m_any & ~free_any) begin
+         f_any = 1'b1;
+         f_e   = old_e;
+      end else if (~comb & ~req_rw & m_any) begin
+         f_any = 1'b1;
+         f_e   = m_e;
+      end else if (req_fence & valid_any) begin
+         f_any = 1'b1;
+         f_e   = valid_e;
+      end
+   end
+end
+
+assign f_take = f_any & c_ready;
+
+//- A merge takes another line than the one flushed, reads and fences wait for the flushes
+assign absorb    = req_valid & comb & (m_any ? ~(f_any & m_e == f_e) : free_any);
+assign pass      = req_valid & ~comb & ~f_any;
+assign req_ready = comb ? (m_any ? ~(f_any & m_e == f_e) : free_any) : ~f_any & c_ready;
+
+assign c_valid = f_any | pass;
+assign c_rw    = f_any ? 1'b1 : req_rw;
+assign c_addr  = f_any ? {e_line[f_e], {LINE_W{1'b0}}} : req_addr;
+assign c_data  = f_any ? 'h0 : req_data;
+assign c_tag   = f_any ? 'h0 : req_tag;
+assign c_line  = f_any;
+assign c_ldata = e_data[f_e];
+
+always @( * ) begin
+   for (int w=0; w<WORDS; w=w+1)
+      c_lstrb[w*CPU_BUS_SZ/8 +: CPU_BUS_SZ/8] = {(CPU_BUS_SZ/8){e_mask[f_e][w]}};
+end
+
+always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
+  if (~clk_ctrl_rst_low) begin
+    for (int e=0; e<LINES; e=e+1) begin
+      e_valid[e] <= 1'b0;
+      e_line[e]  <= 'h0;
+      e_data[e]  <= 'h0;
+      e_mask[e]  <= 'h0;
+      e_age[e]   <= 'h0;
+    end
+  end else begin
+    for (int e=0; e<LINES; e=e+1)
+      if (e_valid[e] & e_age[e] != TIMEOUT) e_age[e] <= e_age[e] + 'h1;
+
+    if (f_take) e_valid[f_e] <= 1'b0;
+
+    if (absorb) begin
+      if (m_any) begin
+        e_data[m_e][req_woff*CPU_BUS_SZ +: CPU_BUS_SZ] <= req_data;
+        e_mask[m_e][req_woff] <= 1'b1;
+      end else begin
+        e_valid[free_e] <= 1'b1;
+        e_line[free_e]  <= req_line;
+        e_data[free_e][req_woff*CPU_BUS_SZ +: CPU_BUS_SZ] <= req_data;
+        e_mask[free_e]  <= 'h1 << req_woff;
+        e_age[free_e]   <= 'h0;
+      end
+    end
+  end
+end
+
+endmodule
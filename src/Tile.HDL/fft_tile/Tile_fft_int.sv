@@ -132,7 +132,9 @@ axi_control#(
 	.mem_rdata_axi     (mem_rdata_axi),
    .rvControl         (rvControl),
    .tile_coordinates_line (tile_coordinates_line),
-   .tile_coordinates_ctrl (tile_coordinates_ctrl));
+   .tile_coordinates_ctrl (tile_coordinates_ctrl),
+   .stats_sel             ( ),
+   .stats_dout            (32'h0));
 
 
 ///////////////////////////////////
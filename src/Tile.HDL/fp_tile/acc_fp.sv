@@ -27,6 +27,16 @@
 // Description : Accelerator with floating point 
 //               units
 // File        : acc_fp.sv
+// Notes       :
+//  - Request: an mPut whose second word says where the results go
+//    ([9:8] 01 forward, 10 final send to [5:0], else back to the
+//    source) followed by the operands, low word first.
+//  - The unit takes an operation every OPW input words, back to back
+//    across packets of any source. The reply headers of a packet are
+//    kept as a tag (up to TAGS packets in flight) and every operation
+//    carries its tag to its result slot, so the replies are built as
+//    the results come out and the input never waits for the output
+//    while there are free slots (RES_Q).
 ////////////////////////////////////////////////
 
 `timescale 1 ps/ 1 ps
@@ -35,7 +45,9 @@ module acc_fp#(
    parameter OFFSET_SZ         = 12,
    parameter XY_SZ             =  3,
    parameter TYPE              = "ADDER",
-   parameter NOC_BUFFER_ADDR_W =  8
+   parameter NOC_BUFFER_ADDR_W =  8,
+   parameter TAGS              =  8, //- Packets with operations in flight, power of two
+   parameter RES_Q             = 32  //- Operations in flight or waiting to be sent, power of two
 )(
   //---Clock and Reset---//
    input  logic       clk_ctrl,
@@ -70,14 +82,22 @@ module acc_fp#(
 
 localparam [2:0] QPUT = 3'd3;
 localparam [2:0] MPUT = 3'd4;  
-localparam FIFO_WRITE_DEPTH = 16;
-localparam COUNT_WIDTH = 4;
-localparam PROG_FULL_THRESH = 5;
+localparam OPW = TYPE == "SQRT" ? 2 : 4; //- Input words per operation
+localparam TB  = $clog2(TAGS);
+localparam RB  = $clog2(RES_Q);
 
-logic [COUNT_WIDTH-1:0] header_rd_data_count;
-logic [COUNT_WIDTH-1:0] header_wr_data_count;
-logic [COUNT_WIDTH-1:0] out_rd_data_count;
-logic [COUNT_WIDTH-1:0] out_wr_data_count;
+//- Input
+localparam [1:0] I_H1   = 2'd0;
+localparam [1:0] I_H2   = 2'd1; //- Second word: where the results go
+localparam [1:0] I_DATA = 2'd2;
+
+//- Output
+localparam [1:0] O_H1   = 2'd0;
+localparam [1:0] O_H2   = 2'd1;
+localparam [1:0] O_LO   = 2'd2;
+localparam [1:0] O_HI   = 2'd3;
+
+integer i;
 
 logic        stream_in_TVALID_int;
 logic [31:0] stream_in_TDATA_int;
@@ -97,54 +117,55 @@ assign rvRstN = rvControl[0]; //1'b0;
 logic in_valid;
 logic out_ready;
 logic [63:0] in_data_0;
-logic [63:0] next_in_data_0;
 logic [63:0] in_data_1;
-logic [63:0] next_in_data_1;
 logic [63:0] out_data;
 
-logic [63:0] out_data_reg;
-logic [63:0] next_out_data_reg;
-logic out_ready_reg;
-logic next_out_ready_reg;
-
-logic [2:0] state_in;
-logic [2:0] next_state_in;
-
-logic first;
-logic next_first;
+logic [1:0] state_in;
+logic [1:0] next_state_in;
+logic [1:0] state_out;
+logic [1:0] next_state_out;
 
-logic finish;
-logic next_finish;
-
-logic [2:0] state_out;
-logic [2:0] next_state_out;
-logic [7:0] next_pkt_ctr;
-logic [7:0] pkt_ctr;
-logic [3:0] pkt_sz_code;
-
-logic header_rd_en;
-logic header_wr_en;
-logic [31:0] header_dout;
-logic [31:0] header_din;
 logic [31:0] header_reg;
 logic [31:0] next_header_reg;
-logic [1:0] next_code;
-logic [1:0] code;
-
-logic [31:0] data_out_reg;
-logic [31:0] next_data_out_reg;
-logic next_next_pkt;
-logic next_pkt;
-
-logic header_empty;
-logic header_full;
-
-logic [5:0] next_dest;
-logic [5:0] dest;
-
-logic out_empty;
-logic out_full;
-
+logic [31:0] rsp_h1;        //- Reply headers of the packet being read
+logic [31:0] next_rsp_h1;
+logic [31:0] rsp_h2;
+logic [31:0] next_rsp_h2;
+logic        first;         //- No operation of the packet issued yet
+logic        next_first;
+logic  [1:0] word;          //- Word of the operation
+logic  [1:0] next_word;
+logic [31:0] op_w [3:0];
+logic  [3:0] pkt_sz_code;
+logic        in_last;       //- Last operation of the packet
+
+//- Tags: the reply headers of the packets with operations in flight
+logic   [31:0] t_h1 [TAGS-1:0];
+logic   [31:0] t_h2 [TAGS-1:0];
+logic   [TB:0] t_wr, t_rd;
+logic          t_full;
+logic [TB-1:0] in_tag;
+logic          t_pop;
+
+assign t_full = (t_wr - t_rd) == TAGS;
+assign in_tag = first ? t_wr[TB-1:0] : t_wr[TB-1:0] - 1'b1;
+
+//- Results: a slot is taken when the operation is issued, it keeps the
+//  tag and gets the result when the unit gives it (in order)
+logic [TB-1:0] r_tag  [RES_Q-1:0];
+logic          r_last [RES_Q-1:0];
+logic   [63:0] r_data [RES_Q-1:0];
+logic   [RB:0] r_is, r_wr, r_rd; //- Issued, done and sent operations
+logic          r_full;
+logic          r_avail;
+logic [RB-1:0] o_idx;
+logic [TB-1:0] o_tag;
+logic          r_pop;
+
+assign r_full  = (r_is - r_rd) == RES_Q;
+assign r_avail = r_wr != r_rd;
+assign o_idx   = r_rd[RB-1:0];
+assign o_tag   = r_tag[o_idx];
 
 noc_buffer_in#(
    .ADDR_W (NOC_BUFFER_ADDR_W)
@@ -170,6 +191,10 @@ noc_buffer_in#(
 // FP accelerator
 //////////////////////////////
 
+//- Doubles come low word first. The last word goes straight in.
+assign in_data_0 = OPW == 2 ? {stream_in_TDATA_int, op_w[0]} : {op_w[1], op_w[0]};
+assign in_data_1 = {stream_in_TDATA_int, op_w[2]};
+
 generate
 if (TYPE == "ADDER") begin
    FP_adder_64_13cc fp_adder (
@@ -203,315 +228,175 @@ end else if (TYPE == "SQRT") begin
       .clock      (clk_ctrl),
       .reset      (clk_ctrl_rst_high),
       .in_valid   (in_valid),
-      .in_data    (in_data_1),
+      .in_data    (in_data_0),
       .out_data   (out_data),
       .out_ready  (out_ready));
 end
+endgenerate
 
-logic out_almost_full;
-logic header_almost_full;
+//- Two doubles in, one out (SQRT: one in, one out)
+assign pkt_sz_code = TYPE == "SQRT" ? header_reg[11:8] : header_reg[11:8]-1;
 
+//- Like a NoC decoder. A word per cycle, the input only waits for a
+//  free result slot or tag when an operation is issued.
 always @(*) begin
-   next_state_in = state_in;
-   next_finish   = finish;
-   next_first    = first;
+   next_state_in   = state_in;
    next_header_reg = header_reg;
-   next_code = code; 
-   next_dest = dest;
-
-   header_wr_en = 1'b0;
-   header_din = 'h0;
+   next_rsp_h1     = rsp_h1;
+   next_rsp_h2     = rsp_h2;
+   next_first      = first;
+   next_word       = word;
 
    in_valid = 1'b0;
-   next_in_data_0 = in_data_0;
-   next_in_data_1 = in_data_1;
+   in_last  = 1'b0;
 
    stream_in_TREADY_int = 1'b1;
 
    case (state_in)
-      0: begin
-         if (stream_out_TREADY_int & ~header_almost_full & ~out_almost_full) begin
-            if (stream_in_TVALID_int) begin
-               next_header_reg = stream_in_TDATA_int;
-               next_state_in = 'h1;
-            end
-         end else stream_in_TREADY_int = 1'b0;
+      I_H1: begin
+         if (stream_in_TVALID_int) begin
+            next_header_reg = stream_in_TDATA_int;
+            if (~stream_in_TLAST_int) next_state_in = I_H2;
+         end
       end
-      1:begin //- Second part of the header
+      I_H2: begin //- Second part of the header
          //31,30,29,28 - 27,26,25,24 - 23,22,21,20 - 19,18,17,16 - 15,14,13,12
          //11,10,9,8   -  7,6,5,4    -  3,2,1,0
          if (stream_in_TVALID_int) begin
-            header_wr_en = 1'b1;
             if (stream_in_TDATA_int[9:8] == 2'b01) begin //- Forward
-               header_din = {3'h0,1'b1,MPUT,1'b0,HsrcId,6'h0,pkt_sz_code,2'h0,stream_in_TDATA_int[5:0]};
-               next_code = 2'b10;
-               next_dest = header_reg[23:18];
+               next_rsp_h1 = {3'h0,1'b1,MPUT,1'b0,HsrcId,6'h0,pkt_sz_code,2'h0,stream_in_TDATA_int[5:0]};
+               next_rsp_h2 = {20'h0,2'b10,2'h0,header_reg[23:18]};
             end else if (stream_in_TDATA_int[9:8] == 2'b10) begin //- Final send to pico
-               header_din = {3'h0,1'b1,QPUT,1'b0,HsrcId,6'h0,pkt_sz_code,2'h0,stream_in_TDATA_int[5:0]};
-               next_code = 2'b00;
-               next_dest = 'h0;
+               next_rsp_h1 = {3'h0,1'b1,QPUT,1'b0,HsrcId,6'h0,pkt_sz_code,2'h0,stream_in_TDATA_int[5:0]};
+               next_rsp_h2 = 'h0;
             end else begin //- Default: send back to pico
-               header_din = {3'h0,1'b1,QPUT,1'b0,HsrcId,6'h0,pkt_sz_code,2'h0,header_reg[23:18]}; 
-               next_code = 2'b00;
-               next_dest = 'h0;
+               next_rsp_h1 = {3'h0,1'b1,QPUT,1'b0,HsrcId,6'h0,pkt_sz_code,2'h0,header_reg[23:18]};
+               next_rsp_h2 = 'h0;
             end
-            if (TYPE == "SQRT") next_state_in = 'h3;
-            else next_state_in = 'h2;
-         end
-      end
-      2: begin
-         if (stream_in_TVALID_int) begin
-            header_wr_en = 1'b1;
-            header_din = {20'h0,code,2'h0,dest}; //- Write second part of the header.
-            next_in_data_0[63:32] = stream_in_TDATA_int;
-            next_state_in = 'h3;
-         end
-      end
-      3: begin
-         if (stream_in_TVALID_int) begin
-            next_in_data_0[31:0] = stream_in_TDATA_int;
-            next_state_in = 'h4;
-         end
-      end
-      4: begin
-         if (stream_in_TVALID_int) begin
-            next_in_data_1 = stream_in_TDATA_int;
-            next_state_in = 'h5;
-         end
-      end
-      5: begin
-         if (stream_in_TVALID_int) begin //- Finish this last one anyway
-            in_valid = 1'b1;
-            if (stream_in_TLAST_int)
-               next_state_in = 'h0;
-            else
-               next_state_in = 'h6;
+            next_first    = 1'b1;
+            next_word     = 'h0;
+            next_state_in = stream_in_TLAST_int ? I_H1 : I_DATA;
          end
       end
-      6: begin
-         if (stream_in_TVALID_int) begin
-            next_in_data_0[63:32] = stream_in_TDATA_int;
-            next_state_in = 'h3;
+      I_DATA: begin
+         if ((word == OPW-1 | stream_in_TLAST_int) & (r_full | (first & t_full)))
+            stream_in_TREADY_int = 1'b0;
+         else if (stream_in_TVALID_int) begin
+            next_word = word + 'h1;
+            if (word == OPW-1 | stream_in_TLAST_int) begin //- Finish the last one anyway
+               in_valid   = 1'b1;
+               in_last    = stream_in_TLAST_int;
+               next_first = 1'b0;
+               next_word  = 'h0;
+            end
+            if (stream_in_TLAST_int) next_state_in = I_H1;
          end
       end
+      default: next_state_in = I_H1;
    endcase
 end
 
-
-if (TYPE == "SQRT")
-   assign pkt_sz_code = header_reg[11:8];
-else
-   assign pkt_sz_code = header_reg[11:8]-1;
-
-endgenerate
-
-
-//- Like a NoC decoder
 always @(posedge clk_ctrl) begin
    if (~clk_ctrl_rst_low) begin
-      state_in <= 'h0;
-      finish <= 1'b0;
-      first <= 1'b0;
-      in_data_0 <= 'h0;
-      in_data_1 <= 'h0;
+      state_in   <= I_H1;
       header_reg <= 'h0;
-      code <= 'h0;
-      dest <= 'h0;
+      rsp_h1     <= 'h0;
+      rsp_h2     <= 'h0;
+      first      <= 1'b0;
+      word       <= 'h0;
+      t_wr       <= 'h0;
+      t_rd       <= 'h0;
+      r_is       <= 'h0;
+      r_wr       <= 'h0;
+      r_rd       <= 'h0;
+      for (i=0; i<4; i=i+1) op_w[i] <= 'h0;
+      for (i=0; i<TAGS; i=i+1) begin
+         t_h1[i] <= 'h0;
+         t_h2[i] <= 'h0;
+      end
+      for (i=0; i<RES_Q; i=i+1) begin
+         r_tag[i]  <= 'h0;
+         r_last[i] <= 1'b0;
+         r_data[i] <= 'h0;
+      end
    end else begin
-      dest <= next_dest;
-      code <= next_code;
+      state_in   <= next_state_in;
       header_reg <= next_header_reg;
-      state_in  <= next_state_in;
-      finish    <= next_finish;
-      first     <= next_first;
-      in_data_0 <= next_in_data_0;
-      in_data_1 <= next_in_data_1;
+      rsp_h1     <= next_rsp_h1;
+      rsp_h2     <= next_rsp_h2;
+      first      <= next_first;
+      word       <= next_word;
+      if (state_in == I_DATA & stream_in_TVALID_int & stream_in_TREADY_int)
+         op_w[word] <= stream_in_TDATA_int;
+      //- The first operation of a packet takes a tag
+      if (in_valid & first) begin
+         t_h1[t_wr[TB-1:0]] <= rsp_h1;
+         t_h2[t_wr[TB-1:0]] <= rsp_h2;
+         t_wr <= t_wr + 'h1;
+      end
+      if (t_pop) t_rd <= t_rd + 'h1;
+      if (in_valid) begin
+         r_tag[r_is[RB-1:0]]  <= in_tag;
+         r_last[r_is[RB-1:0]] <= in_last;
+         r_is <= r_is + 'h1;
+      end
+      if (out_ready) begin
+         r_data[r_wr[RB-1:0]] <= out_data;
+         r_wr <= r_wr + 'h1;
+      end
+      if (r_pop) r_rd <= r_rd + 'h1;
    end
 end
 
-//- Like a NoC encoder
-
-
-logic [63:0] out_dout;
-logic out_rd_en;
-
+//- Like a NoC encoder. A reply starts with its first result, the
+//  headers come from the tag of the result.
 always @(posedge clk_ctrl) begin
-   if (~clk_ctrl_rst_low) begin
-      state_out    <= 'h0;
-      pkt_ctr      <= 'h0;
-   end else begin
-      state_out    <= next_state_out;
-      pkt_ctr      <= next_pkt_ctr;
-   end
+   if (~clk_ctrl_rst_low) state_out <= O_H1;
+   else                   state_out <= next_state_out;
 end
 
-
-
 always @(*) begin
    next_state_out = state_out;
-   next_pkt_ctr = pkt_ctr;
-
-   header_rd_en = 1'b0;
-   out_rd_en = 1'b0;
+   r_pop = 1'b0;
+   t_pop = 1'b0;
 
    stream_out_TVALID_int = 1'b0;
    stream_out_TDATA_int  =  'h0;
-   stream_out_TKEEP_int  =  'h0;
+   stream_out_TKEEP_int  = 4'hF;
    stream_out_TLAST_int  = 1'b0;
 
    case (state_out)
-      0: begin
-         if (stream_out_TREADY_int) begin
-            if (~out_empty) begin
-               header_rd_en   = 1'b1;
-               next_state_out = 1;
-            end
-         end
+      O_H1: begin
+         stream_out_TVALID_int = r_avail;
+         stream_out_TDATA_int  = t_h1[o_tag];
+         if (r_avail & stream_out_TREADY_int) next_state_out = O_H2;
       end
-      1: begin
-         if (stream_out_TREADY_int) begin
-            header_rd_en   = 1'b1;
-            stream_out_TVALID_int = 1'b1;
-            stream_out_TDATA_int  = header_dout;
-            stream_out_TKEEP_int  = 'hFFFF;
-            next_pkt_ctr          = 1 << header_dout[11:8] - 1;
-            next_state_out        = 2;
-         end
-      end
-      2: begin
-         if (stream_out_TREADY_int) begin
-            out_rd_en        = 1'b1;
-            stream_out_TVALID_int = 1'b1;
-            stream_out_TDATA_int  = header_dout;
-            stream_out_TKEEP_int  = 'hFFFF;
-            next_state_out        = 3;
-         end
+      O_H2: begin
+         stream_out_TVALID_int = 1'b1;
+         stream_out_TDATA_int  = t_h2[o_tag];
+         if (stream_out_TREADY_int) next_state_out = O_LO;
       end
-      3: begin
-         if (stream_out_TREADY_int) begin
-            stream_out_TVALID_int = 1'b1;
-            stream_out_TKEEP_int = 'hFFFF;
-            stream_out_TDATA_int = out_dout[31:0];
-            next_state_out = 4;
-         end 
+      O_LO: begin
+         stream_out_TVALID_int = r_avail;
+         stream_out_TDATA_int  = r_data[o_idx][31:0];
+         if (r_avail & stream_out_TREADY_int) next_state_out = O_HI;
       end
-      4: begin
+      O_HI: begin
+         stream_out_TVALID_int = 1'b1;
+         stream_out_TDATA_int  = r_data[o_idx][63:32];
+         stream_out_TLAST_int  = r_last[o_idx];
          if (stream_out_TREADY_int) begin
-            stream_out_TVALID_int = 1'b1;
-            stream_out_TKEEP_int = 'hFFFF;
-            stream_out_TDATA_int = out_dout[63:32];
-            next_pkt_ctr = pkt_ctr - 1;
-            if (pkt_ctr == 'h1) begin
-               stream_out_TLAST_int = 1'b1;
-               next_state_out = 0;
-            end else if (~out_empty) begin
-               out_rd_en = 1'b1;
-               next_state_out = 3;
-            end else next_state_out = 5;
-         end
-      end
-      5: begin
-         if (~out_empty) begin
-            out_rd_en = 1'b1;
-            next_state_out = 3;
+            r_pop = 1'b1;
+            if (r_last[o_idx]) begin
+               t_pop          = 1'b1;
+               next_state_out = O_H1;
+            end else
+               next_state_out = O_LO;
          end
       end
    endcase
 end
 
-//- FIXME: This fifos are too big
-xpm_fifo_sync #(
-   .CASCADE_HEIGHT      (0),        // DECIMAL
-   .DOUT_RESET_VALUE    ("0"),    // String
-   .ECC_MODE            ("no_ecc"),       // String
-   .FIFO_MEMORY_TYPE    ("auto"), // String
-   .FIFO_READ_LATENCY   (1),     // DECIMAL
-   .FIFO_WRITE_DEPTH    (FIFO_WRITE_DEPTH),   // DECIMAL
-   .FULL_RESET_VALUE    (0),      // DECIMAL
-   .PROG_EMPTY_THRESH   (),    // DECIMAL
-   .PROG_FULL_THRESH    (PROG_FULL_THRESH),     // DECIMAL
-   .RD_DATA_COUNT_WIDTH (COUNT_WIDTH),   // DECIMAL
-   .READ_DATA_WIDTH     (32),      // DECIMAL
-   .READ_MODE           ("std"),         // String
-   .SIM_ASSERT_CHK      (0),        // DECIMAL; 0=disable simulation messages, 1=enable simulation messages
-   .USE_ADV_FEATURES    ("070f"), // String
-   .WAKEUP_TIME         (0),           // DECIMAL
-   .WRITE_DATA_WIDTH    (32),     // DECIMAL
-   .WR_DATA_COUNT_WIDTH (COUNT_WIDTH)    // DECIMAL
-) xpm_fifo_sync_header (
-   .almost_empty  (), 
-   .almost_full   (header_almost_full),   
-   .data_valid    (),       
-   .dbiterr       (),             
-   .dout          (header_dout),                   
-   .empty         (header_empty),                 
-   .full          (header_full),                  
-   .overflow      (),           
-   .prog_empty    (),       
-   .prog_full     (),     
-   .rd_data_count (header_rd_data_count), 
-   .rd_rst_busy   (),     
-   .sbiterr       (),        
-   .underflow     (),         
-   .wr_ack        (),
-   .wr_data_count (header_wr_data_count), 
-   .wr_rst_busy   (),    
-   .din           (header_din),  
-   .injectdbiterr (1'b0), 
-   .injectsbiterr (1'b0), 
-   .rd_en         (header_rd_en),  
-   .rst           (clk_ctrl_rst_high),   
-   .sleep         (1'b0),  
-   .wr_clk        (clk_ctrl),
-   .wr_en         (header_wr_en)  
-);
-
-xpm_fifo_sync #(
-   .CASCADE_HEIGHT      (0),        // DECIMAL
-   .DOUT_RESET_VALUE    ("0"),    // String
-   .ECC_MODE            ("no_ecc"),       // String
-   .FIFO_MEMORY_TYPE    ("auto"), // String
-   .FIFO_READ_LATENCY   (1),     // DECIMAL
-   .FIFO_WRITE_DEPTH    (FIFO_WRITE_DEPTH),   // DECIMAL
-   .FULL_RESET_VALUE    (0),      // DECIMAL
-   .PROG_EMPTY_THRESH   (),    // DECIMAL
-   .PROG_FULL_THRESH    (PROG_FULL_THRESH),     // DECIMAL
-   .RD_DATA_COUNT_WIDTH (COUNT_WIDTH),   // DECIMAL
-   .READ_DATA_WIDTH     (64),      // DECIMAL
-   .READ_MODE           ("std"),         // String
-   .SIM_ASSERT_CHK      (0),        // DECIMAL; 0=disable simulation messages, 1=enable simulation messages
-   .USE_ADV_FEATURES    ("070f"), // String
-   .WAKEUP_TIME         (0),           // DECIMAL
-   .WRITE_DATA_WIDTH    (64),     // DECIMAL
-   .WR_DATA_COUNT_WIDTH (COUNT_WIDTH)    // DECIMAL
-) xpm_fifo_sync_output (
-   .almost_empty  (), 
-   .almost_full   (out_almost_full),   
-   .data_valid    (),       
-   .dbiterr       (),             
-   .dout          (out_dout),
-   .empty         (out_empty),                 
-   .full          (out_full),                  
-   .overflow      (),           
-   .prog_empty    (),       
-   .prog_full     (),     
-   .rd_data_count (out_rd_data_count), 
-   .rd_rst_busy   (),     
-   .sbiterr       (),        
-   .underflow     (),         
-   .wr_ack        (),
-   .wr_data_count (out_wr_data_count), 
-   .wr_rst_busy   (),    
-   .din           (out_data),  
-   .injectdbiterr (1'b0), 
-   .injectsbiterr (1'b0), 
-   .rd_en         (out_rd_en),  
-   .rst           (clk_ctrl_rst_high),   
-   .sleep         (1'b0),  
-   .wr_clk        (clk_ctrl),
-   .wr_en         (out_ready)  
-);
-
 
 //////////////////////////////
 // Buffer NoC data
@@ -51,6 +51,7 @@ module noc_buffer_out#(
    (*mark_debug = "true" *) input  logic [BWB-1:0] stream_in_TKEEP, 
    (*mark_debug = "true" *) input  logic        stream_in_TLAST,
    (*mark_debug = "true" *) output logic        stream_in_TREADY,
+   output logic        stream_in_idle,   //- Every packet written has been sent (clk_in)
    //- Output Interface
    (*mark_debug = "true" *) output logic        stream_out_TVALID,
    (*mark_debug = "true" *) output logic [BW-1:0] stream_out_TDATA,
@@ -119,6 +120,21 @@ xpm_cdc_array_single#(
   .dest_clk (clk_out),
   .dest_out (ctr_in_sync));
 
+//- Packets sent, back in the write clock domain
+logic [ADDR_W-1:0] ctr_out_sync;
+
+xpm_cdc_array_single#(
+  .WIDTH(ADDR_W),
+  .SIM_ASSERT_CHK(`SIM_ASSERT_CHK)
+) sent_cdc (
+  // Module ports
+  .src_clk  (clk_out),
+  .src_in   (ctr_out),
+  .dest_clk (clk_in),
+  .dest_out (ctr_out_sync));
+
+assign stream_in_idle = ctr_in == ctr_out_sync;
+
 always @(*) begin
    //- State
    next_state = state;
@@ -62,12 +62,18 @@ module noc_decoder #(
    input  logic          fifo_0_full,
    output logic          fifo_0A_en,   //- Message queues
    output logic   [31:0] fifo_0A_addr,
+   output logic [BW-1:0] fifo_0A_din,
+   input  logic          spill_en,     //- Spill queue messages to memory when the FIFO is full
+   input  logic   [31:0] spill_base,   //- Word address of the spill region
+   input  logic    [3:0] spill_size_w, //- The spill region holds 1<<spill_size_w words
    output logic   [31:0] mem_addr_a,   //- Scratchpad memory
+   output logic          mem_xa_a,     //- mem_addr_a is an extended (full 32-bit) address
    output logic [BW-1:0] mem_wdata_a, 
    output logic          mem_wstrb_a,
    output logic          mem_valid_a,
    input  logic [BW-1:0] mem_rdata_a,
-   output logic   [31:0] mem_rdata_rv
+   output logic   [31:0] mem_rdata_rv,
+   output logic          mem_reply_done  //- Last word of a response to an mGet was written
 );
 
 /***************************
@@ -97,6 +103,9 @@ localparam [3:0] WAIT_SEND  = 4'd6; //
 localparam [3:0] HEADER2    = 4'd9; 
 localparam [3:0] ERROR      = 4'd15; //
 localparam [3:0] IGNORE     = 4'hA;
+localparam [3:0] SPILL_WR   = 4'hC; //- Queue message to the spill region
+localparam [3:0] SPILL_RD   = 4'hD; //- Read the oldest spilled word
+localparam [3:0] SPILL_FILL = 4'hE; //- and push it in the FIFO
 
 
 //***************************
@@ -121,7 +130,7 @@ logic [31:0] noc_offset_in;
 logic hl_reg;
 
 logic pt;
-assign pt=0;
+assign pt=1; //- Responses are tagged (as the DRAM tile does) so the requester can count them
 
 logic  [5:0] noc_out_dest;
 logic [11:0] noc_out_offset;
@@ -169,11 +178,47 @@ end
 logic hl;
 assign hl = stream_in_TDATA[28];
 assign hl_reg = noc_header1_in[28];
+
+//- Extended address (mPutX/mGetX): the second word of the long header
+//  is the full word address, it is not windowed to OFFSET_SZ.
+assign mem_xa_a = hl_reg & noc_header1_in[29];
 assign noc_offset_in = {20'h0,stream_in_TDATA[17:6]};
 
 logic [31:0] req_id;
 logic [31:0] next_req_id;
 
+//- Spill region: a ring in tile memory that extends the inbound FIFO.
+//  Once a word is spilled every queue word goes to the ring until it
+//  is drained back in the FIFO, so the message order is preserved.
+logic [15:0] spill_wr;
+logic [15:0] next_spill_wr;
+logic [15:0] spill_rd;
+logic [15:0] next_spill_rd;
+logic [16:0] spill_cnt;
+logic [16:0] next_spill_cnt;
+logic [15:0] spill_mask;
+logic        spill_full;
+logic        spill_busy;
+logic        fifo_0A_refill;
+
+assign spill_mask = (17'h1 << spill_size_w) - 1;
+assign spill_full = spill_cnt == (17'h1 << spill_size_w);
+assign spill_busy = spill_en & (fifo_0_full | spill_cnt != 0);
+
+always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
+   if (~clk_ctrl_rst_low) begin
+      spill_wr  <= 'h0;
+      spill_rd  <= 'h0;
+      spill_cnt <= 'h0;
+   end else begin
+      spill_wr  <= next_spill_wr;
+      spill_rd  <= next_spill_rd;
+      spill_cnt <= next_spill_cnt;
+   end
+end
+
+assign fifo_0A_din = fifo_0A_refill ? mem_rdata_a : stream_in_TDATA;
+
 always @( * ) begin
    //- State
    nextState1 = currentState1;
@@ -198,15 +243,30 @@ always @( * ) begin
    fifo_0A_en = 1'b0;
    next_fifo_0A_addr = fifo_0A_addr;
 
+   mem_reply_done = 1'b0;
+
+   fifo_0A_refill = 1'b0;
+   next_spill_wr  = spill_wr;
+   next_spill_rd  = spill_rd;
+   next_spill_cnt = spill_cnt;
+
 
    case (currentState1)
       IDLE: begin                                              // Waiting for an incoming packet
-         if (stream_in_TVALID) begin
+         if (spill_cnt != 0 && !fifo_0_full) begin //- Refill the FIFO first
+            stream_in_TREADY = 1'b0;
+            next_mem_addr_a  = spill_base + (spill_rd & spill_mask);
+            nextState1       = SPILL_RD;
+         end else if (stream_in_TVALID) begin
             next_noc_header1_in = stream_in_TDATA;
             if      (noc_inst_data)     nextState1 = MEM_WR_DAT;  // End previous MLOAD transaction after writing to MEM 
             else if (noc_inst_ack)      nextState1 = MEM_ACK;     // End previous MSTORE transaction 
             else if (noc_inst_queue) begin     // - Write to Queue
-               if (fifo_0_full) begin
+               if (spill_busy) begin
+                  stream_in_TREADY = 1'b0;
+                  next_mem_addr_a  = spill_base + (spill_wr & spill_mask);
+                  nextState1       = SPILL_WR;
+               end else if (fifo_0_full) begin
                   stream_in_TREADY = 1'b0;
                end else begin
                   fifo_0A_en        = 1'b1;
@@ -245,6 +305,10 @@ always @( * ) begin
          if (stream_in_TVALID) begin
             if (fifo_0_full) begin
                stream_in_TREADY = 1'b0;
+               if (spill_en) begin //- Continue the message in the spill region
+                  next_mem_addr_a = spill_base + (spill_wr & spill_mask);
+                  nextState1      = SPILL_WR;
+               end
             end else begin
                next_noc_data_in = stream_in_TDATA;
                fifo_0A_en = 1'b1;
@@ -263,6 +327,7 @@ always @( * ) begin
             if (stream_in_TLAST) begin
                if (noc_code_reg == MSTORE) nextState1 = MEM_WR_ACK;
                else                        nextState1 = IDLE;
+               mem_reply_done = noc_code_reg == MPUT & noc_header1_in[24];
             end
          end
       end
@@ -350,6 +415,35 @@ always @( * ) begin
          if (stream_in_TLAST) 
             nextState1 = IDLE;
       end 
+      SPILL_WR: begin //C
+         if (stream_in_TVALID) begin
+            if (spill_full) begin
+               stream_in_TREADY = 1'b0;
+            end else begin
+               mem_valid_a     = 1'b1;
+               mem_wstrb_a     = 1'b1;
+               next_spill_wr   = spill_wr + 'h1;
+               next_spill_cnt  = spill_cnt + 'h1;
+               next_mem_addr_a = spill_base + ((spill_wr + 'h1) & spill_mask);
+               if (stream_in_TLAST)
+                  nextState1 = IDLE;
+            end
+         end
+      end
+      SPILL_RD: begin //D
+         stream_in_TREADY = 1'b0;
+         mem_valid_a      = 1'b1;
+         nextState1       = SPILL_FILL;
+      end
+      SPILL_FILL: begin //E
+         stream_in_TREADY  = 1'b0;
+         fifo_0A_refill    = 1'b1;
+         fifo_0A_en        = 1'b1;
+         next_fifo_0A_addr = fifo_0A_addr + 'h1;
+         next_spill_rd     = spill_rd + 'h1;
+         next_spill_cnt    = spill_cnt - 'h1;
+         nextState1        = IDLE;
+      end
   endcase
 end
 
@@ -41,7 +41,9 @@ module Tile_picorv32#(
    parameter AXI_ADDR          =  8,
    parameter OFFSET_SZ         = 12,
    parameter XY_SZ             =  3,
-   parameter NOC_BUFFER_ADDR_W =  8
+   parameter NOC_BUFFER_ADDR_W =  8,
+   parameter FPU               =  0,
+   parameter CORE              =  0
 )(
    input logic clk_control,
    input logic clk_line,
@@ -76,7 +78,11 @@ module Tile_picorv32#(
    (* dont_touch = "true" *) input  logic                control_S_AXI_RREADY,
    (* dont_touch = "true" *) output logic   [BW_AXI-1:0] control_S_AXI_RDATA,
    (* dont_touch = "true" *) output logic          [1:0] control_S_AXI_RRESP,
-   (* dont_touch = "true" *) output logic                control_S_AXI_RVALID
+   (* dont_touch = "true" *) output logic                control_S_AXI_RVALID,
+   //- Barrier network
+   output logic                   [3:0] barrier_member,
+   output logic                   [3:0] barrier_arrive,
+   input  logic                   [3:0] barrier_sense
 );
 //- Switch LOCAL
 logic           stream_out_local_out_TVALID;
@@ -100,6 +106,8 @@ logic [BW_AXI-1:0] mem_rdata_axi;
 
 //- Registers
 logic   [7:0] rvControl;
+logic   [7:0] stats_sel;
+logic  [31:0] stats_dout;
 logic [BW_AXI-1:0] tile_coordinates_line;
 logic [BW_AXI-1:0] tile_coordinates_ctrl;
 logic [XY_SZ-1:0] myX_line;
@@ -156,9 +164,19 @@ axi_control#(
    .mem_rdata_axi         (mem_rdata_axi),
    .rvControl             (rvControl),
    .tile_coordinates_line (tile_coordinates_line),
-   .tile_coordinates_ctrl (tile_coordinates_ctrl));
+   .tile_coordinates_ctrl (tile_coordinates_ctrl),
+   .stats_sel             (stats_sel),
+   .stats_dout            (stats_dout));
 
 
+///////////////////////////////////
+// Barrier groups
+///////////////////////////////////
+
+//- rvControl[7:4] excludes the tile from barrier group g (set by the host).
+//  A pico in reset never takes part in a barrier.
+assign barrier_member = {4{rvControl[0]}} & ~rvControl[7:4];
+
 ///////////////////////////////////
 // Accelerator Begin
 ///////////////////////////////////
@@ -166,7 +184,9 @@ axi_control#(
 acc_picorv32#(
    .OFFSET_SZ         (OFFSET_SZ),
    .XY_SZ             (XY_SZ),
-   .NOC_BUFFER_ADDR_W (NOC_BUFFER_ADDR_W)
+   .NOC_BUFFER_ADDR_W (NOC_BUFFER_ADDR_W),
+   .FPU               (FPU),
+   .CORE              (CORE)
 ) acc_picorv32 (
    //- Clock and reset
    .clk_ctrl          (clk_control),
@@ -178,6 +198,12 @@ acc_picorv32#(
    //- Tile identification
    .HsrcId            ({myY_ctrl,myX_ctrl}),
    .rvControl         (rvControl),
+   .stats_sel         (stats_sel),
+   .stats_dout        (stats_dout),
+   //- Barrier network
+   .barrier_member    (barrier_member),
+   .barrier_sense     (barrier_sense),
+   .barrier_arrive    (barrier_arrive),
    //- NOC interface
    //- Input Interface: Switch writing to the memory manager 
    .stream_in_TVALID  (stream_out_local_out_TVALID),
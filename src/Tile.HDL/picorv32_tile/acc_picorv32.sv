@@ -36,7 +36,9 @@ module acc_picorv32#(
    parameter OFFSET_SZ         = 12,
    parameter XY_SZ             =  3,
    parameter NOC_BUFFER_ADDR_W =  8,
-   parameter MEM_SZ            = 'h1000
+   parameter MEM_SZ            = 'h1000,
+   parameter FPU               = 0,     //- Double precision unit on the PCPI port
+   parameter CORE              = 0      //- 0 picorv32, 1 rv32im_pipe
 )(
   //---Clock and Reset---//
    input  logic       clk_ctrl,
@@ -66,7 +68,14 @@ module acc_picorv32#(
    input  logic        mem_wstrb_axi, 
    output logic [31:0] mem_rdata_axi,
   //- 
-  input logic  [7:0] rvControl
+  input logic  [7:0] rvControl,
+  //- Statistics
+  input  logic  [7:0] stats_sel,
+  output logic [31:0] stats_dout,
+  //- Barrier network
+  input  logic [3:0] barrier_member,
+  input  logic [3:0] barrier_sense,
+  output logic [3:0] barrier_arrive
 );
 
 //- Between memory manager and memory 
@@ -75,6 +84,7 @@ wire        mem_valid_data_a;
 wire        mem_wstrb_a;
 logic       mem_wstrb_data_a;
 wire [31:0] mem_addr_a;
+wire        mem_xa_a;
 wire [31:0] mem_wdata_a;
 wire [31:0] mem_rdata_data_a;
 wire [31:0] mem_rdata_a;
@@ -108,6 +118,12 @@ logic [31:0] mem_rdata_data_b;
 (*mark_debug = "true" *) logic        pcpi_wait;
 (*mark_debug = "true" *) logic        pcpi_ready;
 
+//- PCPI coprocessors: message queues and FPU
+logic        pcpi_wr_mq,    pcpi_wr_fp;
+logic [31:0] pcpi_rd_mq,    pcpi_rd_fp;
+logic        pcpi_wait_mq,  pcpi_wait_fp;
+logic        pcpi_ready_mq, pcpi_ready_fp;
+
 (*mark_debug = "true" *) logic rvRstN;
 
 logic [(2*XY_SZ-1):0] mem_addr_xy;
@@ -115,6 +131,19 @@ logic [(2*XY_SZ-1):0] mem_addr_xy;
 logic [31:0] mem_rdata_outsi_rv;
 logic mem_ready_outsi_rv;
 
+//- Send DMA: reads the data memory port B when the processor and AXI do not
+logic        dma_mem_valid;
+logic [31:0] dma_mem_addr;
+logic        dma_mem_grant;
+
+//- Remote data cache: hits read their line from port B, before the send DMA
+logic        dc_mem_valid;
+logic [31:0] dc_mem_addr;
+logic        dc_mem_grant;
+
+//- Instruction cache statistics {prefetch useless, prefetch useful, miss, hit}
+logic  [3:0] icache_event;
+
 always @(posedge clk_ctrl) begin
    if (mem_valid_rv == 1'b1 && mem_wstrb_rv == 4'hf && mem_addr_rv == 32'h00001000) begin
       $display("[%t] DEBUG OUTPUT: Write to 0x00001000 = 0x%08x", $time, mem_wdata_rv);
@@ -183,7 +212,11 @@ assign mem_rdata_a = mem_instr_rv ? mem_rdata_instr : mem_rdata_data_b;
 
 assign cpu_req_valid = ~boot & mem_instr_rv & mem_valid_rv;
 
-instr_mem instr_mem_inst(
+instr_mem#(
+   .CACHE_KB          (`ICACHE_KB),
+   .CACHE_WAYS        (`ICACHE_WAYS),
+   .PREFETCH          (`ICACHE_PREFETCH)
+) instr_mem_inst(
    //- Clock and reset
    .clk_ctrl          (clk_ctrl),
    .clk_line          (clk_line),
@@ -210,7 +243,12 @@ instr_mem instr_mem_inst(
    .mem_addr          (mem_addr_a),
    .mem_wdata         (mem_wdata_a),
    .mem_wstrb         (mem_wstrb_a),
-   .mem_valid         (mem_valid_cache)
+   .mem_valid         (mem_valid_cache),
+   //- Statistics
+   .stat_hit          (icache_event[0]),
+   .stat_miss         (icache_event[1]),
+   .stat_pf_useful    (icache_event[2]),
+   .stat_pf_useless   (icache_event[3])
 );
 
 assign is_data = mem_addr_a < MEM_SZ;            //- Is the NoC address for data or instruction memory?
@@ -218,8 +256,11 @@ assign mem_valid_cache = mem_valid_a & ~is_data; //- The NoC writes to instructi
 
 /* Signals for data memory */
 
-assign mem_valid_b = (mem_valid_rv & local_mem) | mem_valid_axi; 
-assign mem_addr_b  = mem_valid_axi ? mem_addr_axi  : mem_addr_b_32;
+assign dc_mem_grant  = dc_mem_valid & ~mem_valid_b;
+assign dma_mem_grant = dma_mem_valid & ~mem_valid_b & ~dc_mem_valid;
+
+assign mem_valid_b = (mem_valid_rv & local_mem & ~mem_ready_rv_data) | mem_valid_axi; 
+assign mem_addr_b  = mem_valid_axi ? mem_addr_axi  : dc_mem_grant ? dc_mem_addr : dma_mem_grant ? dma_mem_addr : mem_addr_b_32;
 assign mem_wdata_b = mem_valid_axi ? mem_wdata_axi : mem_wdata_rv;
 assign mem_wstrb_b = mem_valid_axi ? mem_wstrb_axi : |mem_wstrb_rv;
 
@@ -324,13 +365,18 @@ Register #(
   .Reset  (clk_ctrl_rst_high),
   .Set    (1'b0),
   .Enable (1'b1),
-  .In     (mem_valid_b),
+  .In     (mem_valid_b & ~mem_ready_rv_data),
   .Out    (mem_ready_rv_data));
 
 `else
 
+assign icache_event = 4'h0;
+
 assign local_mem = is_array & mem_addr_xy == HsrcId;
 
+assign dc_mem_grant  = dc_mem_valid & ~mem_valid_b;
+assign dma_mem_grant = dma_mem_valid & ~mem_valid_b & ~dc_mem_valid;
+
 assign mem_rdata_a = mem_rdata_data_a;
 assign mem_valid_data_a = mem_valid_a;
 assign mem_wstrb_data_a = mem_wstrb_a & mem_valid_a;
@@ -338,8 +384,9 @@ assign mem_wstrb_data_a = mem_wstrb_a & mem_valid_a;
 assign mem_ready_rv = mem_ready_local_rv | mem_ready_outsi_rv;
 assign mem_rdata_rv = local_mem_spy ? mem_rdata_data_b : mem_rdata_outsi_rv;
 
-assign mem_valid_b = (mem_valid_rv & local_mem_spy) | mem_valid_axi; 
-assign mem_addr_b  = mem_valid_axi ? mem_addr_axi  : {20'h0,mem_addr_b_32[OFFSET_SZ-1:0]};
+assign mem_valid_b = (mem_valid_rv & local_mem_spy & ~mem_ready_local_rv) | mem_valid_axi; 
+assign mem_addr_b  = mem_valid_axi ? mem_addr_axi  : dc_mem_grant ? {20'h0,dc_mem_addr[OFFSET_SZ-1:0]} :
+                     dma_mem_grant ? dma_mem_addr : {20'h0,mem_addr_b_32[OFFSET_SZ-1:0]};
 assign mem_wdata_b = mem_valid_axi ? mem_wdata_axi : mem_wdata_rv;
 assign mem_wstrb_b = mem_valid_axi ? mem_wstrb_axi : |mem_wstrb_rv & mem_valid_b;
 
@@ -350,7 +397,7 @@ Register #(
   .Reset  (~clk_ctrl_rst_low),
   .Set    (1'b0),
   .Enable (1'b1),
-  .In     (mem_valid_rv & local_mem_spy),
+  .In     (mem_valid_rv & local_mem_spy & ~mem_ready_local_rv),
   .Out    (mem_ready_local_rv));
 
 assign stream_out_TDATA      = stream_out_TDATA_int;
@@ -369,7 +416,7 @@ assign stream_out_TREADY_int = stream_out_TREADY;
 */
 
 logic [31:0] mem_addr_a_short;
-assign mem_addr_a_short = {20'h0,mem_addr_a[OFFSET_SZ-1:0]};
+assign mem_addr_a_short = mem_xa_a ? mem_addr_a : {20'h0,mem_addr_a[OFFSET_SZ-1:0]};
 
 
 DPRAM #(
@@ -386,45 +433,75 @@ DPRAM #(
   .dout  ({mem_rdata_data_a, mem_rdata_data_b}));  
 
 
-/* PICORV instantiation */
-
-picorv32#(
-   .ENABLE_PCPI       (1'b1),
-   .COMPRESSED_ISA    (1'b1),
-   .ENABLE_FAST_MUL   (1'b1),
-   .ENABLE_DIV        (1'b1),
-   .ENABLE_COUNTERS   (1'b1),
-   .ENABLE_COUNTERS64 (1'b1),
-   .BARREL_SHIFTER    (1'b1)
-) picorv32 (
-   .clk        (clk_ctrl),
-   .resetn     (clk_ctrl_rst_low && rvRstN),
-   .trap       ( ),
-   //- Simple memory interface
-   .mem_valid  (mem_valid_rv),  // Output
-   .mem_instr  (mem_instr_rv),  // Output
-   .mem_ready  (mem_ready_rv),  // Input
-   .mem_addr   (mem_addr_rv),   // Output
-   .mem_wdata  (mem_wdata_rv),  // Output
-   .mem_wstrb  (mem_wstrb_rv),  // Output
-   .mem_rdata  (mem_rdata_rv),  // Input
-   //- Pico Co-Processor Interface (PCPI)
-   .pcpi_valid (pcpi_valid),
-   .pcpi_insn  (pcpi_insn),
-   .pcpi_rs1   (pcpi_rs1),
-   .pcpi_rs2   (pcpi_rs2),
-   .pcpi_wr    (pcpi_wr),
-   .pcpi_rd    (pcpi_rd),
-   .pcpi_wait  (pcpi_wait),
-   .pcpi_ready (pcpi_ready)
-);
+/* Core slot: native memory bus + PCPI */
+
+generate
+if (CORE == 1) begin : pipe
+   rv32im_pipe rv32im_pipe (
+      .clk        (clk_ctrl),
+      .resetn     (clk_ctrl_rst_low && rvRstN),
+      .trap       ( ),
+      //- Simple memory interface
+      .mem_valid  (mem_valid_rv),  // Output
+      .mem_instr  (mem_instr_rv),  // Output
+      .mem_ready  (mem_ready_rv),  // Input
+      .mem_addr   (mem_addr_rv),   // Output
+      .mem_wdata  (mem_wdata_rv),  // Output
+      .mem_wstrb  (mem_wstrb_rv),  // Output
+      .mem_rdata  (mem_rdata_rv),  // Input
+      //- Pico Co-Processor Interface (PCPI)
+      .pcpi_valid (pcpi_valid),
+      .pcpi_insn  (pcpi_insn),
+      .pcpi_rs1   (pcpi_rs1),
+      .pcpi_rs2   (pcpi_rs2),
+      .pcpi_wr    (pcpi_wr),
+      .pcpi_rd    (pcpi_rd),
+      .pcpi_wait  (pcpi_wait),
+      .pcpi_ready (pcpi_ready)
+   );
+end else begin : pico
+   picorv32#(
+      .ENABLE_PCPI       (1'b1),
+      .COMPRESSED_ISA    (1'b1),
+      .ENABLE_FAST_MUL   (1'b1),
+      .ENABLE_DIV        (1'b1),
+      .ENABLE_COUNTERS   (1'b1),
+      .ENABLE_COUNTERS64 (1'b1),
+      .BARREL_SHIFTER    (1'b1)
+   ) picorv32 (
+      .clk        (clk_ctrl),
+      .resetn     (clk_ctrl_rst_low && rvRstN),
+      .trap       ( ),
+      //- Simple memory interface
+      .mem_valid  (mem_valid_rv),  // Output
+      .mem_instr  (mem_instr_rv),  // Output
+      .mem_ready  (mem_ready_rv),  // Input
+      .mem_addr   (mem_addr_rv),   // Output
+      .mem_wdata  (mem_wdata_rv),  // Output
+      .mem_wstrb  (mem_wstrb_rv),  // Output
+      .mem_rdata  (mem_rdata_rv),  // Input
+      //- Pico Co-Processor Interface (PCPI)
+      .pcpi_valid (pcpi_valid),
+      .pcpi_insn  (pcpi_insn),
+      .pcpi_rs1   (pcpi_rs1),
+      .pcpi_rs2   (pcpi_rs2),
+      .pcpi_wr    (pcpi_wr),
+      .pcpi_rd    (pcpi_rd),
+      .pcpi_wait  (pcpi_wait),
+      .pcpi_ready (pcpi_ready)
+   );
+end
+endgenerate
 
 
 //- LPGG: The memory  and Queue managers
 qISAExtension#(
    .NOC_BUFFER_ADDR_W (NOC_BUFFER_ADDR_W),
    .OFFSET_SZ         (OFFSET_SZ),
-   .XY_SZ             (XY_SZ)
+   .XY_SZ             (XY_SZ),
+   .MEM_SZ            (MEM_SZ),
+   .DC_LINES          (`DCACHE_LINES),
+   .DC_WAYS           (`DCACHE_WAYS)
 ) qISAExtension_inst (
    //- Clock and reset
    .clk_ctrl         (clk_ctrl),
@@ -433,6 +510,7 @@ qISAExtension#(
    .clk_line_rst_low (clk_line_rst_low),
    .clk_line_rst_high (clk_line_rst_high),
    .clk_ctrl_rst_high (clk_ctrl_rst_high),
+   .stats_rst_low    (clk_ctrl_rst_low),
    //- Tile identification
    .HsrcId           (HsrcId),
    //- NOC interface
@@ -452,6 +530,7 @@ qISAExtension#(
    //- Port A : Memory manager (clk_line)
    .mem_valid_a       (mem_valid_a), //- Output
    .mem_addr_a        (mem_addr_a),  //- Output
+   .mem_xa_a          (mem_xa_a),    //- Output
    .mem_wdata_a       (mem_wdata_a), //- Output
    .mem_wstrb_a       (mem_wstrb_a), //- Output
    .mem_rdata_a       (mem_rdata_a), //- Input
@@ -463,15 +542,60 @@ qISAExtension#(
    .mem_wdata_rv      (mem_wdata_rv),       //- Input
    .mem_wstrb_rv      (|mem_wstrb_rv),      //- Input
    .mem_rdata_rv      (mem_rdata_outsi_rv), //- Output
+   //- Send DMA
+   .dma_mem_valid     (dma_mem_valid),
+   .dma_mem_addr      (dma_mem_addr),
+   .dma_mem_grant     (dma_mem_grant),
+   .dma_mem_rdata     (mem_rdata_data_b),
+   //- Remote data cache
+   .dc_mem_valid      (dc_mem_valid),
+   .dc_mem_addr       (dc_mem_addr),
+   .dc_mem_grant      (dc_mem_grant),
+   .dc_mem_rdata      (mem_rdata_data_b),
+   //- Statistics
+   .stats_sel_axi     (stats_sel),
+   .stats_dout_axi    (stats_dout),
+   .stat_event        (icache_event),
+   //- Barrier network
+   .barrier_member    (barrier_member),
+   .barrier_sense     (barrier_sense),
+   .barrier_arrive    (barrier_arrive),
    //- PCPI Processor Interface
    .pcpi_valid        (pcpi_valid),
    .pcpi_insn         (pcpi_insn),
    .pcpi_rs1          (pcpi_rs1),
    .pcpi_rs2          (pcpi_rs2),
-   .pcpi_wr           (pcpi_wr),
-   .pcpi_rd           (pcpi_rd),
-   .pcpi_wait         (pcpi_wait),
-   .pcpi_ready        (pcpi_ready));
+   .pcpi_wr           (pcpi_wr_mq),
+   .pcpi_rd           (pcpi_rd_mq),
+   .pcpi_wait         (pcpi_wait_mq),
+   .pcpi_ready        (pcpi_ready_mq));
+
+//- Each coprocessor only answers its own opcode
+generate
+if (FPU) begin : fpu
+   fpu_pcpi fpu_pcpi(
+      .clk_ctrl         (clk_ctrl),
+      .clk_ctrl_rst_low (clk_ctrl_rst_low && rvRstN),
+      .pcpi_valid       (pcpi_valid),
+      .pcpi_insn        (pcpi_insn),
+      .pcpi_rs1         (pcpi_rs1),
+      .pcpi_rs2         (pcpi_rs2),
+      .pcpi_wr          (pcpi_wr_fp),
+      .pcpi_rd          (pcpi_rd_fp),
+      .pcpi_wait        (pcpi_wait_fp),
+      .pcpi_ready       (pcpi_ready_fp));
+end else begin : no_fpu
+   assign pcpi_wr_fp    = 1'b0;
+   assign pcpi_rd_fp    = 32'h0;
+   assign pcpi_wait_fp  = 1'b0;
+   assign pcpi_ready_fp = 1'b0;
+end
+endgenerate
+
+assign pcpi_wr    = pcpi_wr_mq | pcpi_wr_fp;
+assign pcpi_rd    = pcpi_ready_fp ? pcpi_rd_fp : pcpi_rd_mq;
+assign pcpi_wait  = pcpi_wait_mq | pcpi_wait_fp;
+assign pcpi_ready = pcpi_ready_mq | pcpi_ready_fp;
 
 // In qISAExtension or PCPI handler
 always @(posedge clk_ctrl) begin
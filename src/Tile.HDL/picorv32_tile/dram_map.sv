@@ -0,0 +1,72 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+
+/////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : DRAM tile of an address
+// File        : dram_map.sv
+// Notes       :
+//  - With DRAM_TILES tiles the addresses are interleaved every
+//    2**DRAM_IL bytes. DRAM tile k sits below column
+//    k*DRAM_COLS.
+//  - Packets to the DRAM row (x_dest == X_DRAM) get the y of
+//    the tile that holds addr, other packets keep y_dest.
+////////////////////////////////////////////////////////////////
+
+`timescale 1 ps / 1 ps
+`include "global_defines.sv"
+
+module dram_map#(
+   parameter XY_SZ = 3
+)(
+   input  logic [XY_SZ-1:0] x_dest,
+   input  logic [XY_SZ-1:0] y_dest,
+   input  logic      [31:0] addr,   //- Byte address
+   output logic [XY_SZ-1:0] y_map
+);
+
+`ifdef DDR4_CTRL
+
+localparam [XY_SZ-1:0] X_DRAM = `X_DRAM;
+localparam DRAM_TILES = `DRAM_TILES;
+localparam DRAM_COLS  = `DRAM_COLS;
+localparam DRAM_IL    = `DRAM_IL;
+
+generate
+if (DRAM_TILES > 1) begin : interleave
+   logic [$clog2(DRAM_TILES)-1:0] ch;
+   assign ch    = addr[DRAM_IL +: $clog2(DRAM_TILES)];
+   assign y_map = x_dest == X_DRAM ? ch*DRAM_COLS : y_dest;
+end else begin : single
+   assign y_map = y_dest;
+end
+endgenerate
+
+`else
+
+assign y_map = y_dest;
+
+`endif
+
+endmodule
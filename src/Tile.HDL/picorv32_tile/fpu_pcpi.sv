@@ -0,0 +1,243 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+/////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Double precision unit on the PCPI port
+// File        : fpu_pcpi.sv
+// Notes       :
+//  - Opcode custom-2 (0x5B), funct3 selects the instruction.
+//    A double is a register pair: rs1 low word, rs2 high word.
+//      0 fpA(lo, hi)   : first operand
+//      1 fpAdd(lo, hi) : issue A + {hi,lo}
+//      2 fpSub(lo, hi) : issue A - {hi,lo}
+//      3 fpMul(lo, hi) : issue A * {hi,lo}
+//      4 fpRes(lo)     : low word of the oldest result
+//      5 fpResH(hi)    : high word of the oldest result, pops it
+//      6 fpStat(n)     : operations issued and not popped
+//  - Issue does not wait for the result: up to DEPTH
+//    operations in flight, results are popped in issue
+//    order. fpAdd/fpSub/fpMul wait only when DEPTH results
+//    are pending, fpRes/fpResH wait for the result.
+//  - FP_adder_64_13cc and FP_multiplier_64_10cc take an
+//    operation per cycle. Each keeps the result slots of
+//    its operations in a FIFO (fixed latency, in order).
+////////////////////////////////////////////////////////////////
+
+`timescale 1 ps / 1 ps
+
+module fpu_pcpi#(
+   parameter DEPTH = 8
+)(
+   input  logic        clk_ctrl,
+   input  logic        clk_ctrl_rst_low,
+   //---Processor Interface---//
+   input  logic        pcpi_valid,
+   input  logic [31:0] pcpi_insn,
+   input  logic [31:0] pcpi_rs1,
+   input  logic [31:0] pcpi_rs2,
+   output logic        pcpi_wr,
+   output logic [31:0] pcpi_rd,
+   output logic        pcpi_wait,
+   output logic        pcpi_ready
+);
+
+localparam [6:0] XCUSTOM_FP = 7'h5B;
+
+localparam [2:0] FP_A    = 3'd0;
+localparam [2:0] FP_ADD  = 3'd1;
+localparam [2:0] FP_SUB  = 3'd2;
+localparam [2:0] FP_MUL  = 3'd3;
+localparam [2:0] FP_RES  = 3'd4;
+localparam [2:0] FP_RESH = 3'd5;
+localparam [2:0] FP_STAT = 3'd6;
+
+localparam F_IDLE = 1'b0;
+localparam F_DONE = 1'b1;
+
+localparam SLOT_W = $clog2(DEPTH);
+
+logic              state;
+logic              next_state;
+logic              inst_valid;
+logic        [2:0] func;
+
+logic       [63:0] op_a;
+logic       [63:0] op_b;
+logic       [31:0] rd_reg;
+logic       [31:0] next_rd_reg;
+logic              wr_reg;
+logic              next_wr_reg;
+
+//- Results, popped in issue order
+logic       [63:0] res       [0:DEPTH-1];
+logic  [DEPTH-1:0] res_valid;
+logic [SLOT_W-1:0] head;
+logic [SLOT_W-1:0] tail;
+logic   [SLOT_W:0] count;
+
+logic              issue_add;
+logic              issue_mul;
+logic              pop;
+
+//- Result slots of the operations in each unit
+logic [SLOT_W-1:0] add_slot  [0:DEPTH-1];
+logic [SLOT_W-1:0] add_wr;
+logic [SLOT_W-1:0] add_rd;
+logic [SLOT_W-1:0] mul_slot  [0:DEPTH-1];
+logic [SLOT_W-1:0] mul_wr;
+logic [SLOT_W-1:0] mul_rd;
+
+logic       [63:0] add_out;
+logic              add_done;
+logic       [63:0] mul_out;
+logic              mul_done;
+
+assign inst_valid = pcpi_valid & pcpi_insn[6:0] == XCUSTOM_FP & state == F_IDLE;
+assign func       = pcpi_insn[14:12];
+
+assign op_b = {pcpi_rs2[31] ^ (func == FP_SUB), pcpi_rs2[30:0], pcpi_rs1};
+
+always @( * ) begin
+   next_state  = state;
+   next_rd_reg = rd_reg;
+   next_wr_reg = 1'b0;
+
+   pcpi_wait  = 1'b0;
+   pcpi_ready = 1'b0;
+   pcpi_wr    = 1'b0;
+   pcpi_rd    = 32'h0;
+
+   issue_add = 1'b0;
+   issue_mul = 1'b0;
+   pop       = 1'b0;
+
+   case (state)
+      F_IDLE: begin
+         if (inst_valid) begin
+            case (func)
+               FP_A: next_state = F_DONE;
+               FP_ADD, FP_SUB, FP_MUL: begin
+                  if (count < DEPTH) begin
+                     issue_add  = func != FP_MUL;
+                     issue_mul  = func == FP_MUL;
+                     next_state = F_DONE;
+                  end else pcpi_wait = 1'b1;
+               end
+               FP_RES, FP_RESH: begin
+                  if (res_valid[head]) begin
+                     next_rd_reg = func == FP_RES ? res[head][31:0] : res[head][63:32];
+                     next_wr_reg = 1'b1;
+                     pop         = func == FP_RESH;
+                     next_state  = F_DONE;
+                  end else pcpi_wait = 1'b1;
+               end
+               FP_STAT: begin
+                  next_rd_reg = count;
+                  next_wr_reg = 1'b1;
+                  next_state  = F_DONE;
+               end
+               default: ;
+            endcase
+         end
+      end
+      F_DONE: begin
+         pcpi_ready = 1'b1;
+         pcpi_wr    = wr_reg;
+         pcpi_rd    = rd_reg;
+         next_state = F_IDLE;
+      end
+   endcase
+end
+
+always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
+   if (~clk_ctrl_rst_low) begin
+      state     <= F_IDLE;
+      rd_reg    <= 'h0;
+      wr_reg    <= 1'b0;
+      op_a      <= 'h0;
+      res_valid <= 'h0;
+      head      <= 'h0;
+      tail      <= 'h0;
+      count     <= 'h0;
+      add_wr    <= 'h0;
+      add_rd    <= 'h0;
+      mul_wr    <= 'h0;
+      mul_rd    <= 'h0;
+   end else begin
+      state  <= next_state;
+      rd_reg <= next_rd_reg;
+      wr_reg <= next_wr_reg;
+
+      if (inst_valid & func == FP_A) op_a <= {pcpi_rs2, pcpi_rs1};
+
+      //- Issue: the next slot goes with the operation
+      if (issue_add) begin
+         add_slot[add_wr] <= tail;
+         add_wr           <= add_wr + 'h1;
+      end
+      if (issue_mul) begin
+         mul_slot[mul_wr] <= tail;
+         mul_wr           <= mul_wr + 'h1;
+      end
+      if (issue_add | issue_mul) tail <= tail + 'h1;
+      count <= count + ((issue_add | issue_mul) ? 'h1 : 'h0) - (pop ? 'h1 : 'h0);
+
+      //- Completion
+      if (add_done) begin
+         res[add_slot[add_rd]]       <= add_out;
+         res_valid[add_slot[add_rd]] <= 1'b1;
+         add_rd                      <= add_rd + 'h1;
+      end
+      if (mul_done) begin
+         res[mul_slot[mul_rd]]       <= mul_out;
+         res_valid[mul_slot[mul_rd]] <= 1'b1;
+         mul_rd                      <= mul_rd + 'h1;
+      end
+
+      if (pop) begin
+         res_valid[head] <= 1'b0;
+         head            <= head + 'h1;
+      end
+   end
+end
+
+FP_adder_64_13cc fp_adder (
+   .clock      (clk_ctrl),
+   .reset      (~clk_ctrl_rst_low),
+   .in_valid   (issue_add),
+   .in_data_0  (op_a),
+   .in_data_1  (op_b),
+   .out_data   (add_out),
+   .out_ready  (add_done));
+
+FP_multiplier_64_10cc fp_multiplier (
+   .clock      (clk_ctrl),
+   .reset      (~clk_ctrl_rst_low),
+   .in_valid   (issue_mul),
+   .in_data_0  (op_a),
+   .in_data_1  (op_b),
+   .out_data   (mul_out),
+   .out_ready  (mul_done));
+
+endmodule
@@ -27,6 +27,10 @@
 // Description : Instruction memory for picorv32.  
 // File        : instr_mem.sv
 // Notes       :
+//  - Set-associative cache (sa_icache). Size and ways are
+//    set with icache_kb and icache_ways in gen_mosaic.pm
+//  - icache_prefetch lines after a miss are prefetched into
+//    a stream buffer (icache_stream_buffer)
 ////////////////////////////////////////////////
 
 `timescale 1 ps / 1 ps
@@ -36,7 +40,9 @@ module instr_mem#(
    parameter CPU_BUS_SZ   = 32,
    parameter MEM_BUS_SZ   = 512,
    parameter OFFSET_SZ    = 12,
-   parameter CACHE_LINES  = 8   // number of cache lines
+   parameter CACHE_KB     = 4,  // 1 to 16 KB
+   parameter CACHE_WAYS   = 2,  // 1, 2, 4 or 8 ways
+   parameter PREFETCH     = 2   // Lines prefetched after a miss, 0 disables it
 )(
    input logic       clk_ctrl,
    input logic       clk_ctrl_rst_low,
@@ -63,7 +69,12 @@ module instr_mem#(
    input logic [31:0] mem_addr,
    input logic [31:0] mem_wdata,
    input logic        mem_wstrb,
-   input logic        mem_valid
+   input logic        mem_valid,
+   //- Statistics
+   output logic       stat_hit,
+   output logic       stat_miss,
+   output logic       stat_pf_useful,
+   output logic       stat_pf_useless
 );
 
 localparam [2:0] MLOAD   = 3'd6;  //- A far-away-galaxy is reading from this Tile. 
@@ -80,6 +91,7 @@ localparam [2:0] Y_DRAM = `Y_DRAM;
 
 //- Memory request (Cache->Memory)
 logic   [CPU_BUS_SZ-1:0] mem_req_addr;  //request byte addr
+logic   [CPU_BUS_SZ-1:0] mem_req_addr_reg;
 
 /* For scratchpad
 logic [31:0] mem_req_addr_32b;
@@ -97,7 +109,7 @@ logic [31:0] mem_req_addr_2;
 
 assign cpu_req_addr_norm = cpu_req_addr - 'h28000;
 
-assign mem_req_addr_0 = {mem_req_addr[31:6],6'h0};      //- Align
+assign mem_req_addr_0 = {mem_req_addr_reg[31:6],6'h0};  //- Align
 //assign mem_req_addr_1 = mem_req_addr_0 - 'h28000;     //- Remove offset. 
 assign mem_req_addr_1 = mem_req_addr_0;                 
 assign mem_req_addr_2 = (mem_req_addr_0 >> 2) + 'h1000; //- In 32b words. 
@@ -106,6 +118,14 @@ assign mem_req_addr_2 = (mem_req_addr_0 >> 2) + 'h1000; //- In 32b words.
 logic   [MEM_BUS_SZ-1:0] mem_req_data;  //128-output logic request data (used when write)
 logic                    mem_req_rw;    // request type : 0=read, 1=write
 logic                    mem_req_valid; // request is valid
+logic                    mem_req_ready; // request taken by the NoC encoder
+
+//- Between the cache and the stream buffer
+logic   [CPU_BUS_SZ-1:0] cache_req_addr;
+logic                    cache_req_valid;
+logic                    cache_req_ready;
+logic   [MEM_BUS_SZ-1:0] cache_data;
+logic                    cache_data_ready;
 
 //- (Memory -> Cache)
 logic [MEM_BUS_SZ-1:0] mem_data_data;
@@ -143,36 +163,76 @@ logic [CPU_BUS_SZ-1:0] mem_data_data_array [0:15];
 // Cache
 //////////////////////////////
 
-dm_cache_fsm #(
+sa_icache #(
   .CPU_BUS_SZ (CPU_BUS_SZ),
-  .MEM_BUS_SZ (MEM_BUS_SZ)
-)dm_cache_fsm_inst(
+  .MEM_BUS_SZ (MEM_BUS_SZ),
+  .CACHE_KB   (CACHE_KB),
+  .WAYS       (CACHE_WAYS)
+)sa_icache_inst(
    .clk            (clk_ctrl),
    .rst            (~clk_ctrl_rst_low),
    //- CPU request (CPU -> Cache)
    .cpu_req_addr   (cpu_req_addr_norm), // 32-bit request addr
-   .cpu_req_data   (cpu_req_data),  // 32-bit request data (used when write)
-   .cpu_req_rw     (cpu_req_rw),    // request type : 0 = read, 1 = write 
-   .cpu_req_valid  (cpu_req_valid), // request is valid
-   .cpu_req_ready  (), // Output 
-   .cpu_req_id     (11'h0),           // Input not used here
-   .cpu_req_len    (8'h0),           // Input not used here
-   //- Memory response (Memory -> Cache)
-   .mem_data_data  (mem_data_data),
-   .mem_data_ready (mem_data_ready),
-   //- Memory request (Cache->Memory)
-   .mem_req_addr   (mem_req_addr),  // request byte addr
-   .mem_req_data   (mem_req_data),  // MEM_BUS_SZ.request data (used when write)
-   .mem_req_rw     (mem_req_rw),    // request type : 0=read, 1=write
-   .mem_req_valid  (mem_req_valid), // request is valid
-   .mem_req_id     (),           // Output not used here
-   .mem_req_len    (),           // Output not used here
+   .cpu_req_valid  (cpu_req_valid),     // request is valid
    //- Cache result (Cache->CPU)
-   .cpu_res_data   (cpu_res_data),  //32-bit data
-   .cpu_res_ready  (1'b1), //
-   .cpu_res_valid  (cpu_res_valid)  // result is ready
+   .cpu_res_data   (cpu_res_data),      // 32-bit data
+   .cpu_res_valid  (cpu_res_valid),     // result is ready
+   //- Memory request (Cache->Memory)
+   .mem_req_addr   (cache_req_addr),    // request byte addr
+   .mem_req_valid  (cache_req_valid),   // request is valid
+   .mem_req_ready  (cache_req_ready),   // request taken
+   //- Memory response (Memory -> Cache)
+   .mem_data_data  (cache_data),
+   .mem_data_ready (cache_data_ready),
+   //- Statistics
+   .stat_hit       (stat_hit),
+   .stat_miss      (stat_miss)
 );
 
+generate
+  if (PREFETCH > 0) begin : prefetch
+
+    icache_stream_buffer #(
+      .MEM_BUS_SZ (MEM_BUS_SZ),
+      .DEPTH      (PREFETCH)
+    ) icache_stream_buffer_inst (
+       .clk              (clk_ctrl),
+       .rst              (~clk_ctrl_rst_low),
+       //- Cache side
+       .cache_req_addr   (cache_req_addr),
+       .cache_req_valid  (cache_req_valid),
+       .cache_req_ready  (cache_req_ready),
+       .cache_data       (cache_data),
+       .cache_data_ready (cache_data_ready),
+       //- Memory side
+       .mem_req_addr     (mem_req_addr),
+       .mem_req_valid    (mem_req_valid),
+       .mem_req_ready    (mem_req_ready),
+       .mem_data_data    (mem_data_data),
+       .mem_data_ready   (mem_data_ready),
+       //- Statistics
+       .stat_useful      (stat_pf_useful),
+       .stat_useless     (stat_pf_useless)
+    );
+
+  end else begin : no_prefetch
+
+    assign mem_req_addr     = cache_req_addr;
+    assign mem_req_valid    = cache_req_valid;
+    assign cache_req_ready  = mem_req_ready;
+    assign cache_data       = mem_data_data;
+    assign cache_data_ready = mem_data_ready;
+    assign stat_pf_useful   = 1'b0;
+    assign stat_pf_useless  = 1'b0;
+
+  end
+endgenerate
+
+//- Instructions are never written back
+assign mem_req_rw   = 1'b0;
+assign mem_req_data = 'h0;
+assign mem_req_ready = (state_in == 0) & stream_out_TREADY_int;
+
 
 //////////////////
 // NOC ENCODER
@@ -188,6 +248,14 @@ always @(posedge clk_ctrl) begin
   end
 end
 
+//- The request changes once it is taken (prefetch), keep its address
+always @(posedge clk_ctrl) begin
+  if (~clk_ctrl_rst_low)
+    mem_req_addr_reg <= 'h0;
+  else if (mem_req_valid & mem_req_ready)
+    mem_req_addr_reg <= mem_req_addr;
+end
+
 
 always @(*) begin
    case(counter_in)
@@ -280,7 +348,17 @@ end
 
 assign pkt_code = mem_req_rw ? MPUT : MGET;
 assign pkt_sz_code = mem_req_rw ? 4'b0100 : 4'b0001;
-assign header = {3'b0,1'b1,pkt_code,1'b0,HsrcId,2'b00,4'b0100,pkt_sz_code,2'b0,Y_DRAM,X_DRAM};
+logic [2:0] y_dram; //- DRAM tile of the line
+
+//- The header goes out in state 0, before mem_req_addr_reg takes the
+//  request: map the live line address
+dram_map dram_map_line (
+   .x_dest (X_DRAM),
+   .y_dest (Y_DRAM),
+   .addr   ({mem_req_addr[31:6],6'h0}),
+   .y_map  (y_dram));
+
+assign header = {3'b0,1'b1,pkt_code,1'b0,HsrcId,2'b00,4'b0100,pkt_sz_code,2'b0,y_dram,X_DRAM};
 
 /* Like a NoC decoder */
 
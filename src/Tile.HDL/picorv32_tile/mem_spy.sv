@@ -26,6 +26,12 @@
 // Date        : Sept 29 2022
 // Description : Spy processor-memory interface
 // File        : mem_spy.sv
+// Notes       :
+//  - DC_LINES > 0 adds a read-only cache for remote
+//    loads (mq_dcache). A miss requests the 8-word line
+//    with a long MGET whose response lands in the line
+//    slot of local memory; hits read the slot through
+//    data memory port B.
 ////////////////////////////////////////////////
 
 `timescale 1 ps/ 1 ps
@@ -33,7 +39,9 @@
 module mem_spy#(
    parameter NOC_BUFFER_ADDR_W = 8,
    parameter XY_SZ = 3,
-   parameter OFFSET_SZ=12
+   parameter OFFSET_SZ=12,
+   parameter DC_LINES = 0,  //- Remote data cache lines, 0: no cache
+   parameter DC_WAYS  = 2
 )(
    //---Clock and Reset---//
    input  logic       clk_ctrl,
@@ -49,6 +57,23 @@ module mem_spy#(
    input  logic        mem_valid_rv,
    input  logic        unblock,
    output logic        spy_idle,
+   output logic  [1:0] stat_inst,   //- {mStore, mLoad} issued
+   output logic  [1:0] stat_stall,  //- {mStore, mLoad} waiting
+   output logic  [1:0] stat_dc,     //- Data cache {miss, hit}
+   //- Remote data cache
+   input  logic        dc_cfg,
+   input  logic        dc_inval,
+   input  logic [31:0] dc_cfg_base,
+   input  logic        dc_cfg_en,
+   input  logic [31:0] mem_addr_a,      //- NoC writes to local memory
+   input  logic        mem_reply_done,
+   output logic        dc_fill_done,    //- The reply is a line fill, not an mGet
+   output logic        dc_mem_valid,    //- Line slot read, port B
+   output logic [31:0] dc_mem_addr,
+   input  logic        dc_mem_grant,
+   input  logic [31:0] dc_mem_rdata,
+   output logic        dc_sel,          //- mem_rdata_rv comes from dc_rdata
+   output logic [31:0] dc_rdata,
    input logic         local_mem,
    input  logic        stream_out_TREADY,
    output logic        stream_out_TVALID,
@@ -57,11 +82,17 @@ module mem_spy#(
    output logic        stream_out_TLAST
 );
 
-localparam [2:0] MIO_IDLE  = 3'd0; 
-localparam [2:0] MIO_SEND  = 3'd1; 
-localparam [2:0] MIO_SEND2 = 3'd4; 
-localparam [2:0] MIO_WAIT  = 3'd2; 
-localparam [2:0] MIO_READY = 3'd3; 
+localparam [3:0] MIO_IDLE  = 4'd0; 
+localparam [3:0] MIO_SEND  = 4'd1; 
+localparam [3:0] MIO_SEND2 = 4'd4; 
+localparam [3:0] MIO_WAIT  = 4'd2; 
+localparam [3:0] MIO_READY = 4'd3; 
+localparam [3:0] DC_SEND3  = 4'd5; //- Line fill: local slot address
+localparam [3:0] DC_FILL   = 4'd6; //- Line fill: wait for the MGET response
+localparam [3:0] DC_HIT    = 4'd7; //- Read the slot (port B)
+localparam [3:0] DC_HIT_RD = 4'd8; 
+
+localparam LINE_W = 3;             //- 8-word lines
 
 localparam [2:0] MPUT    = 3'd4;  //- A far-away-galaxy is writing to this Tile
 localparam [2:0] MGET    = 3'd5;  //- A far away galaxy is reading from this Tile.
@@ -75,10 +106,23 @@ localparam [2:0] QM      = 3'd3;  //- This Tile is
 //****************************
 
 //- FSMs
-logic [2:0] currentState4;
-logic [2:0] nextState4;
+logic [3:0] currentState4;
+logic [3:0] nextState4;
 logic next_mem_ready_rv;
 
+//- Remote data cache
+logic        dc_en;
+logic        dc_hit;
+logic [31:0] dc_hit_addr;
+logic [31:0] dc_fill_addr;
+logic        dc_miss;       //- Lookup missed, the victim is chosen
+logic        dc_fill;       //- The line arrived
+logic        dc_touch;
+logic        dc_drop;
+logic        dc_line;       //- The request is a line fill
+logic        next_dc_line;
+logic [31:0] dc_header;
+
 logic stream_out_TVALID_int;
 logic   [31:0] stream_out_TDATA_int; 
 logic stream_out_TLAST_int;
@@ -96,18 +140,38 @@ always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
    if (~clk_ctrl_rst_low) begin
       currentState4 <= MIO_IDLE;
       mem_ready_rv <= 1'b0;
+      dc_line      <= 1'b0;
+      dc_sel       <= 1'b0;
+      dc_rdata     <= 'h0;
    end else begin
       currentState4 <= nextState4;
       mem_ready_rv <= next_mem_ready_rv;
+      dc_line      <= next_dc_line;
+      dc_sel       <= currentState4 == DC_HIT_RD;
+      if (currentState4 == DC_HIT_RD) dc_rdata <= dc_mem_rdata;
    end
 end
 
 assign spy_idle = currentState4 == MIO_IDLE; 
 
+//- Statistics: the processor waits from the request until mem_ready_rv
+logic [1:0] stat_class;
+assign stat_class = |mem_wstrb_rv ? 2'b10 : 2'b01;
+assign stat_inst  = currentState4 == MIO_IDLE & nextState4 != MIO_IDLE ? stat_class : 2'b00;
+assign stat_stall = currentState4 != MIO_IDLE | nextState4 != MIO_IDLE ? stat_class : 2'b00;
+assign stat_dc    = {dc_miss, currentState4 == MIO_IDLE & nextState4 == DC_HIT};
+
 always @( * ) begin
    //- State
    nextState4 = currentState4;
    next_mem_ready_rv = mem_ready_rv;
+   next_dc_line = dc_line;
+
+   dc_miss      = 1'b0;
+   dc_fill      = 1'b0;
+   dc_touch     = 1'b0;
+   dc_drop      = 1'b0;
+   dc_mem_valid = 1'b0;
 
    stream_out_TVALID_int = 1'b0;
    stream_out_TDATA_int  = 'h0; 
@@ -116,9 +180,21 @@ always @( * ) begin
    case (currentState4)
       MIO_IDLE: begin //0
         next_mem_ready_rv = 1'b0;
+        next_dc_line = 1'b0;
         if (mem_valid_rv)
-          if (!local_mem && !mem_ready_rv)
-            nextState4 = MIO_SEND;
+          if (!local_mem && !mem_ready_rv) begin
+            if (dc_en & ~|mem_wstrb_rv) begin
+              if (dc_hit) nextState4 = DC_HIT;
+              else begin
+                dc_miss      = 1'b1;
+                next_dc_line = 1'b1;
+                nextState4   = MIO_SEND;
+              end
+            end else begin
+              dc_drop    = |mem_wstrb_rv; //- Stores invalidate the cached line
+              nextState4 = MIO_SEND;
+            end
+          end
       end
       MIO_SEND:begin //1
         next_mem_ready_rv = 1'b0;
@@ -126,18 +202,43 @@ always @( * ) begin
           nextState4 = MIO_SEND2;
         end
         stream_out_TVALID_int = 1'b1;
-        stream_out_TDATA_int  = mem_header; 
+        stream_out_TDATA_int  = dc_line ? dc_header : mem_header; 
         stream_out_TLAST_int = 1'b0;
       end
       MIO_SEND2:begin //4
         next_mem_ready_rv = 1'b0;
-        if (stream_out_TREADY_int) begin
-          nextState4 = MIO_WAIT;
+        stream_out_TVALID_int = 1'b1;
+        if (dc_line) begin //- Remote word address of the line
+          if (stream_out_TREADY_int) nextState4 = DC_SEND3;
+          stream_out_TDATA_int = {mem_addr_rv[31:LINE_W],{LINE_W{1'b0}}};
+          stream_out_TLAST_int = 1'b0;
+        end else begin
+          if (stream_out_TREADY_int) nextState4 = MIO_WAIT;
+          if (|mem_wstrb_rv) stream_out_TDATA_int  =  mem_wdata_rv;
+          else stream_out_TDATA_int  = 'h0;
+          stream_out_TLAST_int = 1'b1;
         end
+      end
+      DC_SEND3:begin //5 - The response goes to the slot of this tile
+        if (stream_out_TREADY_int) nextState4 = DC_FILL;
         stream_out_TVALID_int = 1'b1;
-        if (|mem_wstrb_rv) stream_out_TDATA_int  =  mem_wdata_rv;
-        else stream_out_TDATA_int  = 'h0;
-        stream_out_TLAST_int = 1'b1;
+        stream_out_TDATA_int  = {{(32-OFFSET_SZ-(2*XY_SZ)){1'b0}},HsrcId,dc_fill_addr[OFFSET_SZ-1:0]};
+        stream_out_TLAST_int  = 1'b1;
+      end
+      DC_FILL:begin //6
+        if (dc_fill_done) begin
+          dc_fill    = 1'b1;
+          nextState4 = DC_HIT;
+        end
+      end
+      DC_HIT:begin //7
+        dc_mem_valid = 1'b1;
+        if (dc_mem_grant) nextState4 = DC_HIT_RD;
+      end
+      DC_HIT_RD:begin //8 - The slot word is on dc_mem_rdata
+        dc_touch          = 1'b1;
+        next_mem_ready_rv = 1'b1;
+        nextState4        = MIO_IDLE;
       end
       MIO_WAIT:begin //2
         if (unblock) begin
@@ -186,4 +287,41 @@ assign mem_x_dest = mem_addr_rv[OFFSET_SZ+XY_SZ-1:OFFSET_SZ];
 assign mem_code   = |mem_wstrb_rv ? MSTORE : MLOAD;
 assign mem_header = {3'b0,mem_hl,mem_code,pt,HsrcId,mem_offset,mem_y_dest,mem_x_dest};
 
+//- Line fill: long MGET of 1 << LINE_W words, {remote address, local address}
+assign dc_header  = {2'b0,1'b0,1'b1,MGET,pt,HsrcId,2'b0,4'(LINE_W),4'h1,{(8-(2*XY_SZ)){1'b0}},mem_y_dest,mem_x_dest};
+
+assign dc_mem_addr  = dc_hit_addr;
+assign dc_fill_done = currentState4 == DC_FILL & mem_reply_done &
+                      mem_addr_a[OFFSET_SZ-1:0] == dc_fill_addr[OFFSET_SZ-1:0] + (1 << LINE_W) - 1;
+
+generate
+  if (DC_LINES > 0) begin : dcache
+    mq_dcache#(
+       .LINES  (DC_LINES),
+       .WAYS   (DC_WAYS),
+       .LINE_W (LINE_W)
+    ) mq_dcache(
+       .clk_ctrl         (clk_ctrl),
+       .clk_ctrl_rst_low (clk_ctrl_rst_low),
+       .cfg              (dc_cfg),
+       .cfg_base         (dc_cfg_base),
+       .cfg_en           (dc_cfg_en),
+       .inval            (dc_inval),
+       .dc_en            (dc_en),
+       .addr             (mem_addr_rv),
+       .hit              (dc_hit),
+       .hit_addr         (dc_hit_addr),
+       .miss             (dc_miss),
+       .fill             (dc_fill),
+       .touch            (dc_touch),
+       .drop             (dc_drop),
+       .fill_addr        (dc_fill_addr));
+  end else begin : no_dcache
+    assign dc_en        = 1'b0;
+    assign dc_hit       = 1'b0;
+    assign dc_hit_addr  = 'h0;
+    assign dc_fill_addr = 'h0;
+  end
+endgenerate
+
 endmodule
@@ -0,0 +1,154 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+/////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Tags of the read-only remote data cache
+// File        : mq_dcache.sv
+// Notes       :
+//  - The lines live in local data memory: dCache(base, 1)
+//    reserves LINES << LINE_W words starting at the word
+//    address base. Line l of way w of set s is at
+//    base + ((s*WAYS + w) << LINE_W).
+//  - Addresses are the word addresses of remote loads.
+//  - Tree pseudo-LRU replacement, invalid ways first.
+//  - Nothing keeps the lines coherent: dCacheInval() drops
+//    them all, a local store to a cached line drops it.
+////////////////////////////////////////////////////////////////
+
+`timescale 1 ps / 1 ps
+
+module mq_dcache#(
+   parameter LINES  = 32,
+   parameter WAYS   = 2,
+   parameter LINE_W = 3    //- log2 of the words per line
+)(
+   input  logic        clk_ctrl,
+   input  logic        clk_ctrl_rst_low,
+   //- Configuration
+   input  logic        cfg,          //- dCache(base, enable)
+   input  logic [31:0] cfg_base,
+   input  logic        cfg_en,
+   input  logic        inval,        //- dCacheInval()
+   output logic        dc_en,
+   //- Lookup
+   input  logic [31:0] addr,
+   output logic        hit,
+   output logic [31:0] hit_addr,     //- Local word address of addr
+   //- Updates
+   input  logic        miss,         //- Choose the victim of addr
+   input  logic        fill,         //- The victim holds the line of addr
+   input  logic        touch,        //- The hit way was used
+   input  logic        drop,         //- Invalidate the line of addr
+   output logic [31:0] fill_addr     //- Local word address of the victim line
+);
+
+localparam SETS   = LINES/WAYS;
+localparam SET_W  = SETS > 1 ? $clog2(SETS) : 1;
+localparam WAY_W  = WAYS > 1 ? $clog2(WAYS) : 1;
+localparam PLRU_W = WAYS > 1 ? WAYS-1 : 1;
+localparam TAG_W  = 32 - LINE_W - SET_W;
+
+logic [31:0]       dc_base;
+logic [WAYS-1:0]   valid [0:SETS-1];
+logic [TAG_W-1:0]  tag   [0:SETS-1][0:WAYS-1];
+logic [PLRU_W-1:0] plru  [0:SETS-1];
+
+logic [SET_W-1:0]  set;
+logic [TAG_W-1:0]  addr_tag;
+logic [WAYS-1:0]   way_hit;
+logic [WAY_W-1:0]  hit_way;
+logic [WAY_W-1:0]  victim;
+logic [WAY_W-1:0]  victim_reg;
+logic [PLRU_W-1:0] plru_upd;
+
+assign set      = addr[SET_W+LINE_W-1:LINE_W];
+assign addr_tag = addr[31:SET_W+LINE_W];
+
+always @( * ) begin
+   hit_way = 'h0;
+   for (int w=0; w<WAYS; w=w+1) begin
+      way_hit[w] = valid[set][w] & (tag[set][w] == addr_tag);
+      if (way_hit[w]) hit_way = w;
+   end
+end
+
+assign hit       = dc_en & |way_hit;
+assign hit_addr  = dc_base + ((((set*WAYS) + hit_way) << LINE_W) | addr[LINE_W-1:0]);
+assign fill_addr = dc_base + (((set*WAYS) + victim_reg) << LINE_W);
+
+//- Tree pseudo-LRU, same walk as sa_icache
+always @( * ) begin
+   int node;
+   victim = 'h0;
+   if (WAYS > 1) begin
+      node = 0;
+      for (int l=0; l<WAY_W; l=l+1)
+         node = 2*node + 1 + plru[set][node];
+      victim = node - (WAYS-1);
+      for (int w=WAYS-1; w>=0; w=w-1)
+         if (~valid[set][w]) victim = w;
+   end
+end
+
+always @( * ) begin
+   int node;
+   plru_upd = plru[set];
+   if (WAYS > 1) begin
+      node = 0;
+      for (int l=WAY_W-1; l>=0; l=l-1) begin
+         plru_upd[node] = ~hit_way[l];
+         node = 2*node + 1 + hit_way[l];
+      end
+   end
+end
+
+always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
+   if (~clk_ctrl_rst_low) begin
+      dc_en      <= 1'b0;
+      dc_base    <= 'h0;
+      victim_reg <= 'h0;
+      for (int s=0; s<SETS; s=s+1) begin
+         valid[s] <= 'h0;
+         plru[s]  <= 'h0;
+      end
+   end else begin
+      if (cfg) begin
+         dc_en   <= cfg_en;
+         dc_base <= cfg_base;
+      end
+      if (cfg | inval) begin
+         for (int s=0; s<SETS; s=s+1)
+            valid[s] <= 'h0;
+      end else if (fill) begin
+         valid[set][victim_reg] <= 1'b1;
+         tag[set][victim_reg]   <= addr_tag;
+      end else if (drop & hit) begin
+         valid[set][hit_way] <= 1'b0;
+      end
+      if (miss)  victim_reg <= victim;
+      if (touch) plru[set]  <= plru_upd;
+   end
+end
+
+endmodule
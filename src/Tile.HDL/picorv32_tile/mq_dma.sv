@@ -0,0 +1,235 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+/////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Send DMA. Reads a local array and sends it as
+//               long mPutX packets
+// File        : mq_dma.sv
+// Notes       :
+//  - mDmaA(local_addr, len) sets the source (word address) and
+//    the length in words. mDma(remote_addr, tile<<4|code) starts
+//    the transfer to the word address remote_addr in tile.
+//  - Packets are 1<<code words, the tail is sent in the largest
+//    packets that fit (power of two sizes).
+//  - Local memory is read through the processor port when the
+//    processor and the AXI bus do not use it.
+//  - A packet only starts when the processor has no long packet
+//    open in the same NoC buffer.
+////////////////////////////////////////////////////////////////
+
+`timescale 1 ps / 1 ps
+
+module mq_dma#(
+   parameter XY_SZ = 3
+)(
+   input  logic                 clk_ctrl,
+   input  logic                 clk_ctrl_rst_low,
+   input  logic [(XY_SZ*2)-1:0] HsrcId,
+   //- Configuration (PCPI)
+   input  logic                 cfg_src,     //- mDmaA
+   input  logic                 cfg_start,   //- mDma
+   input  logic          [31:0] cfg_rs1,
+   input  logic          [31:0] cfg_rs2,
+   output logic                 dma_busy,
+   output logic          [15:0] dma_remaining,
+   //- Local memory (read only)
+   output logic                 mem_valid,
+   output logic          [31:0] mem_addr,
+   input  logic                 mem_grant,   //- The read was issued this cycle
+   input  logic          [31:0] mem_rdata,   //- Valid the cycle after the grant
+   //- Outbound NoC buffer (shared with the PCPI)
+   input  logic                 pkt_grant,   //- A new packet can start
+   output logic                 pkt_owns,    //- A DMA packet is in progress
+   input  logic                 stream_out_TREADY,
+   output logic                 stream_out_TVALID,
+   output logic          [31:0] stream_out_TDATA,
+   output logic                 stream_out_TLAST
+);
+
+localparam [2:0] MPUT = 3'd4;
+
+localparam [2:0] D_IDLE = 3'd0;
+localparam [2:0] D_HDR1 = 3'd1; //- Long header
+localparam [2:0] D_HDR2 = 3'd2; //- Remote word address
+localparam [2:0] D_RD   = 3'd3; //- Read local memory
+localparam [2:0] D_PUSH = 3'd4; //- Push the word, read the next one
+
+logic  [2:0] state;
+logic  [2:0] next_state;
+logic [31:0] src;
+logic [31:0] next_src;
+logic [31:0] dst;
+logic [31:0] next_dst;
+logic [15:0] next_dma_remaining;
+logic [15:0] ctr;
+logic [15:0] next_ctr;
+logic  [3:0] code_max;
+logic  [3:0] next_code_max;
+logic        nt;            //- Non-temporal packets (rs2[31] of mDma)
+logic        next_nt;
+logic [XY_SZ-1:0] x_dest;
+logic [XY_SZ-1:0] next_x_dest;
+logic [XY_SZ-1:0] y_dest;
+logic [XY_SZ-1:0] next_y_dest;
+logic [31:0] hold;
+logic        inflight;
+logic        next_pkt_owns;
+
+logic  [3:0] rem_log2;
+logic  [3:0] chunk_code;
+logic [31:0] header;
+logic [XY_SZ-1:0] y_map;   //- y_dest, or the DRAM tile of dst
+logic [31:0] word;
+
+always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
+   if (~clk_ctrl_rst_low) begin
+      state         <= D_IDLE;
+      src           <= 'h0;
+      dst           <= 'h0;
+      dma_remaining <= 'h0;
+      ctr           <= 'h0;
+      code_max      <= 'h0;
+      nt            <= 1'b0;
+      x_dest        <= 'h0;
+      y_dest        <= 'h0;
+      hold          <= 'h0;
+      inflight      <= 1'b0;
+      pkt_owns      <= 1'b0;
+   end else begin
+      state         <= next_state;
+      src           <= next_src;
+      dst           <= next_dst;
+      dma_remaining <= next_dma_remaining;
+      ctr           <= next_ctr;
+      code_max      <= next_code_max;
+      nt            <= next_nt;
+      x_dest        <= next_x_dest;
+      y_dest        <= next_y_dest;
+      inflight      <= mem_valid & mem_grant;
+      pkt_owns      <= next_pkt_owns;
+      if (inflight) hold <= mem_rdata;
+   end
+end
+
+//- Largest power of two packet that fits in the remaining words
+always @( * ) begin
+   rem_log2 = 'h0;
+   for (int k=0; k<16; k=k+1)
+      if (dma_remaining[k]) rem_log2 = k;
+   chunk_code = rem_log2 < code_max ? rem_log2 : code_max;
+end
+
+dram_map#(
+   .XY_SZ (XY_SZ)
+) dram_map_dst (
+   .x_dest (x_dest),
+   .y_dest (y_dest),
+   .addr   ({dst[29:0],2'b00}),
+   .y_map  (y_map));
+
+assign header = {1'b0,nt,1'b1,1'b1,MPUT,1'b0,HsrcId,2'b0,4'h0,chunk_code,{(8-(2*XY_SZ)){1'b0}},y_map,x_dest};
+assign word   = inflight ? mem_rdata : hold;
+
+assign dma_busy = state != D_IDLE;
+assign mem_addr = src;
+
+always @( * ) begin
+   next_state         = state;
+   next_src           = src;
+   next_dst           = dst;
+   next_dma_remaining = dma_remaining;
+   next_ctr           = ctr;
+   next_code_max      = code_max;
+   next_nt            = nt;
+   next_x_dest        = x_dest;
+   next_y_dest        = y_dest;
+   next_pkt_owns      = pkt_owns;
+
+   mem_valid         = 1'b0;
+   stream_out_TVALID = 1'b0;
+   stream_out_TDATA  = 'h0;
+   stream_out_TLAST  = 1'b0;
+
+   case (state)
+      D_IDLE: begin
+         if (cfg_src) begin
+            next_src           = cfg_rs1;
+            next_dma_remaining = cfg_rs2[15:0];
+         end else if (cfg_start) begin
+            next_dst      = cfg_rs1;
+            next_code_max = cfg_rs2[3:0];
+            next_nt       = cfg_rs2[31];
+            next_x_dest   = cfg_rs2[XY_SZ+3:4];
+            next_y_dest   = cfg_rs2[(2*XY_SZ)+3:XY_SZ+4];
+            if (dma_remaining != 0)
+               next_state = D_HDR1;
+         end
+      end
+      D_HDR1: begin
+         if (pkt_grant) begin
+            stream_out_TVALID = 1'b1;
+            stream_out_TDATA  = header;
+            if (stream_out_TREADY) begin
+               next_pkt_owns = 1'b1;
+               next_ctr      = 16'h1 << chunk_code;
+               next_state    = D_HDR2;
+            end
+         end
+      end
+      D_HDR2: begin
+         stream_out_TVALID = 1'b1;
+         stream_out_TDATA  = dst;
+         if (stream_out_TREADY)
+            next_state = D_RD;
+      end
+      D_RD: begin
+         mem_valid = 1'b1;
+         if (mem_grant) begin
+            next_src   = src + 'h1;
+            next_state = D_PUSH;
+         end
+      end
+      D_PUSH: begin
+         stream_out_TVALID = 1'b1;
+         stream_out_TDATA  = word;
+         stream_out_TLAST  = ctr == 'h1;
+         if (stream_out_TREADY) begin
+            next_ctr           = ctr - 'h1;
+            next_dst           = dst + 'h1;
+            next_dma_remaining = dma_remaining - 'h1;
+            if (ctr == 'h1) begin //- End of packet
+               next_pkt_owns = 1'b0;
+               if (dma_remaining == 'h1) next_state = D_IDLE;
+               else                      next_state = D_HDR1;
+            end else begin //- Read the next word
+               mem_valid = 1'b1;
+               if (mem_grant) next_src = src + 'h1;
+               else           next_state = D_RD;
+            end
+         end
+      end
+   endcase
+end
+
+endmodule
@@ -0,0 +1,94 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+/////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Instruction and stall counters of the message
+//               queue instructions
+// File        : mq_stats.sv
+// Notes       :
+//  - Counter 2*c   : instructions of class c
+//    Counter 2*c+1 : cycles an instruction of class c was
+//                    waiting (issued and not completed)
+//  - Classes: 0 qPut*, 1 qGet/qPoll, 2 qWait, 3 mPut*,
+//    4 mGet*, 5 mBarrier, 6 mFence, 7 mLoad, 8 mStore,
+//    9 others (qSpill, DMA, status reads)
+//  - Counter 2*CLASSES+e counts event e (0 I-cache hits,
+//    1 I-cache misses, 2 useful and 3 useless I-cache
+//    prefetches, 4 data cache hits, 5 data cache misses)
+//  - Port A is read by the processor (mqStats), port B by
+//    the AXI register block.
+////////////////////////////////////////////////////////////////
+
+`timescale 1 ps / 1 ps
+
+module mq_stats#(
+   parameter CLASSES = 10,
+   parameter EVENTS  = 6
+)(
+   input  logic               clk_ctrl,
+   input  logic               clk_ctrl_rst_low,
+   input  logic [CLASSES-1:0] stat_inst,   //- An instruction of class c was issued
+   input  logic [CLASSES-1:0] stat_stall,  //- An instruction of class c is waiting
+   input  logic  [EVENTS-1:0] stat_event,
+   input  logic               clear,
+   input  logic         [7:0] sel_a,
+   output logic        [31:0] rdata_a,
+   input  logic         [7:0] sel_b,
+   output logic        [31:0] rdata_b
+);
+
+localparam COUNTERS = 2*CLASSES+EVENTS;
+
+logic [31:0] stat_cnt [0:COUNTERS-1];
+
+genvar c,e;
+
+generate
+  for (c=0; c<CLASSES; c=c+1) begin : stat_class
+    always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
+      if (~clk_ctrl_rst_low) begin
+        stat_cnt[2*c]   <= 'h0;
+        stat_cnt[2*c+1] <= 'h0;
+      end else if (clear) begin
+        stat_cnt[2*c]   <= 'h0;
+        stat_cnt[2*c+1] <= 'h0;
+      end else begin
+        if (stat_inst[c])  stat_cnt[2*c]   <= stat_cnt[2*c]   + 'h1;
+        if (stat_stall[c]) stat_cnt[2*c+1] <= stat_cnt[2*c+1] + 'h1;
+      end
+    end
+  end
+  for (e=0; e<EVENTS; e=e+1) begin : stat_ev
+    always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
+      if (~clk_ctrl_rst_low)     stat_cnt[2*CLASSES+e] <= 'h0;
+      else if (clear)            stat_cnt[2*CLASSES+e] <= 'h0;
+      else if (stat_event[e])    stat_cnt[2*CLASSES+e] <= stat_cnt[2*CLASSES+e] + 'h1;
+    end
+  end
+endgenerate
+
+assign rdata_a = sel_a < COUNTERS ? stat_cnt[sel_a] : 'h0;
+assign rdata_b = sel_b < COUNTERS ? stat_cnt[sel_b] : 'h0;
+
+endmodule
@@ -35,7 +35,10 @@ module qISAExtension#(
    parameter MQ_ADDR_W         =  9,
    parameter MQ_MEMSIZE_KB     =  2,  // Inbound FIFO size 2kB/4=512, 1<<9 = 512
    parameter NOC_BUFFER_ADDR_W =  8,
-   parameter XY_SZ             =  3
+   parameter XY_SZ             =  3,
+   parameter MEM_SZ            = 'h1000, //- Port A addresses below MEM_SZ are data memory
+   parameter DC_LINES          = 0,  //- Remote data cache lines (0: no cache)
+   parameter DC_WAYS           = 2
 )(
   //---Clock and Reset---//
    input  logic       clk_ctrl,
@@ -44,6 +47,7 @@ module qISAExtension#(
    input  logic       clk_line_rst_low,
    input  logic       clk_line_rst_high,
    input  logic       clk_ctrl_rst_high,
+   input  logic       stats_rst_low,     //- The counters survive a processor reset
    input  logic [(XY_SZ*2)-1:0] HsrcId,     //- Tile identification
    //---Processor Interface---//
    input  logic        pcpi_valid,
@@ -72,6 +76,7 @@ module qISAExtension#(
    //- Memory port A (Memory Manager)
    input  logic [31:0] mem_rdata_a,
    output logic [31:0] mem_addr_a,
+   output logic        mem_xa_a,
    output logic [31:0] mem_wdata_a, 
    output logic        mem_wstrb_a, 
    output logic        mem_valid_a,
@@ -81,7 +86,25 @@ module qISAExtension#(
    input  logic [31:0] mem_addr_rv,
    input  logic [31:0] mem_wdata_rv, 
    input  logic        mem_wstrb_rv, 
-   input  logic        mem_valid_rv //,
+   input  logic        mem_valid_rv,
+   //- Send DMA reads through the processor port
+   output logic        dma_mem_valid,
+   output logic [31:0] dma_mem_addr,
+   input  logic        dma_mem_grant,
+   input  logic [31:0] dma_mem_rdata,
+   //- Remote data cache hits read their line through the processor port
+   output logic        dc_mem_valid,
+   output logic [31:0] dc_mem_addr,
+   input  logic        dc_mem_grant,
+   input  logic [31:0] dc_mem_rdata,
+   //---Statistics (AXI)---//
+   input  logic  [7:0] stats_sel_axi,
+   output logic [31:0] stats_dout_axi,
+   input  logic  [3:0] stat_event,        //- I-cache {pf useless, pf useful, miss, hit}
+   //---Barrier network---//
+   input  logic  [3:0] barrier_member,
+   input  logic  [3:0] barrier_sense,
+   output logic  [3:0] barrier_arrive
 );
 
 localparam FIFO_ADDR_SZ     = 9; 
@@ -134,6 +157,30 @@ logic [ 3:0] stream_out_spy_TKEEP;
 logic        stream_out_spy_TLAST;
 logic        stream_out_spy_TREADY; 
 
+logic        mem_reply_done;
+logic        mget_done;
+logic [31:0] mem_rdata_dec;
+
+logic        dc_cfg;
+logic        dc_inval;
+logic        dc_fill_done;
+logic        dc_sel;
+logic [31:0] dc_rdata;
+logic  [1:0] stat_dc;
+
+logic [31:0] fifo_0A_din;
+
+logic  [9:0] stat_inst_pcpi;
+logic  [9:0] stat_stall_pcpi;
+logic  [1:0] stat_inst_spy;
+logic  [1:0] stat_stall_spy;
+logic  [7:0] stats_sel;
+logic        stats_clear;
+logic [31:0] stats_rdata;
+logic        spill_en;
+logic [31:0] spill_base;
+logic  [3:0] spill_size_w;
+
 //***************************
 //* Que comience la fiesta
 //* Start the code 
@@ -191,14 +238,27 @@ noc_decoder noc_decoder(
    .fifo_0_full       (fifo_0_full),
    .fifo_0A_en        (fifo_0A_en),
    .fifo_0A_addr      (fifo_0A_addr),
+   .fifo_0A_din       (fifo_0A_din),
+   .spill_en          (spill_en),
+   .spill_base        (spill_base),
+   .spill_size_w      (spill_size_w),
    .mem_rdata_a       (mem_rdata_a),
    .mem_addr_a        (mem_addr_a),
+   .mem_xa_a          (mem_xa_a),
    .mem_wdata_a       (mem_wdata_a),
    .mem_wstrb_a       (mem_wstrb_a),
    .mem_valid_a       (mem_valid_a),
-   .mem_rdata_rv      (mem_rdata_rv)
+   .mem_rdata_rv      (mem_rdata_dec),
+   .mem_reply_done    (mem_reply_done)
 );
 
+//- Only responses that land in data memory complete an mGet,
+//  instruction memory refills and data cache line fills use
+//  the same path.
+assign mget_done = mem_reply_done & (mem_addr_a < MEM_SZ) & ~dc_fill_done;
+
+assign mem_rdata_rv = dc_sel ? dc_rdata : mem_rdata_dec;
+
 //////////////////////////////
 // Buffer NoC data
 //////////////////////////////
@@ -253,6 +313,30 @@ qISAExtension_pcpi#(
    .fifo_0B_dout      (fifo_0B_dout),
    .fifo_0_empty      (fifo_0_empty),
    .fifo_0_full       (fifo_0_full),
+   //- Barrier network
+   .barrier_member    (barrier_member),
+   .barrier_sense     (barrier_sense),
+   .barrier_arrive    (barrier_arrive),
+   //- Outstanding requests
+   .mget_done         (mget_done),
+   //- Message queue spill region
+   .spill_en          (spill_en),
+   .spill_base        (spill_base),
+   .spill_size_w      (spill_size_w),
+   //- Send DMA
+   .dma_mem_valid     (dma_mem_valid),
+   .dma_mem_addr      (dma_mem_addr),
+   .dma_mem_grant     (dma_mem_grant),
+   .dma_mem_rdata     (dma_mem_rdata),
+   //- Remote data cache
+   .dc_cfg            (dc_cfg),
+   .dc_inval          (dc_inval),
+   //- Statistics
+   .stat_inst         (stat_inst_pcpi),
+   .stat_stall        (stat_stall_pcpi),
+   .stats_sel         (stats_sel),
+   .stats_clear       (stats_clear),
+   .stats_rdata       (stats_rdata),
    //- PCPI Processor Interface
    .pcpi_valid        (pcpi_valid),
    .pcpi_insn         (pcpi_insn),
@@ -268,7 +352,9 @@ qISAExtension_pcpi#(
 //assign mem_rdata_rv = stream_in_TDATA_int; //FIXME;
 
 mem_spy#(
-   .NOC_BUFFER_ADDR_W (NOC_BUFFER_ADDR_W-2)
+   .NOC_BUFFER_ADDR_W (NOC_BUFFER_ADDR_W-2),
+   .DC_LINES          (DC_LINES),
+   .DC_WAYS           (DC_WAYS)
 ) mem_spy(
    //---Clock and Reset---//
    .clk_ctrl          (clk_ctrl),
@@ -286,6 +372,23 @@ mem_spy#(
    .mem_wstrb_rv      (|mem_wstrb_rv),      //- Input
    .unblock           (unblock),
    .spy_idle          (spy_idle),
+   .stat_inst         (stat_inst_spy),
+   .stat_stall        (stat_stall_spy),
+   .stat_dc           (stat_dc),
+   //- Remote data cache
+   .dc_cfg            (dc_cfg),
+   .dc_inval          (dc_inval),
+   .dc_cfg_base       (pcpi_rs1),
+   .dc_cfg_en         (|pcpi_rs2),
+   .mem_addr_a        (mem_addr_a),
+   .mem_reply_done    (mem_reply_done),
+   .dc_fill_done      (dc_fill_done),
+   .dc_mem_valid      (dc_mem_valid),
+   .dc_mem_addr       (dc_mem_addr),
+   .dc_mem_grant      (dc_mem_grant),
+   .dc_mem_rdata      (dc_mem_rdata),
+   .dc_sel            (dc_sel),
+   .dc_rdata          (dc_rdata),
    .stream_out_TREADY (stream_out_spy_TREADY),
    .stream_out_TVALID (stream_out_spy_TVALID),
    .stream_out_TDATA  (stream_out_spy_TDATA),
@@ -293,6 +396,22 @@ mem_spy#(
    .stream_out_TLAST  (stream_out_spy_TLAST));
 
 
+//- Instruction and stall counters
+mq_stats#(
+   .CLASSES (10),
+   .EVENTS  (6)
+) mq_stats(
+   .clk_ctrl         (clk_ctrl),
+   .clk_ctrl_rst_low (stats_rst_low),
+   .stat_inst        ({stat_inst_pcpi[9],  stat_inst_spy,  stat_inst_pcpi[6:0]}),
+   .stat_stall       ({stat_stall_pcpi[9], stat_stall_spy, stat_stall_pcpi[6:0]}),
+   .stat_event       ({stat_dc, stat_event}),
+   .clear            (stats_clear),
+   .sel_a            (stats_sel),
+   .rdata_a          (stats_rdata),
+   .sel_b            (stats_sel_axi),
+   .rdata_b          (stats_dout_axi));
+
 //- Inbound Message Queue
 //- Only for message Queues
 //- A: NoC writes
@@ -307,7 +426,7 @@ DPRAM #(
   .en    ({fifo_0A_en,       fifo_0B_en}),
   .we    ({fifo_0A_en,       1'b0}),
   .addr  ({fifo_0A_addr[MQ_ADDR_W-1:0], fifo_0B_addr[MQ_ADDR_W-1:0]}),
-  .din   ({stream_in_TDATA_int, 32'h0}),
+  .din   ({fifo_0A_din,      32'h0}),
   .dout  ({fifo_0B_dout,     fifo_0A_dout})
 );
 assign fifo_0_empty = fifo_0A_addr >= fifo_0B_addr ? fifo_0A_addr - fifo_0B_addr == 0 : fifo_0A_addr + FIFO_WRITE_DEPTH - fifo_0B_addr <= 1;
@@ -71,6 +71,30 @@ module qISAExtension_pcpi#(
    input logic [31:0]  fifo_0B_dout,
    input logic         fifo_0_empty,
    input logic         fifo_0_full,
+   //---Barrier network---//
+   input  logic  [3:0] barrier_member, //- This tile takes part in group g
+   input  logic  [3:0] barrier_sense,  //- Broadcast sense of each group
+   output logic  [3:0] barrier_arrive, //- Arrive bit of each group
+   //---Outstanding requests---//
+   input  logic        mget_done,      //- A response to an mGet landed in data memory
+   //---Message queue spill region---//
+   output logic        spill_en,
+   output logic [31:0] spill_base,
+   output logic  [3:0] spill_size_w,
+   //---Send DMA: local memory (read only)---//
+   output logic        dma_mem_valid,
+   output logic [31:0] dma_mem_addr,
+   input  logic        dma_mem_grant,
+   input  logic [31:0] dma_mem_rdata,
+   //---Remote data cache---//
+   output logic        dc_cfg,         //- dCache: rs1 word base of the lines, rs2 enable
+   output logic        dc_inval,       //- dCacheInval
+   //---Statistics---//
+   output logic  [9:0] stat_inst,      //- See mq_stats.sv for the classes
+   output logic  [9:0] stat_stall,
+   output logic  [7:0] stats_sel,      //- mqStats
+   output logic        stats_clear,
+   input  logic [31:0] stats_rdata,
 
    output logic pcpi_idle
 );
@@ -93,6 +117,15 @@ localparam [2:0] QPOLL   = 3'd0; //
 localparam [2:0] QWAIT   = 3'd1; //
 localparam [2:0] QGET    = 3'd2;  //
 localparam [2:0] QPUT    = 3'd3;  //
+localparam [2:0] MBARRIER = 3'd1; //- QWAIT with insn[26:25] == 1
+localparam [2:0] MFENCE   = 3'd1; //- QWAIT with insn[26:25] == 2
+localparam [2:0] MPENDING = 3'd0; //- QPOLL with insn[26:25] == 1
+localparam [2:0] QSPILL   = 3'd3; //- QPUT with insn[26:25] == 3
+localparam [2:0] MDMA     = 3'd4; //- MPUT with insn[26:25] == 3 (insn[27]: start)
+localparam [2:0] MDMASTAT = 3'd2; //- QGET with insn[26:25] == 1
+localparam [2:0] MQSTATS  = 3'd0; //- QPOLL with insn[26:25] == 2
+localparam [2:0] DCINVAL  = 3'd0; //- QPOLL with insn[26:25] == 3
+localparam [2:0] DCACHE   = 3'd1; //- QWAIT with insn[26:25] == 3
 
 //- State machine state2
 //-2,7-
@@ -106,6 +139,8 @@ localparam [3:0] SEND2_S       = 4'd7;
 localparam [3:0] QPUT_DATA_S  = 4'd1; 
 localparam [3:0] MDONE_S      = 4'd4;
 localparam [3:0] QGET1_S      = 4'd5;
+localparam [3:0] BARRIER_S    = 4'd2;
+localparam [3:0] FENCE_S      = 4'hA;
 
 localparam [3:0] QPUT_H0_S    = 4'hC;
 localparam [3:0] QPUT_H1_S    = 4'hD;
@@ -139,6 +174,20 @@ logic inst_q_put_d;
 logic inst_m_put_h;
 logic inst_m_put_d;
 logic inst_m_get_h; //Jul 14 2023
+logic inst_m_get_d;
+logic inst_m_barrier;
+logic inst_m_fence;
+logic inst_m_pending;
+logic inst_m_pending_r;
+logic inst_q_spill;
+logic inst_m_dma_a;
+logic inst_m_dma;
+logic inst_m_dma_stat;
+logic inst_m_dma_stat_r;
+logic inst_mq_stats;
+logic inst_mq_stats_r;
+logic inst_dc_cfg;
+logic inst_dc_inval;
 
 logic inst_m_put_r;
 logic inst_m_get_r; 
@@ -175,6 +224,10 @@ logic      [XY_SZ-1:0] pcpi_x_dest;
 logic      [XY_SZ-1:0] pcpi_y_dest;
 logic pcpi_hl;
 logic pcpi_hl_short;
+logic pcpi_xa;   //- Extended address: the second word is the full target address
+logic pcpi_nt;   //- Non-temporal: a DRAM tile moves the packet in bursts around its cache
+logic pcpi_idx;  //- Indexed: gather/scatter in a scratchpad tile
+logic [XY_SZ-1:0] pcpi_xa_y; //- mPutX/mGetX to the DRAM row: tile of the address
 
 logic  [3:0] pcpi_pkt_code;
 logic  [3:0] pcpi_pkt_code_get;
@@ -197,6 +250,9 @@ always @(posedge clk_ctrl) begin
       inst_m_get_d_r <= inst_m_get_d;
       inst_q_put_h_r <= inst_q_put_h;
       inst_q_put_d_r <= inst_q_put_d;
+      inst_m_pending_r <= inst_m_pending;
+      inst_m_dma_stat_r <= inst_m_dma_stat;
+      inst_mq_stats_r <= inst_mq_stats;
    end
 end
 
@@ -207,26 +263,97 @@ assign inst_m_put_d = inst_valid & pcpi_insn[14:12] == MPUT & pcpi_insn[26:25] =
 assign inst_m_get_h = inst_valid & pcpi_insn[14:12] == MGET & pcpi_insn[26:25] == 1;   //- MM Non-Blocking
 assign inst_m_get_d = inst_valid & pcpi_insn[14:12] == MGET & pcpi_insn[26:25] == 2;   //- MM Non-Blocking
 
+//- mPutX/mGetX: long header with insn[27] set. rs1 is the 32-bit word address in
+//  the target tile and rs2 = {dest_y, dest_x, pkt_size_code[3:0]}.
+assign pcpi_xa = (inst_m_put_h | inst_m_get_h) & pcpi_insn[27];
+assign pcpi_nt = pcpi_xa & pcpi_rs2[31]; //- mPutB/mGetB
+assign pcpi_idx = pcpi_xa & pcpi_rs2[30]; //- mGatherX/mScatterAddX
+
+dram_map#(
+   .XY_SZ (XY_SZ)
+) dram_map_xa (
+   .x_dest (pcpi_rs2[XY_SZ+3:4]),
+   .y_dest (pcpi_rs2[(2*XY_SZ)+3:XY_SZ+4]),
+   .addr   ({pcpi_rs1[29:0],2'b00}),
+   .y_map  (pcpi_xa_y));
+
 
 assign inst_q_put   = inst_valid & pcpi_insn[14:12] == QPUT & pcpi_insn[26:25] == 0;   //- QM
-assign inst_q_poll  = inst_valid & pcpi_insn[14:12] == QPOLL;  //- QM
-assign inst_q_wait  = inst_valid & pcpi_insn[14:12] == QWAIT;  //- QM
-assign inst_q_get   = inst_valid & pcpi_insn[14:12] == QGET;   //- QM
+assign inst_q_poll  = inst_valid & pcpi_insn[14:12] == QPOLL & pcpi_insn[26:25] == 0;  //- QM
+assign inst_q_wait  = inst_valid & pcpi_insn[14:12] == QWAIT & pcpi_insn[26:25] == 0;  //- QM
+assign inst_q_get   = inst_valid & pcpi_insn[14:12] == QGET & pcpi_insn[26:25] == 0;   //- QM
 assign inst_q_put_h = inst_valid & pcpi_insn[14:12] == QPUT & pcpi_insn[26:25] == 1;   //- QM: long header long packet
 assign inst_q_put_d = inst_valid & pcpi_insn[14:12] == QPUT & pcpi_insn[26:25] == 2;   //- QM: data for long packet
 
+assign inst_m_barrier = inst_valid & pcpi_insn[14:12] == MBARRIER & pcpi_insn[26:25] == 1; //- Blocks until the group arrives
+assign inst_m_fence   = inst_valid & pcpi_insn[14:12] == MFENCE   & pcpi_insn[26:25] == 2; //- Blocks until no request is outstanding
+assign inst_m_pending = inst_valid & pcpi_insn[14:12] == MPENDING & pcpi_insn[26:25] == 1; //- Reads the outstanding counters
+assign inst_q_spill   = inst_valid & pcpi_insn[14:12] == QSPILL   & pcpi_insn[26:25] == 3; //- Configures the spill region
+assign inst_m_dma_a   = inst_valid & pcpi_insn[14:12] == MDMA     & pcpi_insn[26:25] == 3 & ~pcpi_insn[27]; //- DMA source and length
+assign inst_m_dma     = inst_valid & pcpi_insn[14:12] == MDMA     & pcpi_insn[26:25] == 3 &  pcpi_insn[27]; //- DMA destination, start
+assign inst_m_dma_stat = inst_valid & pcpi_insn[14:12] == MDMASTAT & pcpi_insn[26:25] == 1; //- Words left to send
+assign inst_mq_stats  = inst_valid & pcpi_insn[14:12] == MQSTATS  & pcpi_insn[26:25] == 2; //- Reads a statistics counter
+assign inst_dc_cfg    = inst_valid & pcpi_insn[14:12] == DCACHE   & pcpi_insn[26:25] == 3; //- Configures the data cache
+assign inst_dc_inval  = inst_valid & pcpi_insn[14:12] == DCINVAL  & pcpi_insn[26:25] == 3; //- Drops every cached line
+
 logic [7:0] pkt_size_qput;  //Jun 2023
 logic [7:0] next_pkt_size_qput; //Jun 2023
 
+logic [3:0] next_barrier_arrive;
+
+//- Outstanding requests: mGet* waiting for a response to this tile and
+//  mPut* whose last word has not been handed to the NoC buffer yet.
+logic [15:0] pending_rd;
+logic [15:0] next_pending_rd;
+logic [15:0] pending_wr;
+logic [15:0] next_pending_wr;
+logic        pending_rd_inc;
+logic        pending_wr_inc;
+logic        pending_wr_dec;
+logic        mm_idle;  //- Every packet in the outbound buffer left the tile
+
+//- Send DMA, it shares the memory NoC buffer with mPut/mGet
+logic        mm_open;      //- The processor has a long packet open
+logic        next_mm_open;
+logic        dma_cfg_src;
+logic        dma_cfg_start;
+logic        dma_busy;
+logic [15:0] dma_remaining;
+logic        dma_pkt_grant;
+logic        dma_pkt_owns;
+logic        dma_TVALID;
+logic [31:0] dma_TDATA;
+logic        dma_TLAST;
+logic        mm_TVALID;
+logic [31:0] mm_TDATA;
+logic        mm_TLAST;
+
 always @(posedge clk_ctrl or negedge clk_ctrl_rst_low) begin
    if (~clk_ctrl_rst_low) begin
       currentState2 <= IDLE_S;
       fifo_0B_addr  <= 'h0; //- Read address for inbound FIFO
       pkt_size_qput <= 'h0;
+      barrier_arrive <= 'h0;
+      pending_rd    <= 'h0;
+      pending_wr    <= 'h0;
+      spill_en      <= 1'b0;
+      spill_base    <= 'h0;
+      spill_size_w  <= 'h0;
+      mm_open       <= 1'b0;
    end else begin
       currentState2 <= nextState2;
       fifo_0B_addr  <= next_fifo_0B_addr;
       pkt_size_qput <= next_pkt_size_qput;
+      barrier_arrive <= next_barrier_arrive;
+      pending_rd    <= next_pending_rd;
+      pending_wr    <= next_pending_wr;
+      mm_open       <= next_mm_open;
+      //- qSpill: rs1 word address of the region, rs2 log2 of its size in words (0 disables)
+      if (currentState2 == IDLE_S & inst_q_spill) begin
+         spill_en      <= pcpi_rs2[3:0] != 0;
+         spill_base    <= pcpi_rs1;
+         spill_size_w  <= pcpi_rs2[3:0];
+      end
    end
 end
 
@@ -263,6 +390,21 @@ always @( * ) begin
    pcpi_pkt_code = 0;
    pcpi_pkt_code_get = 0;
 
+   next_mm_open   = mm_open;
+   dma_cfg_src    = 1'b0;
+   dma_cfg_start  = 1'b0;
+   dc_cfg         = 1'b0;
+   dc_inval       = 1'b0;
+
+   pending_rd_inc = 1'b0;
+   pending_wr_inc = 1'b0;
+   pending_wr_dec = 1'b0;
+
+   //- Barrier: the arrive bits follow the sense while the tile is not waiting
+   next_barrier_arrive = barrier_sense;
+   if (currentState2 == BARRIER_S)
+      next_barrier_arrive[pcpi_rs1_int[1:0]] = barrier_arrive[pcpi_rs1_int[1:0]];
+
    case (currentState2)
       IDLE_S: begin
          if (inst_q_wait) begin
@@ -271,7 +413,30 @@ always @( * ) begin
                nextState2 = QWAIT1_S;
             end else
                nextState2 = QWAIT0_S;
-        end else if (inst_q_poll) nextState2 = QPOLL_S;
+        end else if (inst_q_poll | inst_m_pending) nextState2 = QPOLL_S;
+        else if (inst_m_fence) nextState2 = FENCE_S;
+        else if (inst_q_spill) nextState2 = MDONE_S;
+        else if (inst_dc_cfg | inst_dc_inval) begin
+           dc_cfg     = inst_dc_cfg;
+           dc_inval   = inst_dc_inval;
+           nextState2 = MDONE_S;
+        end
+        else if (inst_m_dma_stat | inst_mq_stats) nextState2 = QPOLL_S;
+        else if (inst_m_dma_a | inst_m_dma) begin
+           if (dma_busy) pcpi_wait = 1'b1; //- One transfer at a time
+           else begin
+              dma_cfg_src   = inst_m_dma_a;
+              dma_cfg_start = inst_m_dma;
+              nextState2    = MDONE_S;
+           end
+        end
+        else if (inst_m_barrier) begin
+           if (barrier_member[pcpi_rs1[1:0]]) begin
+              next_barrier_arrive[pcpi_rs1[1:0]] = ~barrier_sense[pcpi_rs1[1:0]];
+              nextState2 = BARRIER_S;
+           end else
+              nextState2 = MDONE_S; //- Not a member: nothing to wait for
+        end
         else if (inst_q_get) begin
            /* FIXME: Should we only get the data and increment
             *         the address by 2. Or get header and data
@@ -296,11 +461,21 @@ always @( * ) begin
                     fifo_2B_din = pcpi_rs1;
               end
            end else if (inst_m_put | inst_m_put_h | inst_m_get | inst_m_get_h | inst_m_put_d | inst_m_get_d) begin
-              if (stream_out_mem_TREADY_int) begin
+              if (stream_out_mem_TREADY_int & ~dma_pkt_owns) begin
                  nextState2 = SEND2_S;
+                 next_mm_open = inst_m_put_h | inst_m_get_h;
                  pcpi_x_dest = pcpi_rs1[OFFSET_SZ+XY_SZ-1:OFFSET_SZ];
                  pcpi_y_dest = pcpi_rs1[OFFSET_SZ+(2*XY_SZ)-1:OFFSET_SZ+XY_SZ];
+                 if (pcpi_xa) begin
+                    pcpi_x_dest = pcpi_rs2[XY_SZ+3:4];
+                    pcpi_y_dest = pcpi_xa_y;
+                 end
                  stream_out_mem_TVALID_int = 1'b1;
+                 //- A long mGet counts with its mGetD, only when the reply
+                 //  address (rs1) is in this tile: replies sent to another
+                 //  tile (e.g. spad data to an FP tile) never come back here.
+                 pending_rd_inc = inst_m_get | (inst_m_get_d & pcpi_rs1[OFFSET_SZ+(2*XY_SZ)-1:OFFSET_SZ] == HsrcId);
+                 pending_wr_inc = inst_m_put | inst_m_put_h;
                  if (inst_m_put | inst_m_get) //- Short packer
                       stream_out_mem_TDATA_int = pcpi_header;
                  else if (inst_m_put_h | inst_m_get_h) begin //- Long header
@@ -310,7 +485,7 @@ always @( * ) begin
                        next_pkt_size_qput = 1;
                     end else begin
                        pcpi_pkt_code = pcpi_rs2[3:0];
-                       next_pkt_size_qput = 1 << (pcpi_rs2-1);
+                       next_pkt_size_qput = 1 << (pcpi_rs2[3:0]-1);
                     end
                       stream_out_mem_TDATA_int = pcpi_header1;
                  end else //- Data for long header
@@ -334,6 +509,20 @@ always @( * ) begin
            pcpi_wait    = 1'b0;
         end else pcpi_wait = 1'b1;
       end
+     BARRIER_S: begin
+        //- The sense flips once every member of the group arrived
+        if (barrier_sense[pcpi_rs1_int[1:0]] == barrier_arrive[pcpi_rs1_int[1:0]]) begin
+           pcpi_ready = 1'b1;
+           nextState2 = IDLE_S;
+        end else pcpi_wait = 1'b1;
+     end
+     FENCE_S: begin
+        //- mFence: wait for the responses and for the outbound buffer to drain
+        if (pending_rd == 0 && pending_wr == 0 && ~dma_busy && mm_idle) begin
+           pcpi_ready = 1'b1;
+           nextState2 = IDLE_S;
+        end else pcpi_wait = 1'b1;
+     end
      QPOLL_S: begin 
         //- This is a modification Jun 13 2022
         // before this day 
@@ -341,7 +530,10 @@ always @( * ) begin
         //if (!fifo_0_empty) pcpi_rd = 32'h1;
         //else               pcpi_rd = 32'h0;
         //- Now, if there is a message in the queue send the header
-        if (fifo_0_empty) pcpi_rd = 32'h1;
+        if (inst_m_pending_r) pcpi_rd = {pending_wr,pending_rd}; //- mPending
+        else if (inst_m_dma_stat_r) pcpi_rd = {15'h0,dma_busy,dma_remaining}; //- mDmaStatus
+        else if (inst_mq_stats_r) pcpi_rd = stats_rdata; //- mqStats
+        else if (fifo_0_empty) pcpi_rd = 32'h1;
         else              pcpi_rd = fifo_0B_dout;
         pcpi_wr    = 1'b1;
         pcpi_ready = 1'b1;
@@ -380,14 +572,18 @@ always @( * ) begin
             if (inst_m_put_r | inst_m_get_r) begin //- Short packet
                stream_out_mem_TDATA_int = pcpi_rs2_int;
                stream_out_mem_TLAST_int = 1'b1;
+               pending_wr_dec = inst_m_put_r;
             end else if (inst_m_put_h_r | inst_m_get_h_r) //- Long header
                //stream_out_mem_TDATA_int = pcpi_rs1_int[OFFSET_SZ-1:0];
                stream_out_mem_TDATA_int = pcpi_rs1_int;
             else begin //- Long data
                next_pkt_size_qput = pkt_size_qput - 'h1;
                stream_out_mem_TDATA_int = pcpi_rs2_int;
-               if (pkt_size_qput == 1)
+               if (pkt_size_qput == 1) begin
                   stream_out_mem_TLAST_int = 1'h1;
+                  pending_wr_dec = inst_m_put_d_r;
+                  next_mm_open   = 1'b0;
+               end
             end
          end else pcpi_wait = 1'b1;
       end
@@ -398,8 +594,33 @@ always @( * ) begin
         nextState2 = IDLE_S;
       end
    endcase
+
+   //- A reply of another tile's mGet may land here, do not wrap
+   next_pending_rd = pending_rd + pending_rd_inc - (mget_done & (pending_rd != 0 | pending_rd_inc));
+   next_pending_wr = pending_wr + pending_wr_inc - pending_wr_dec;
+end
+
+
+//- Statistics: an instruction is issued when it leaves IDLE_S and
+//  it is waiting every cycle it is valid and not ready.
+logic [9:0] stat_class;
+
+always @( * ) begin
+   stat_class = 10'h200; //- Others
+   if      (inst_q_put | inst_q_put_h | inst_q_put_d)   stat_class = 10'h001;
+   else if (inst_q_get | inst_q_poll)                   stat_class = 10'h002;
+   else if (inst_q_wait)                                stat_class = 10'h004;
+   else if (inst_m_put | inst_m_put_h | inst_m_put_d)   stat_class = 10'h008;
+   else if (inst_m_get | inst_m_get_h | inst_m_get_d)   stat_class = 10'h010;
+   else if (inst_m_barrier)                             stat_class = 10'h020;
+   else if (inst_m_fence)                               stat_class = 10'h040;
 end
 
+assign stat_inst  = inst_valid & currentState2 == IDLE_S & nextState2 != IDLE_S ? stat_class : 'h0;
+assign stat_stall = inst_valid & ~pcpi_ready ? stat_class : 'h0;
+
+assign stats_sel   = pcpi_rs1_int[7:0];
+assign stats_clear = currentState2 == QPOLL_S & inst_mq_stats_r & pcpi_rs1_int[31];
 
 noc_buffer_out #(
    .ADDR_W (NOC_BUFFER_ADDR_W)
@@ -441,14 +662,46 @@ noc_buffer_out#(
    .stream_out_TKEEP  (stream_out_mem_TKEEP),
    .stream_out_TLAST  (stream_out_mem_TLAST),
    .stream_out_TREADY (stream_out_mem_TREADY),
-   .stream_in_TVALID  (stream_out_mem_TVALID_int),
-   .stream_in_TDATA   (stream_out_mem_TDATA_int),
+   .stream_in_TVALID  (mm_TVALID),
+   .stream_in_TDATA   (mm_TDATA),
    .stream_in_TKEEP   (stream_out_mem_TKEEP_int),
-   .stream_in_TLAST   (stream_out_mem_TLAST_int),
-   .stream_in_TREADY  (stream_out_mem_TREADY_int));
+   .stream_in_TLAST   (mm_TLAST),
+   .stream_in_TREADY  (stream_out_mem_TREADY_int),
+   .stream_in_idle    (mm_idle));
 
 assign stream_out_mem_TKEEP_int = 4'hF;
 
+//- A DMA packet starts only between processor packets
+assign dma_pkt_grant = currentState2 == IDLE_S & ~mm_open &
+                       ~(inst_m_put | inst_m_put_h | inst_m_get | inst_m_get_h | inst_m_put_d | inst_m_get_d);
+
+assign mm_TVALID = dma_TVALID | stream_out_mem_TVALID_int;
+assign mm_TDATA  = dma_TVALID ? dma_TDATA : stream_out_mem_TDATA_int;
+assign mm_TLAST  = dma_TVALID ? dma_TLAST : stream_out_mem_TLAST_int;
+
+mq_dma#(
+   .XY_SZ (XY_SZ)
+) mq_dma(
+   .clk_ctrl          (clk_ctrl),
+   .clk_ctrl_rst_low  (clk_ctrl_rst_low),
+   .HsrcId            (HsrcId),
+   .cfg_src           (dma_cfg_src),
+   .cfg_start         (dma_cfg_start),
+   .cfg_rs1           (pcpi_rs1),
+   .cfg_rs2           (pcpi_rs2),
+   .dma_busy          (dma_busy),
+   .dma_remaining     (dma_remaining),
+   .mem_valid         (dma_mem_valid),
+   .mem_addr          (dma_mem_addr),
+   .mem_grant         (dma_mem_grant),
+   .mem_rdata         (dma_mem_rdata),
+   .pkt_grant         (dma_pkt_grant),
+   .pkt_owns          (dma_pkt_owns),
+   .stream_out_TREADY (stream_out_mem_TREADY_int),
+   .stream_out_TVALID (dma_TVALID),
+   .stream_out_TDATA  (dma_TDATA),
+   .stream_out_TLAST  (dma_TLAST));
+
 //- Short header
 assign pcpi_hl_short       = 1'b0;
 assign pcpi_offset_short   = inst_q_put || inst_q_get ? 'h0 :  pcpi_rs1[OFFSET_SZ-1:0] ; 
@@ -456,7 +709,7 @@ assign pcpi_header  = {3'h0,pcpi_hl_short,pcpi_code,pt,HsrcId,pcpi_offset_short,
 
 //- Long header
 assign pcpi_hl       = 1'b1;
-assign pcpi_header1  = {3'h0,pcpi_hl,pcpi_code,pt,HsrcId,2'b0,pcpi_pkt_code_get,pcpi_pkt_code,{(8-(2*XY_SZ)){1'b0}},pcpi_y_dest,pcpi_x_dest};
+assign pcpi_header1  = {pcpi_idx,pcpi_nt,pcpi_xa,pcpi_hl,pcpi_code,pt,HsrcId,2'b0,pcpi_pkt_code_get,pcpi_pkt_code,{(8-(2*XY_SZ)){1'b0}},pcpi_y_dest,pcpi_x_dest};
 
 
 endmodule
@@ -0,0 +1,479 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+/////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Pipelined RV32IM core for the pico tile
+// File        : rv32im_pipe.sv
+// Notes       :
+//  - Drop-in for picorv32 in acc_picorv32: same native memory
+//    bus (valid/ready, one request at a time) and PCPI port.
+//  - Two stages: fetch fills a 2-entry instruction queue while
+//    the head instruction executes. ALU, branch and jump
+//    instructions take one cycle, taken branches flush the
+//    queue (not taken is predicted).
+//  - A request can start in the cycle after the previous one
+//    is ready. Loads wait for the data, stores retire when
+//    issued. Data accesses go before fetches.
+//  - MUL* take two cycles, DIV*/REM* 33 (iterative).
+//  - rdcycle[h], rdtime[h] and rdinstret[h]. ECALL, EBREAK,
+//    other CSRs and PCPI timeouts trap (the core stops).
+//  - No compressed instructions and no interrupts.
+//  - PCPI: insn, rs1 and rs2 are registered and stay stable
+//    the cycle after pcpi_ready, pcpi_valid drops for at least
+//    one cycle between instructions (as picorv32). Other
+//    instructions wait for the stores in flight.
+////////////////////////////////////////////////////////////////
+
+`timescale 1 ps / 1 ps
+
+module rv32im_pipe#(
+   parameter [31:0] PROGADDR_RESET = 32'h0
+)(
+   input  logic        clk,
+   input  logic        resetn,
+   output logic        trap,
+   //- Native memory interface
+   output logic        mem_valid,
+   output logic        mem_instr,
+   input  logic        mem_ready,
+   output logic [31:0] mem_addr,
+   output logic [31:0] mem_wdata,
+   output logic  [3:0] mem_wstrb,
+   input  logic [31:0] mem_rdata,
+   //- Pico Co-Processor Interface (PCPI)
+   output logic        pcpi_valid,
+   output logic [31:0] pcpi_insn,
+   output logic [31:0] pcpi_rs1,
+   output logic [31:0] pcpi_rs2,
+   input  logic        pcpi_wr,
+   input  logic [31:0] pcpi_rd,
+   input  logic        pcpi_wait,
+   input  logic        pcpi_ready
+);
+
+localparam [6:0] OP_LUI    = 7'b0110111;
+localparam [6:0] OP_AUIPC  = 7'b0010111;
+localparam [6:0] OP_JAL    = 7'b1101111;
+localparam [6:0] OP_JALR   = 7'b1100111;
+localparam [6:0] OP_BRANCH = 7'b1100011;
+localparam [6:0] OP_LOAD   = 7'b0000011;
+localparam [6:0] OP_STORE  = 7'b0100011;
+localparam [6:0] OP_IMM    = 7'b0010011;
+localparam [6:0] OP_OP     = 7'b0110011;
+localparam [6:0] OP_FENCE  = 7'b0001111;
+localparam [6:0] OP_SYSTEM = 7'b1110011;
+
+//- Execute stage
+localparam [2:0] X_EXEC = 3'd0;
+localparam [2:0] X_LOAD = 3'd1;
+localparam [2:0] X_MUL  = 3'd2;
+localparam [2:0] X_DIV  = 3'd3;
+localparam [2:0] X_PCPI = 3'd4;
+localparam [2:0] X_TRAP = 3'd5;
+
+localparam IQ_DEPTH = 2;
+
+logic  [2:0] x_state;
+logic  [2:0] next_x_state;
+
+//- Register file
+logic [31:0] regs [1:31];
+logic        rd_we;
+logic [31:0] rd_data;
+
+//- Instruction queue
+logic [31:0] iq_pc   [0:IQ_DEPTH-1];
+logic [31:0] iq_insn [0:IQ_DEPTH-1];
+logic        iq_head;
+logic        iq_tail;
+logic  [1:0] iq_count;
+logic  [1:0] iq_count_next;
+logic        iq_push;
+logic        iq_pop;
+
+//- Fetch
+logic [31:0] f_pc;
+logic        f_kill;      //- The fetch in flight was flushed
+logic        bus_data;    //- The request in flight is a load or store
+logic        bus_free;
+logic        xfer;
+logic        data_launch;
+logic        fetch_launch;
+logic [31:0] fetch_addr;
+logic        redirect;
+logic [31:0] redirect_pc;
+
+//- Decode
+logic        x_valid;
+logic [31:0] x_pc;
+logic [31:0] insn;
+logic  [6:0] opcode;
+logic  [2:0] funct3;
+logic  [6:0] funct7;
+logic  [4:0] rd;
+logic  [4:0] rs1;
+logic  [4:0] rs2;
+logic [31:0] rs1v;
+logic [31:0] rs2v;
+logic [31:0] imm_i;
+logic [31:0] imm_s;
+logic [31:0] imm_b;
+logic [31:0] imm_u;
+logic [31:0] imm_j;
+
+logic        is_alu;
+logic        is_muldiv;
+logic        is_ldst;
+logic        is_csr;
+logic        is_trap;
+logic        is_pcpi;
+
+logic [31:0] alu_b;
+logic [31:0] alu_sra;
+logic [31:0] alu_out;
+logic        br_take;
+logic [31:0] ls_addr;
+logic [31:0] ld_shift;
+logic [31:0] ld_data;
+logic [31:0] csr_out;
+
+//- Counters
+logic [63:0] cnt_cycle;
+logic [63:0] cnt_instret;
+
+//- Multiply and divide
+logic [63:0] mul_res;
+logic [31:0] div_a;       //- |rs1| of signed divisions
+logic [31:0] div_b;       //- |rs2| of signed divisions
+logic [31:0] div_dividend;
+logic [62:0] div_divisor;
+logic [31:0] div_quot;
+logic [31:0] div_msk;
+logic        div_outsign;
+logic  [3:0] pcpi_timeout;
+
+assign trap = x_state == X_TRAP;
+
+//- Decode of the head of the queue
+assign x_valid = iq_count != 0;
+assign x_pc    = iq_pc[iq_head];
+assign insn    = iq_insn[iq_head];
+assign opcode  = insn[6:0];
+assign funct3  = insn[14:12];
+assign funct7  = insn[31:25];
+assign rd      = insn[11:7];
+assign rs1     = insn[19:15];
+assign rs2     = insn[24:20];
+assign rs1v    = rs1 == 0 ? 32'h0 : regs[rs1];
+assign rs2v    = rs2 == 0 ? 32'h0 : regs[rs2];
+
+assign imm_i = {{20{insn[31]}}, insn[31:20]};
+assign imm_s = {{20{insn[31]}}, insn[31:25], insn[11:7]};
+assign imm_b = {{19{insn[31]}}, insn[31], insn[7], insn[30:25], insn[11:8], 1'b0};
+assign imm_u = {insn[31:12], 12'h0};
+assign imm_j = {{11{insn[31]}}, insn[31], insn[19:12], insn[20], insn[30:21], 1'b0};
+
+assign is_muldiv = opcode == OP_OP & funct7 == 7'b0000001;
+assign is_alu    = opcode == OP_IMM | (opcode == OP_OP & (funct7 == 7'h00 | funct7 == 7'h20));
+assign is_ldst   = opcode == OP_LOAD | opcode == OP_STORE;
+assign is_csr    = opcode == OP_SYSTEM & funct3 == 3'd2 & rs1 == 0 &
+                   insn[31:28] == 4'hC & insn[26:22] == 5'h0 & insn[21:20] != 2'h3;
+assign is_trap   = opcode == OP_SYSTEM & ~is_csr;
+assign is_pcpi   = ~(is_alu | is_muldiv | is_ldst | opcode == OP_SYSTEM | opcode == OP_LUI |
+                     opcode == OP_AUIPC | opcode == OP_JAL | opcode == OP_JALR |
+                     opcode == OP_BRANCH | opcode == OP_FENCE);
+
+//- ALU
+assign alu_b   = opcode == OP_OP ? rs2v : imm_i;
+assign alu_sra = $signed(rs1v) >>> alu_b[4:0];
+
+always @( * ) begin
+   case (funct3)
+      3'd0: alu_out = (opcode == OP_OP & funct7[5]) ? rs1v - alu_b : rs1v + alu_b;
+      3'd1: alu_out = rs1v << alu_b[4:0];
+      3'd2: alu_out = {31'h0, $signed(rs1v) < $signed(alu_b)};
+      3'd3: alu_out = {31'h0, rs1v < alu_b};
+      3'd4: alu_out = rs1v ^ alu_b;
+      3'd5: alu_out = funct7[5] ? alu_sra : rs1v >> alu_b[4:0];
+      3'd6: alu_out = rs1v | alu_b;
+      default: alu_out = rs1v & alu_b;
+   endcase
+end
+
+always @( * ) begin
+   case (funct3)
+      3'd0: br_take = rs1v == rs2v;
+      3'd1: br_take = rs1v != rs2v;
+      3'd4: br_take = $signed(rs1v) <  $signed(rs2v);
+      3'd5: br_take = $signed(rs1v) >= $signed(rs2v);
+      3'd6: br_take = rs1v <  rs2v;
+      3'd7: br_take = rs1v >= rs2v;
+      default: br_take = 1'b0;
+   endcase
+end
+
+//- Loads and stores
+assign ls_addr  = rs1v + (opcode == OP_STORE ? imm_s : imm_i);
+assign ld_shift = mem_rdata >> {ls_addr[1:0], 3'b000};
+
+always @( * ) begin
+   case (funct3)
+      3'd0:    ld_data = {{24{ld_shift[7]}},  ld_shift[7:0]};
+      3'd1:    ld_data = {{16{ld_shift[15]}}, ld_shift[15:0]};
+      3'd4:    ld_data = {24'h0, ld_shift[7:0]};
+      3'd5:    ld_data = {16'h0, ld_shift[15:0]};
+      default: ld_data = mem_rdata;
+   endcase
+end
+
+//- rdcycle (C00), rdtime (C01), rdinstret (C02), +80 for the high word
+always @( * ) begin
+   case ({insn[27], insn[21:20]})
+      3'b000, 3'b001: csr_out = cnt_cycle[31:0];
+      3'b100, 3'b101: csr_out = cnt_cycle[63:32];
+      3'b010:         csr_out = cnt_instret[31:0];
+      default:        csr_out = cnt_instret[63:32];
+   endcase
+end
+
+assign div_a = (~funct3[0] & rs1v[31]) ? -rs1v : rs1v;
+assign div_b = (~funct3[0] & rs2v[31]) ? -rs2v : rs2v;
+
+//- Memory bus
+assign xfer     = mem_valid & mem_ready;
+assign bus_free = ~mem_valid | mem_ready;
+
+assign data_launch  = bus_free & x_state == X_EXEC & x_valid & is_ldst;
+assign fetch_launch = bus_free & ~data_launch & ~trap & iq_count_next < IQ_DEPTH;
+assign fetch_addr   = redirect ? redirect_pc : f_pc;
+
+assign iq_tail       = iq_head ^ iq_count[0];
+assign iq_push       = xfer & ~bus_data & ~f_kill & ~redirect;
+assign iq_count_next = redirect ? 2'd0 : iq_count + iq_push - iq_pop;
+
+always @( * ) begin
+   next_x_state = x_state;
+   rd_we        = 1'b0;
+   rd_data      = 32'h0;
+   iq_pop       = 1'b0;
+   redirect     = 1'b0;
+   redirect_pc  = 32'h0;
+
+   case (x_state)
+      X_EXEC: begin
+         if (x_valid) begin
+            if (is_ldst) begin
+               if (data_launch) begin
+                  if (opcode == OP_STORE) iq_pop       = 1'b1;
+                  else                    next_x_state = X_LOAD;
+               end
+            end else if (is_muldiv) begin
+               next_x_state = funct3[2] ? X_DIV : X_MUL;
+            end else if (is_trap) begin
+               next_x_state = X_TRAP;
+            end else if (is_pcpi) begin
+               if (~(mem_valid & bus_data)) next_x_state = X_PCPI;
+            end else begin
+               iq_pop = 1'b1;
+               rd_we  = 1'b1;
+               case (opcode)
+                  OP_LUI:   rd_data = imm_u;
+                  OP_AUIPC: rd_data = x_pc + imm_u;
+                  OP_JAL: begin
+                     rd_data     = x_pc + 32'h4;
+                     redirect    = 1'b1;
+                     redirect_pc = x_pc + imm_j;
+                  end
+                  OP_JALR: begin
+                     rd_data     = x_pc + 32'h4;
+                     redirect    = 1'b1;
+                     redirect_pc = (rs1v + imm_i) & ~32'h1;
+                  end
+                  OP_BRANCH: begin
+                     rd_we       = 1'b0;
+                     redirect    = br_take;
+                     redirect_pc = x_pc + imm_b;
+                  end
+                  OP_FENCE:  rd_we   = 1'b0;
+                  OP_SYSTEM: rd_data = csr_out;
+                  default:   rd_data = alu_out;
+               endcase
+            end
+         end
+      end
+      X_LOAD: begin
+         if (xfer & bus_data) begin
+            iq_pop       = 1'b1;
+            rd_we        = 1'b1;
+            rd_data      = ld_data;
+            next_x_state = X_EXEC;
+         end
+      end
+      X_MUL: begin
+         iq_pop       = 1'b1;
+         rd_we        = 1'b1;
+         rd_data      = funct3 == 3'd0 ? mul_res[31:0] : mul_res[63:32];
+         next_x_state = X_EXEC;
+      end
+      X_DIV: begin
+         if (div_msk == 0) begin
+            iq_pop       = 1'b1;
+            rd_we        = 1'b1;
+            rd_data      = funct3[1] ? (div_outsign ? -div_dividend : div_dividend) :
+                                       (div_outsign ? -div_quot     : div_quot);
+            next_x_state = X_EXEC;
+         end
+      end
+      X_PCPI: begin
+         if (pcpi_valid & pcpi_ready) begin
+            iq_pop       = 1'b1;
+            rd_we        = pcpi_wr;
+            rd_data      = pcpi_rd;
+            next_x_state = X_EXEC;
+         end else if (pcpi_timeout == 4'hF)
+            next_x_state = X_TRAP;
+      end
+      default: ;
+   endcase
+end
+
+always @(posedge clk) begin
+   if (rd_we & rd != 0) regs[rd] <= rd_data;
+   if (iq_push) begin
+      iq_pc[iq_tail]   <= mem_addr;
+      iq_insn[iq_tail] <= mem_rdata;
+   end
+end
+
+always @(posedge clk or negedge resetn) begin
+   if (~resetn) begin
+      x_state      <= X_EXEC;
+      iq_head      <= 1'b0;
+      iq_count     <= 'h0;
+      f_pc         <= PROGADDR_RESET;
+      f_kill       <= 1'b0;
+      bus_data     <= 1'b0;
+      mem_valid    <= 1'b0;
+      mem_instr    <= 1'b0;
+      mem_addr     <= 'h0;
+      mem_wdata    <= 'h0;
+      mem_wstrb    <= 'h0;
+      pcpi_valid   <= 1'b0;
+      pcpi_insn    <= 'h0;
+      pcpi_rs1     <= 'h0;
+      pcpi_rs2     <= 'h0;
+      pcpi_timeout <= 'h0;
+      cnt_cycle    <= 'h0;
+      cnt_instret  <= 'h0;
+      mul_res      <= 'h0;
+      div_dividend <= 'h0;
+      div_divisor  <= 'h0;
+      div_quot     <= 'h0;
+      div_msk      <= 'h0;
+      div_outsign  <= 1'b0;
+   end else begin
+      x_state   <= next_x_state;
+      cnt_cycle <= cnt_cycle + 'h1;
+      if (iq_pop) cnt_instret <= cnt_instret + 'h1;
+
+      //- Instruction queue
+      iq_count <= iq_count_next;
+      if (redirect)    iq_head <= 1'b0;
+      else if (iq_pop) iq_head <= iq_head + 1'b1;
+
+      //- Memory bus: one request at a time, held until ready
+      if (xfer) begin
+         mem_valid <= 1'b0;
+         mem_wstrb <= 'h0;
+         if (~bus_data) f_kill <= 1'b0;
+      end
+      if (redirect & mem_valid & ~bus_data & ~xfer) f_kill <= 1'b1;
+
+      if (data_launch) begin
+         mem_valid <= 1'b1;
+         mem_instr <= 1'b0;
+         bus_data  <= 1'b1;
+         mem_addr  <= {ls_addr[31:2], 2'b00};
+         if (opcode == OP_STORE) begin
+            case (funct3)
+               3'd0: begin
+                  mem_wdata <= {4{rs2v[7:0]}};
+                  mem_wstrb <= 4'b0001 << ls_addr[1:0];
+               end
+               3'd1: begin
+                  mem_wdata <= {2{rs2v[15:0]}};
+                  mem_wstrb <= ls_addr[1] ? 4'b1100 : 4'b0011;
+               end
+               default: begin
+                  mem_wdata <= rs2v;
+                  mem_wstrb <= 4'b1111;
+               end
+            endcase
+         end
+      end else if (fetch_launch) begin
+         mem_valid <= 1'b1;
+         mem_instr <= 1'b1;
+         bus_data  <= 1'b0;
+         mem_addr  <= fetch_addr;
+         f_pc      <= fetch_addr + 32'h4;
+      end else if (redirect) begin
+         f_pc      <= redirect_pc;
+      end
+
+      //- Multiply: 33x33 signed product, MULHSU/MULHU extend with zeros
+      if (x_state == X_EXEC & x_valid & is_muldiv & ~funct3[2])
+         mul_res <= $signed({funct3 != 3'd3 & rs1v[31], rs1v}) *
+                    $signed({(funct3 == 3'd0 | funct3 == 3'd1) & rs2v[31], rs2v});
+
+      //- Divide: restoring, one quotient bit per cycle
+      if (x_state == X_EXEC & x_valid & is_muldiv & funct3[2]) begin
+         div_dividend <= div_a;
+         div_divisor  <= {div_b, 31'h0};
+         div_quot     <= 'h0;
+         div_msk      <= 32'h80000000;
+         div_outsign  <= ~funct3[0] & (funct3[1] ? rs1v[31] : (rs1v[31] != rs2v[31]) & |rs2v);
+      end else if (x_state == X_DIV & div_msk != 0) begin
+         if (div_divisor <= {31'h0, div_dividend}) begin
+            div_dividend <= div_dividend - div_divisor[31:0];
+            div_quot     <= div_quot | div_msk;
+         end
+         div_divisor <= div_divisor >> 1;
+         div_msk     <= div_msk >> 1;
+      end
+
+      //- PCPI: operands registered, valid until ready
+      if (x_state == X_EXEC & next_x_state == X_PCPI) begin
+         pcpi_valid <= 1'b1;
+         pcpi_insn  <= insn;
+         pcpi_rs1   <= rs1v;
+         pcpi_rs2   <= rs2v;
+      end else if (x_state == X_PCPI & next_x_state != X_PCPI) begin
+         pcpi_valid <= 1'b0;
+      end
+      if (~pcpi_valid | pcpi_wait) pcpi_timeout <= 'h0;
+      else                         pcpi_timeout <= pcpi_timeout + 'h1;
+   end
+end
+
+endmodule
@@ -29,6 +29,7 @@
 ////////////////////////////////////////////////
 
 `timescale 1 ps/ 1 ps
+`include "global_defines.sv"
 
 module acc_scratchpad#(
    parameter OFFSET_SZ         = 12,
@@ -79,6 +80,7 @@ logic           stream_in_TREADY_int;
 (*mark_debug = "true" *) logic [BW-1:0] mm_mem_rdata;
 (*mark_debug = "true" *) logic [BW-1:0] mm_mem_wdata;
 (*mark_debug = "true" *) logic [31:0] mm_mem_addr;
+(*mark_debug = "true" *) logic          mm_mem_xa;
 (*mark_debug = "true" *) logic          mm_mem_wstrb; 
 (*mark_debug = "true" *) logic          mm_mem_valid;
 
@@ -88,6 +90,11 @@ logic [BWB-1:0] stream_out_TKEEP_int;
 logic           stream_out_TLAST_int;
 logic           stream_out_TREADY_int;
 
+//- Capacity and primitive of the scratchpad (spad_kb, spad_uram). Past
+//  the first 1<<OFFSET_SZ words it is reached with mPutX/mGetX and the host.
+localparam SPAD_KB   = `SPAD_KB;
+localparam SPAD_PRIM = `SPAD_URAM ? "ultra" : "auto";
+
 logic rvRstN;
 
 assign rvRstN = rvControl[0]; //1'b0;
@@ -129,6 +136,39 @@ noc_buffer_in#(
    .stream_out_TREADY (stream_in_TREADY_int)
 );
 
+`ifdef SPAD_BANKS
+//- Banked scratchpad: requests are served back to back, replies are
+//  queued instead of holding the NoC input (spad_banked.sv)
+spad_banked#(
+   .BW         (BW),
+   .XY_SZ      (XY_SZ),
+   .OFFSET_SZ  (OFFSET_SZ),
+   .BANKS      (`SPAD_BANKS),
+   .MEMSIZE_KB (SPAD_KB),
+   .MEMORY_PRIMITIVE (SPAD_PRIM),
+   .GATHER     (`SPAD_GATHER),
+   .ACCUM      (`SPAD_ACCUM)
+) spad_banked(
+   .clk_ctrl          (clk_ctrl),
+   .clk_ctrl_rst_low  (clk_ctrl_rst_low),
+   .HsrcId            (HsrcId),
+   .stream_in_TVALID  (stream_in_TVALID_int),
+   .stream_in_TDATA   (stream_in_TDATA_int),
+   .stream_in_TKEEP   (stream_in_TKEEP_int),
+   .stream_in_TLAST   (stream_in_TLAST_int),
+   .stream_in_TREADY  (stream_in_TREADY_int),
+   .stream_out_TREADY (stream_out_TREADY_int),
+   .stream_out_TVALID (stream_out_TVALID_int),
+   .stream_out_TDATA  (stream_out_TDATA_int),
+   .stream_out_TKEEP  (stream_out_TKEEP_int),
+   .stream_out_TLAST  (stream_out_TLAST_int),
+   .mem_valid_axi     (mem_valid_axi),
+   .mem_addr_axi      (mem_addr_axi),
+   .mem_wdata_axi     (mem_wdata_axi),
+   .mem_wstrb_axi     (mem_wstrb_axi),
+   .mem_rdata_axi     (mem_rdata_axi)
+);
+`else
 noc_decoder#(
    .BW (BW)
 ) noc_decoder(
@@ -158,8 +198,13 @@ noc_decoder#(
    .pcpi_idle         (1'b1),
    .fifo_0A_en        (),
    .fifo_0A_addr      (),
+   .fifo_0A_din       (),
+   .spill_en          (1'b0),
+   .spill_base        (32'h0),
+   .spill_size_w      (4'h0),
    .mem_rdata_a       (mm_mem_rdata),
    .mem_addr_a        (mm_mem_addr),
+   .mem_xa_a          (mm_mem_xa),
    .mem_wdata_a       (mm_mem_wdata),
    .mem_wstrb_a       (mm_mem_wstrb),
    .mem_valid_a       (mm_mem_valid),
@@ -172,7 +217,7 @@ noc_decoder#(
 //////////////////////////////
 
 logic [31:0] mm_mem_addr_short;
-assign mm_mem_addr_short = {20'h0,mm_mem_addr[OFFSET_SZ-1:0]};
+assign mm_mem_addr_short = mm_mem_xa ? mm_mem_addr : {20'h0,mm_mem_addr[OFFSET_SZ-1:0]};
 logic [BW-32-1:0] filler;
 assign filler = 'h0;
 logic [BW-1:0] mem_rdata_axi_t;
@@ -180,7 +225,8 @@ assign mem_rdata_axi = mem_rdata_axi_t[31:0];
 DPRAM #(
   .ADDR_W     (32),
   .DATA_W     (BW),
-  .MEMSIZE_KB (16)
+  .MEMSIZE_KB (SPAD_KB),
+  .MEMORY_PRIMITIVE (SPAD_PRIM)
 ) dp_ram (
   .clk   ({clk_ctrl,         clk_ctrl}),
   .rst_n ({clk_ctrl_rst_low, clk_ctrl_rst_low}),
@@ -189,6 +235,7 @@ DPRAM #(
   .addr  ({mem_addr_axi,  mm_mem_addr_short}),  
   .din   ({{filler,mem_wdata_axi}, mm_mem_wdata}),
   .dout  ({mm_mem_rdata, mem_rdata_axi_t}));   //- LPGG FIXME: Does the order depend on the simulator?
+`endif
 
 //////////////////////////////
 // Buffer NoC data
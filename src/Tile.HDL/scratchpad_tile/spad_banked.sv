@@ -0,0 +1,696 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Banked scratchpad with a pipelined NoC request path
+// File        : spad_banked.sv
+// Notes       :
+//  - Replaces noc_decoder + DPRAM in acc_scratchpad when SPAD_BANKS is set.
+//  - Words are interleaved over BANKS DPRAMs: bank = addr[LB-1:0].
+//  - The input side accepts one word per cycle. mPut/mStore words are
+//    written as they arrive, mGet/mLoad/mStore replies are queued
+//    (RSP_Q deep) so the input is not held while a reply is sent.
+//  - Reads of the queued replies share port A of the banks with the
+//    writes (writes win, a read waits one cycle on a bank conflict).
+//    Port B of every bank is the host (AXI) port.
+//  - A write to a word with a pending read waits for the read, so the
+//    replies see the memory in packet order as with noc_decoder.
+//  - Packets other than mPut/mGet/mLoad/mStore are dropped.
+//  - GATHER: a long mGet with bit 31 set (mGetX with mq_IDX) is a
+//    gather. The second word points to 1<<size indices in the
+//    scratchpad and the fourth word is the base: the reply (an mPut
+//    as for mGet) carries mem[base + mem[ptr+k]]. Two cycles a word.
+//  - GATHER: a long mPut with bit 31 set is a scatter-add. The second
+//    word is the base and the data are (index, value) pairs:
+//    mem[base + index] += value, one pair every two cycles.
+//  - ACCUM: bits [31:29] of the index select the operation of the pair:
+//    0 add, 1 signed min, 2 signed max (one word), 3 latches the low
+//    word of an fp64 value and 4 adds {value, low} to the fp64 at
+//    base + index (two words, through FP_adder_64_13cc, ~17 cycles).
+//    The input and the reads wait while a pair is being applied.
+////////////////////////////////////////////////
+
+`timescale 1 ps/ 1 ps
+`include "global_defines.sv"
+
+module spad_banked #(
+   parameter BW         = 32,
+   parameter BWB        = BW/8,
+   parameter XY_SZ      = 3,
+   parameter OFFSET_SZ  = 12,
+   parameter BANKS      = 4,   //- Power of two
+   parameter MEMSIZE_KB = 16,  //- Total, split evenly over the banks
+   parameter MEMORY_PRIMITIVE = "auto",
+   parameter GATHER     = 0,   //- Gather and scatter-add packets
+   parameter ACCUM      = 0,   //- Scatter packets with min/max/fp64 add
+   parameter RSP_Q      = 4,   //- Queued replies, power of two
+   parameter DATA_Q     = 4    //- Read words buffered for the output, power of two
+)(
+  //---Clock and Reset---//
+   input  logic                 clk_ctrl,
+   input  logic                 clk_ctrl_rst_low,
+   input  logic [(XY_SZ*2)-1:0] HsrcId,     //- Tile identification
+   //---NOC interface---//
+   //- Input Interface
+   input  logic           stream_in_TVALID,
+   input  logic  [BW-1:0] stream_in_TDATA,
+   input  logic [BWB-1:0] stream_in_TKEEP,
+   input  logic           stream_in_TLAST,
+   output logic           stream_in_TREADY,
+   //- Output Interface
+   input  logic           stream_out_TREADY,
+   output logic           stream_out_TVALID,
+   output logic  [BW-1:0] stream_out_TDATA,
+   output logic [BWB-1:0] stream_out_TKEEP,
+   output logic           stream_out_TLAST,
+   //- AXI memory interface
+   input  logic        mem_valid_axi,
+   input  logic [31:0] mem_addr_axi,
+   input  logic [31:0] mem_wdata_axi,
+   input  logic        mem_wstrb_axi,
+   output logic [31:0] mem_rdata_axi
+);
+
+localparam LB = $clog2(BANKS);
+localparam QB = $clog2(RSP_Q);
+localparam DB = $clog2(DATA_Q);
+
+localparam [2:0] MPUT    = 3'd4;
+localparam [2:0] MGET    = 3'd5;
+localparam [2:0] MLOAD   = 3'd6;
+localparam [2:0] MSTORE  = 3'd7;
+localparam [2:0] MACK    = 3'd1;
+localparam [2:0] MDATA   = 3'd2;
+
+//- Input parser
+localparam [2:0] P_IDLE = 3'd0; //- Header
+localparam [2:0] P_ADDR = 3'd1; //- Second word of a long header
+localparam [2:0] P_WR   = 3'd2; //- mPut/mStore data
+localparam [2:0] P_REQ  = 3'd3; //- Last word of an mGet/mLoad (reply address of a gather)
+localparam [2:0] P_SKIP = 3'd4; //- Drop the rest of the packet
+localparam [2:0] P_BASE = 3'd5; //- Gather: base of the values
+localparam [2:0] P_SIDX = 3'd6; //- Scatter-add: index
+localparam [2:0] P_SVAL = 3'd7; //- Scatter-add: value, read the word
+
+//- Scatter operations, bits [31:29] of the index (ACCUM)
+localparam [2:0] A_ADD  = 3'd0;
+localparam [2:0] A_MIN  = 3'd1;
+localparam [2:0] A_MAX  = 3'd2;
+localparam [2:0] A_FLO  = 3'd3; //- fp64: low word of the value
+localparam [2:0] A_FHI  = 3'd4; //- fp64: high word, do the add
+
+//- Scatter pair states
+localparam [2:0] S_IDLE = 3'd0;
+localparam [2:0] S_WB   = 3'd1; //- Write back the result of add/min/max
+localparam [2:0] S_RDH  = 3'd2; //- fp64: read the high word
+localparam [2:0] S_ADD  = 3'd3; //- fp64: both words read, start the add
+localparam [2:0] S_WAIT = 3'd4; //- fp64: wait for the adder
+localparam [2:0] S_WRL  = 3'd5; //- fp64: write the low word
+localparam [2:0] S_WRH  = 3'd6; //- fp64: write the high word
+
+//- Gather reads
+localparam [1:0] G_IDX  = 2'd0; //- Read the next index
+localparam [1:0] G_LOAD = 2'd1; //- Index on the bank output, read the value
+localparam [1:0] G_VAL  = 2'd2; //- Read the value (bank conflict in G_LOAD)
+
+//- Output
+localparam [1:0] O_H1   = 2'd0;
+localparam [1:0] O_H2   = 2'd1;
+localparam [1:0] O_DATA = 2'd2;
+
+integer i;
+
+logic [BW-1:0] bank_rdata [BANKS-1:0]; //- Port A of the banks
+
+//****************************
+//* Input parser
+//****************************
+logic  [2:0] p_state;
+logic  [2:0] next_p_state;
+logic [BW-1:0] p_hdr;
+logic [BW-1:0] next_p_hdr;
+logic [31:0] p_addr;        //- Next word to write, first word to read, or base
+logic [31:0] next_p_addr;
+
+logic  [2:0] in_code;
+logic  [2:0] hdr_code;
+logic        in_wr, in_rd;
+logic        hdr_hl, hdr_xa, hdr_wr;
+logic        hdr_gat, hdr_sct;
+logic        w_fire;
+logic        w_hazard;
+logic        rd_pend;
+
+assign in_code  = stream_in_TDATA[27:25];
+assign hdr_code = p_hdr[27:25];
+assign in_wr    = in_code == MPUT | in_code == MSTORE;
+assign in_rd    = in_code == MGET | in_code == MLOAD;
+assign hdr_hl   = p_hdr[28];
+assign hdr_xa   = p_hdr[28] & p_hdr[29]; //- mPutX/mGetX: full word address
+assign hdr_wr   = hdr_code == MPUT | hdr_code == MSTORE;
+//- Long mGet/mPut with bit 31 (mq_IDX) set: gather and scatter-add.
+//  Bit 30 (non-temporal, mq_NT) means nothing to a scratchpad.
+assign hdr_gat  = GATHER != 0 & hdr_hl & p_hdr[31] & hdr_code == MGET;
+assign hdr_sct  = (GATHER != 0 | ACCUM != 0) & hdr_hl & p_hdr[31] & hdr_code == MPUT;
+
+//- Reply queue
+logic [BW-1:0] q_h1   [RSP_Q-1:0];
+logic [BW-1:0] q_h2   [RSP_Q-1:0];
+logic          q_hl   [RSP_Q-1:0];
+logic          q_ack  [RSP_Q-1:0]; //- mAck: header and a zero word
+logic          q_gat  [RSP_Q-1:0]; //- Gather: q_addr walks the indices
+logic   [31:0] q_base [RSP_Q-1:0]; //- Gather: base of the values
+logic   [31:0] q_addr [RSP_Q-1:0]; //- Next word to read
+logic   [16:0] q_left [RSP_Q-1:0]; //- Words still to read
+logic   [16:0] q_n    [RSP_Q-1:0]; //- Words to send
+logic   [QB:0] q_wr, q_rd, q_is;   //- Push, output and read issue pointers
+logic          q_full;
+logic          q_push;
+
+assign q_full = (q_wr - q_rd) == RSP_Q;
+
+//- Reply header, as noc_decoder builds it
+logic          pt;
+logic    [5:0] rsp_dest;
+logic    [2:0] rsp_code;
+logic   [11:0] rsp_offset;
+logic   [16:0] rsp_n;
+logic [BW-1:0] rsp_h1;
+logic [BW-1:0] g_h1, g_h2;         //- Gather reply headers, pushed with the base
+logic [BW-1:0] next_g_h1, next_g_h2;
+
+assign pt = 1; //- Responses are tagged (as the DRAM tile does) so the requester can count them
+
+logic is_array;
+logic mem_addr_b_32;
+assign mem_addr_b_32 = 0;
+logic is_array_dec;
+`include "is_array.vh"
+
+assign rsp_dest   = hdr_code == MGET & hdr_hl ?
+                    is_array_dec ? stream_in_TDATA[OFFSET_SZ+5:OFFSET_SZ] : `ROW :
+                    p_hdr[23:18];
+assign rsp_code   = hdr_code == MGET ? MPUT :
+                    hdr_code == MSTORE ? MACK : MDATA;
+//- The offset of an mAck is not used by the requester
+assign rsp_offset = hdr_wr ? 12'h0 :
+                    hdr_hl ? (hdr_code == MGET ? {4'h0,p_hdr[15:12],2'b00} : 12'h0) :
+                    stream_in_TDATA[OFFSET_SZ-1:0];
+assign rsp_n      = hdr_code == MGET & hdr_hl ? 17'h1 << p_hdr[15:12] : 17'h1;
+assign rsp_h1     = {3'b0,hdr_hl,rsp_code,pt,HsrcId,rsp_offset,rsp_dest};
+
+//- Scatter: the word is read when the value comes and written back
+//  with the result the next cycle (fp64: see S_RDH..S_WRH)
+logic [31:0] s_idx;
+logic [31:0] next_s_idx;
+logic  [2:0] s_op;
+logic [31:0] s_off;
+logic        s_rd;
+logic  [2:0] s_state;
+logic  [2:0] next_s_state;
+logic        s_busy;
+logic [31:0] s_addr;
+logic [BW-1:0] s_val;
+logic [BW-1:0] s_old;
+logic [BW-1:0] s_res;
+logic [31:0] f_vlo;            //- fp64: low word of the value
+logic [31:0] f_lo;             //- fp64: low word in memory
+logic [63:0] f_res;
+logic [63:0] f_sum;
+logic        f_rdy;
+
+assign s_op   = ACCUM != 0 ? s_idx[31:29] : A_ADD;
+assign s_off  = ACCUM != 0 ? {3'h0,s_idx[28:0]} : s_idx;
+assign s_busy = s_state != S_IDLE;
+
+//- A write must not pass a queued read of the same word. The words
+//  of a gather are not known in advance, no write passes a gather.
+logic [1:0] g_state;
+logic       gat_pend;
+
+always @( * ) begin
+   w_hazard = 1'b0;
+   gat_pend = g_state != G_IDX;
+   rd_pend  = g_state != G_IDX;
+   for (i=0; i<RSP_Q; i=i+1) begin
+      if ((p_addr - q_addr[i]) < {15'h0,q_left[i]}) w_hazard = 1'b1;
+      if (q_gat[i] & q_left[i] != 0) gat_pend = 1'b1;
+      if (q_left[i] != 0) rd_pend = 1'b1;
+   end
+   w_hazard = w_hazard | gat_pend;
+end
+
+always @( * ) begin
+   next_p_state = p_state;
+   next_p_hdr   = p_hdr;
+   next_p_addr  = p_addr;
+   next_g_h1    = g_h1;
+   next_g_h2    = g_h2;
+   next_s_idx   = s_idx;
+   stream_in_TREADY = 1'b1;
+   w_fire = 1'b0;
+   s_rd   = 1'b0;
+   q_push = 1'b0;
+
+   case (p_state)
+      P_IDLE: begin
+         if (stream_in_TVALID) begin
+            next_p_hdr = stream_in_TDATA;
+            if (in_wr | in_rd) begin
+               if (stream_in_TDATA[28])
+                  next_p_state = P_ADDR;
+               else begin
+                  next_p_addr  = {{(32-OFFSET_SZ){1'b0}},stream_in_TDATA[OFFSET_SZ+5:6]};
+                  next_p_state = in_wr ? P_WR : P_REQ;
+               end
+            end else if (~stream_in_TLAST)
+               next_p_state = P_SKIP;
+         end
+      end
+      P_ADDR: begin
+         if (stream_in_TVALID) begin
+            next_p_addr  = hdr_xa ? stream_in_TDATA : {{(32-OFFSET_SZ){1'b0}},stream_in_TDATA[OFFSET_SZ-1:0]};
+            next_p_state = hdr_sct ? P_SIDX : hdr_wr ? P_WR : P_REQ;
+         end
+      end
+      P_WR: begin
+         if (w_hazard | s_busy | (stream_in_TLAST & hdr_code == MSTORE & q_full))
+            stream_in_TREADY = 1'b0;
+         else if (stream_in_TVALID) begin
+            w_fire      = 1'b1;
+            next_p_addr = p_addr + 'h1;
+            if (stream_in_TLAST) begin
+               q_push       = hdr_code == MSTORE;
+               next_p_state = P_IDLE;
+            end
+         end
+      end
+      P_REQ: begin
+         if (q_full & ~hdr_gat)
+            stream_in_TREADY = 1'b0;
+         else if (stream_in_TVALID) begin
+            if (hdr_gat) begin
+               next_g_h1    = rsp_h1;
+               next_g_h2    = stream_in_TDATA;
+               next_p_state = stream_in_TLAST ? P_IDLE : P_BASE; //- No base: dropped
+            end else begin
+               q_push       = 1'b1;
+               next_p_state = stream_in_TLAST ? P_IDLE : P_SKIP;
+            end
+         end
+      end
+      P_BASE: begin
+         if (q_full)
+            stream_in_TREADY = 1'b0;
+         else if (stream_in_TVALID) begin
+            q_push       = 1'b1;
+            next_p_state = stream_in_TLAST ? P_IDLE : P_SKIP;
+         end
+      end
+      P_SIDX: begin
+         if (stream_in_TVALID) begin
+            next_s_idx   = stream_in_TDATA;
+            next_p_state = stream_in_TLAST ? P_IDLE : P_SVAL;
+         end
+      end
+      P_SVAL: begin
+         if (rd_pend | s_busy)
+            stream_in_TREADY = 1'b0;
+         else if (stream_in_TVALID) begin
+            s_rd         = s_op != A_FLO;
+            next_p_state = stream_in_TLAST ? P_IDLE : P_SIDX;
+         end
+      end
+      P_SKIP: begin
+         if (stream_in_TVALID & stream_in_TLAST)
+            next_p_state = P_IDLE;
+      end
+      default: next_p_state = P_IDLE;
+   endcase
+end
+
+always @(posedge clk_ctrl) begin
+   if (~clk_ctrl_rst_low) begin
+      p_state <= P_IDLE;
+      p_hdr   <= 'h0;
+      p_addr  <= 'h0;
+      g_h1    <= 'h0;
+      g_h2    <= 'h0;
+      s_idx   <= 'h0;
+      s_addr  <= 'h0;
+      s_val   <= 'h0;
+      f_vlo   <= 'h0;
+   end else begin
+      p_state <= next_p_state;
+      p_hdr   <= next_p_hdr;
+      p_addr  <= next_p_addr;
+      g_h1    <= next_g_h1;
+      g_h2    <= next_g_h2;
+      s_idx   <= next_s_idx;
+      if (s_rd) begin
+         s_addr <= p_addr + s_off;
+         s_val  <= stream_in_TDATA;
+      end
+      if (p_state == P_SVAL & stream_in_TVALID & stream_in_TREADY & s_op == A_FLO)
+         f_vlo  <= stream_in_TDATA[31:0];
+   end
+end
+
+//- Scatter operations
+always @( * ) begin
+   s_old = bank_rdata[s_addr[LB-1:0]];
+   case (s_op)
+      A_MIN:   s_res = $signed(s_val) < $signed(s_old) ? s_val : s_old;
+      A_MAX:   s_res = $signed(s_val) > $signed(s_old) ? s_val : s_old;
+      default: s_res = s_old + s_val;
+   endcase
+end
+
+always @( * ) begin
+   next_s_state = s_state;
+   case (s_state)
+      S_IDLE: if (s_rd) next_s_state = s_op == A_FHI ? S_RDH : S_WB;
+      S_WB:   next_s_state = S_IDLE;
+      S_RDH:  next_s_state = S_ADD;
+      S_ADD:  next_s_state = S_WAIT;
+      S_WAIT: if (f_rdy) next_s_state = S_WRL;
+      S_WRL:  next_s_state = S_WRH;
+      S_WRH:  next_s_state = S_IDLE;
+      default: next_s_state = S_IDLE;
+   endcase
+end
+
+always @(posedge clk_ctrl) begin
+   if (~clk_ctrl_rst_low) begin
+      s_state <= S_IDLE;
+      f_lo    <= 'h0;
+      f_res   <= 'h0;
+   end else begin
+      s_state <= next_s_state;
+      if (s_state == S_RDH)              f_lo  <= s_old[31:0];
+      if (s_state == S_WAIT & f_rdy)     f_res <= f_sum;
+   end
+end
+
+//- fp64 adder, one operation in flight
+generate
+if (ACCUM != 0) begin: fadd
+   FP_adder_64_13cc fp_adder (
+      .clock      (clk_ctrl),
+      .reset      (~clk_ctrl_rst_low),
+      .in_valid   (s_state == S_ADD),
+      .in_data_0  ({bank_rdata[s_addr[LB-1:0] + 1'b1][31:0], f_lo}),
+      .in_data_1  ({s_val[31:0], f_vlo}),
+      .out_data   (f_sum),
+      .out_ready  (f_rdy));
+end else begin: no_fadd
+   assign f_sum = 'h0;
+   assign f_rdy = 1'b1;
+end
+endgenerate
+
+//- Port A of the banks for the input side: writes, scatter
+logic          in_en;
+logic          in_we;
+logic   [31:0] in_addr;
+logic [BW-1:0] in_din;
+
+always @( * ) begin
+   in_en   = w_fire;
+   in_we   = w_fire;
+   in_addr = p_addr;
+   in_din  = stream_in_TDATA;
+   if (s_rd) begin
+      in_en   = 1'b1;
+      in_addr = p_addr + s_off;
+   end
+   case (s_state)
+      S_WB: begin
+         in_en   = 1'b1;
+         in_we   = 1'b1;
+         in_addr = s_addr;
+         in_din  = s_res;
+      end
+      S_RDH: begin
+         in_en   = 1'b1;
+         in_addr = s_addr + 'h1;
+      end
+      S_WRL: begin
+         in_en   = 1'b1;
+         in_we   = 1'b1;
+         in_addr = s_addr;
+         in_din  = f_res[31:0];
+      end
+      S_WRH: begin
+         in_en   = 1'b1;
+         in_we   = 1'b1;
+         in_addr = s_addr + 'h1;
+         in_din  = f_res[63:32];
+      end
+      default: ;
+   endcase
+end
+
+//****************************
+//* Read issue
+//****************************
+logic [QB-1:0] i_idx;
+logic          i_pend;
+logic          r_want;
+logic          r_fire;
+logic          r_val;          //- Value read of a gather
+logic   [31:0] r_addr;
+logic          i_next;
+logic          r_fire_d;
+logic          r_idx_d;
+logic [LB-1:0] r_bank_d;
+logic   [DB:0] d_cnt;          //- Words read or in flight, not yet sent
+logic          d_pop;
+logic          o_pop;
+logic   [31:0] g_idx;
+logic    [1:0] next_g_state;
+
+assign i_idx  = q_is[QB-1:0];
+assign i_pend = q_is != q_wr;
+
+always @( * ) begin
+   r_want = i_pend & q_left[i_idx] != 0 & d_cnt < DATA_Q & ~s_busy;
+   r_val  = 1'b0;
+   r_addr = q_addr[i_idx];
+   if (i_pend & q_gat[i_idx]) begin
+      if (g_state == G_LOAD) begin
+         r_want = 1'b1;
+         r_val  = 1'b1;
+         r_addr = q_base[i_idx] + bank_rdata[r_bank_d];
+      end else if (g_state == G_VAL) begin
+         r_want = 1'b1;
+         r_val  = 1'b1;
+         r_addr = q_base[i_idx] + g_idx;
+      end
+   end
+end
+
+assign r_fire = r_want & ~(in_en & in_addr[LB-1:0] == r_addr[LB-1:0]);
+assign i_next = i_pend & (q_gat[i_idx] ? q_left[i_idx] == 0 & g_state == G_IDX :
+                          q_left[i_idx] == 0 | (r_fire & q_left[i_idx] == 1));
+
+always @( * ) begin
+   next_g_state = g_state;
+   case (g_state)
+      G_IDX:  if (i_pend & q_gat[i_idx] & r_fire) next_g_state = G_LOAD;
+      G_LOAD: next_g_state = r_fire ? G_IDX : G_VAL;
+      G_VAL:  if (r_fire) next_g_state = G_IDX;
+      default: next_g_state = G_IDX;
+   endcase
+end
+
+always @(posedge clk_ctrl) begin
+   if (~clk_ctrl_rst_low) begin
+      q_wr     <= 'h0;
+      q_rd     <= 'h0;
+      q_is     <= 'h0;
+      r_fire_d <= 1'b0;
+      r_idx_d  <= 1'b0;
+      r_bank_d <= 'h0;
+      d_cnt    <= 'h0;
+      g_state  <= G_IDX;
+      g_idx    <= 'h0;
+      for (i=0; i<RSP_Q; i=i+1) begin
+         q_h1[i]   <= 'h0;
+         q_h2[i]   <= 'h0;
+         q_hl[i]   <= 1'b0;
+         q_ack[i]  <= 1'b0;
+         q_gat[i]  <= 1'b0;
+         q_base[i] <= 'h0;
+         q_addr[i] <= 'h0;
+         q_left[i] <= 'h0;
+         q_n[i]    <= 'h0;
+      end
+   end else begin
+      if (q_push) begin
+         q_h1[q_wr[QB-1:0]]   <= p_state == P_BASE ? g_h1 : rsp_h1;
+         q_h2[q_wr[QB-1:0]]   <= p_state == P_BASE ? g_h2 : stream_in_TDATA;
+         q_hl[q_wr[QB-1:0]]   <= hdr_hl;
+         q_ack[q_wr[QB-1:0]]  <= hdr_wr;
+         q_gat[q_wr[QB-1:0]]  <= p_state == P_BASE;
+         q_base[q_wr[QB-1:0]] <= stream_in_TDATA;
+         q_addr[q_wr[QB-1:0]] <= p_addr;
+         q_left[q_wr[QB-1:0]] <= hdr_wr ? 17'h0 : rsp_n;
+         q_n[q_wr[QB-1:0]]    <= rsp_n;
+         q_wr <= q_wr + 'h1;
+      end
+      if (r_fire & ~r_val) begin
+         q_addr[i_idx] <= r_addr + 'h1;
+         q_left[i_idx] <= q_left[i_idx] - 'h1;
+      end
+      if (i_next) q_is <= q_is + 'h1;
+      if (o_pop)  q_rd <= q_rd + 'h1;
+      if (g_state == G_LOAD) g_idx <= bank_rdata[r_bank_d];
+      g_state  <= next_g_state;
+      r_fire_d <= r_fire;
+      r_idx_d  <= r_fire & q_gat[i_idx] & ~r_val;
+      r_bank_d <= r_addr[LB-1:0];
+      d_cnt    <= d_cnt + (r_fire & ~r_val) - d_pop; //- A gather reserves with the index
+   end
+end
+
+//****************************
+//* Banks
+//****************************
+logic [BW-1:0] axi_rdata  [BANKS-1:0];
+logic [LB-1:0] axi_bank_d;
+logic [BW-32-1:0] filler;
+assign filler = 'h0;
+
+genvar b;
+generate
+for (b=0; b<BANKS; b=b+1) begin: bank
+   logic        a_in, a_rd, h_sel;
+   logic [31:0] a_addr;
+   assign a_in   = in_en & in_addr[LB-1:0] == b;
+   assign a_rd   = r_fire & r_addr[LB-1:0] == b;
+   assign a_addr = a_in ? in_addr >> LB : r_addr >> LB;
+   assign h_sel  = mem_valid_axi & mem_addr_axi[LB-1:0] == b;
+
+   DPRAM #(
+     .ADDR_W     (32),
+     .DATA_W     (BW),
+     .MEMSIZE_KB (MEMSIZE_KB/BANKS),
+     .MEMORY_PRIMITIVE (MEMORY_PRIMITIVE)
+   ) dp_ram (
+     .clk   ({clk_ctrl,         clk_ctrl}),
+     .rst_n ({clk_ctrl_rst_low, clk_ctrl_rst_low}),
+     .en    ({h_sel,                 a_in | a_rd}),
+     .we    ({h_sel & mem_wstrb_axi, a_in & in_we}),
+     .addr  ({mem_addr_axi >> LB,    a_addr}),
+     .din   ({{filler,mem_wdata_axi}, in_din}),
+     .dout  ({bank_rdata[b], axi_rdata[b]}));
+end
+endgenerate
+
+always @(posedge clk_ctrl) begin
+   if (~clk_ctrl_rst_low) axi_bank_d <= 'h0;
+   else                   axi_bank_d <= mem_addr_axi[LB-1:0];
+end
+
+assign mem_rdata_axi = axi_rdata[axi_bank_d][31:0];
+
+//****************************
+//* Read data and output
+//****************************
+logic [BW-1:0] d_mem [DATA_Q-1:0];
+logic   [DB:0] d_wp, d_rp;
+logic          d_valid;
+logic   [1:0]  o_state;
+logic   [1:0]  next_o_state;
+logic  [16:0]  o_left;
+logic  [16:0]  next_o_left;
+logic [QB-1:0] o_idx;
+logic          o_pend;
+
+assign d_valid = d_wp != d_rp;
+assign o_idx   = q_rd[QB-1:0];
+assign o_pend  = q_rd != q_wr;
+
+always @( * ) begin
+   next_o_state = o_state;
+   next_o_left  = o_left;
+   d_pop = 1'b0;
+   o_pop = 1'b0;
+
+   stream_out_TVALID = 1'b0;
+   stream_out_TLAST  = 1'b0;
+   stream_out_TKEEP  = {BWB{1'b1}};
+   stream_out_TDATA  = 'h0;
+
+   case (o_state)
+      O_H1: begin
+         stream_out_TVALID = o_pend;
+         stream_out_TDATA  = q_h1[o_idx];
+         if (o_pend & stream_out_TREADY) begin
+            next_o_left  = q_n[o_idx];
+            next_o_state = q_hl[o_idx] & ~q_ack[o_idx] ? O_H2 : O_DATA;
+         end
+      end
+      O_H2: begin
+         stream_out_TVALID = 1'b1;
+         stream_out_TDATA  = q_h2[o_idx];
+         if (stream_out_TREADY) next_o_state = O_DATA;
+      end
+      O_DATA: begin
+         stream_out_TVALID = q_ack[o_idx] | d_valid;
+         stream_out_TDATA  = q_ack[o_idx] ? 'h0 : d_mem[d_rp[DB-1:0]];
+         stream_out_TLAST  = o_left == 1;
+         if (stream_out_TVALID & stream_out_TREADY) begin
+            d_pop       = ~q_ack[o_idx];
+            next_o_left = o_left - 'h1;
+            if (o_left == 1) begin
+               o_pop        = 1'b1;
+               next_o_state = O_H1;
+            end
+         end
+      end
+      default: next_o_state = O_H1;
+   endcase
+end
+
+always @(posedge clk_ctrl) begin
+   if (~clk_ctrl_rst_low) begin
+      o_state <= O_H1;
+      o_left  <= 'h0;
+      d_wp    <= 'h0;
+      d_rp    <= 'h0;
+      for (i=0; i<DATA_Q; i=i+1) d_mem[i] <= 'h0;
+   end else begin
+      o_state <= next_o_state;
+      o_left  <= next_o_left;
+      if (r_fire_d & ~r_idx_d) begin
+         d_mem[d_wp[DB-1:0]] <= bank_rdata[r_bank_d];
+         d_wp <= d_wp + 'h1;
+      end
+      if (d_pop) d_rp <= d_rp + 'h1;
+   end
+end
+
+endmodule
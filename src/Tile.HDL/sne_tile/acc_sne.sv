@@ -310,6 +310,10 @@ module acc_sne #(
       .pcpi_idle         (1'b1),
       .fifo_0A_en        (),
       .fifo_0A_addr      (),
+      .fifo_0A_din       (),
+      .spill_en          (1'b0),
+      .spill_base        (32'h0),
+      .spill_size_w      (4'h0),
       .mem_rdata_a       (mm_mem_rdata),
       .mem_addr_a        (mm_mem_addr),
       .mem_wdata_a       (mm_mem_wdata),
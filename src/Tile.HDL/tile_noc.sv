@@ -39,6 +39,7 @@ module tile_noc #(
    parameter BIG    = 0,
    parameter OFFSET = 0,
    parameter LEVEL  = 0,
+   parameter PORTS  = 4,  //- Columns of the DRAM tile on this switch
    //- For Dispatcher
    parameter DISPATCHER = 0,
    parameter END = 0,
@@ -112,7 +113,8 @@ in_dest#(
    .BIG    (BIG),
    .BW     (BW),
    .OFFSET (OFFSET),
-   .LEVEL  (LEVEL) 
+   .LEVEL  (LEVEL),
+   .PORTS  (PORTS)
 ) in_dest_left(
    .clk_line           (clk_line),
    .rst                (clk_line_rst_low),
@@ -136,7 +138,8 @@ in_dest#(
    .BIG    (BIG),
    .BW     (BW),
    .OFFSET (OFFSET),
-   .LEVEL  (LEVEL) 
+   .LEVEL  (LEVEL),
+   .PORTS  (PORTS)
 )in_dest_top(
    .clk_line           (clk_line),
    .rst                (clk_line_rst_low),
@@ -159,7 +162,8 @@ in_dest#(
    .BIG   (BIG),
    .BW     (BW),
    .OFFSET (OFFSET),
-   .LEVEL (LEVEL) 
+   .LEVEL  (LEVEL),
+   .PORTS  (PORTS)
 )in_dest_right(
    .clk_line           (clk_line),
    .rst                (clk_line_rst_low),
@@ -184,7 +188,8 @@ in_dest#(
    .OFFSET (OFFSET),
    .DISPATCHER (DISPATCHER),
    .END (END),
-   .LEVEL (LEVEL) 
+   .LEVEL  (LEVEL),
+   .PORTS  (PORTS)
 )in_dest_bottom(
    .clk_line           (clk_line),
    .rst                (clk_line_rst_low),
@@ -207,7 +212,8 @@ in_dest#(
    .BIG   (BIG),
    .BW     (BW),
    .OFFSET (OFFSET),
-   .LEVEL (LEVEL) 
+   .LEVEL  (LEVEL),
+   .PORTS  (PORTS)
 )in_dest_local(
    .clk_line           (clk_line),
    .rst                (clk_line_rst_low),
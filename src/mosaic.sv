@@ -50,6 +50,7 @@ module mosaic #(
    parameter S_AXI_CAC_SZ = 4,  // RESPONSE
    parameter S_AXI_PRT_SZ = 3,  // RESPONSE
    parameter S_AXI_QOS_SZ = 4,  // RESPONSE
+   parameter DRAM_TILES   = `DRAM_TILES, //- DRAM tiles, one memory channel each
    `endif
    parameter BW          = `NOC_BW,
    parameter BWB         = BW/8,    //- Width of TKEEP and write strobes
@@ -108,47 +109,47 @@ module mosaic #(
    // Memory Manager
    ////////////////////
    //- ADDRESS WRITE
-   input  logic                    s_axi_awready,
-   output logic                    s_axi_awvalid,
-   output logic  [S_AXI_ID_SZ-1:0] s_axi_awid,
-   output logic [S_AXI_ADR_SZ-1:0] s_axi_awaddr,
-   output logic [S_AXI_LEN_SZ-1:0] s_axi_awlen,
-   output logic [S_AXI_SZE_SZ-1:0] s_axi_awsize,
-   output logic [S_AXI_BRT_SZ-1:0] s_axi_awburst,
-   output logic                    s_axi_awlock,
-   output logic [S_AXI_CAC_SZ-1:0] s_axi_awcache,
-   output logic [S_AXI_PRT_SZ-1:0] s_axi_awprot,
-   output logic [S_AXI_QOS_SZ-1:0] s_axi_awqos,
+   input  logic              [DRAM_TILES-1:0] s_axi_awready,
+   output logic              [DRAM_TILES-1:0] s_axi_awvalid,
+   output logic  [DRAM_TILES*S_AXI_ID_SZ-1:0] s_axi_awid,
+   output logic [DRAM_TILES*S_AXI_ADR_SZ-1:0] s_axi_awaddr,
+   output logic [DRAM_TILES*S_AXI_LEN_SZ-1:0] s_axi_awlen,
+   output logic [DRAM_TILES*S_AXI_SZE_SZ-1:0] s_axi_awsize,
+   output logic [DRAM_TILES*S_AXI_BRT_SZ-1:0] s_axi_awburst,
+   output logic              [DRAM_TILES-1:0] s_axi_awlock,
+   output logic [DRAM_TILES*S_AXI_CAC_SZ-1:0] s_axi_awcache,
+   output logic [DRAM_TILES*S_AXI_PRT_SZ-1:0] s_axi_awprot,
+   output logic [DRAM_TILES*S_AXI_QOS_SZ-1:0] s_axi_awqos,
    //- DATA WRITE
-   input  logic                    s_axi_wready,
-   output logic                    s_axi_wvalid,
-   output logic                    s_axi_wlast,
-   output logic [S_AXI_DAT_SZ-1:0] s_axi_wdata,
-   output logic [S_AXI_STB_SZ-1:0] s_axi_wstrb,
+   input  logic              [DRAM_TILES-1:0] s_axi_wready,
+   output logic              [DRAM_TILES-1:0] s_axi_wvalid,
+   output logic              [DRAM_TILES-1:0] s_axi_wlast,
+   output logic [DRAM_TILES*S_AXI_DAT_SZ-1:0] s_axi_wdata,
+   output logic [DRAM_TILES*S_AXI_STB_SZ-1:0] s_axi_wstrb,
    //- VALID WRITE
-   output  logic                   s_axi_bready,
-   input logic                     s_axi_bvalid,
-   input logic   [S_AXI_ID_SZ-1:0] s_axi_bid,
-   input logic  [S_AXI_RSP_SZ-1:0] s_axi_bresp,
+   output logic              [DRAM_TILES-1:0] s_axi_bready,
+   input  logic              [DRAM_TILES-1:0] s_axi_bvalid,
+   input  logic  [DRAM_TILES*S_AXI_ID_SZ-1:0] s_axi_bid,
+   input  logic [DRAM_TILES*S_AXI_RSP_SZ-1:0] s_axi_bresp,
    //- ADDRESS READ
-   input  logic                    s_axi_arready,
-   output logic                    s_axi_arvalid,
-   output logic [S_AXI_ID_SZ-1:0]  s_axi_arid,
-   output logic [S_AXI_ADR_SZ-1:0] s_axi_araddr,
-   output logic [S_AXI_LEN_SZ-1:0] s_axi_arlen,
-   output logic [S_AXI_SZE_SZ-1:0] s_axi_arsize,
-   output logic [S_AXI_BRT_SZ-1:0] s_axi_arburst,
-   output logic                    s_axi_arlock,
-   output logic [S_AXI_CAC_SZ-1:0] s_axi_arcache,
-   output logic [S_AXI_PRT_SZ-1:0] s_axi_arprot,
-   output logic [S_AXI_QOS_SZ-1:0] s_axi_arqos,
+   input  logic              [DRAM_TILES-1:0] s_axi_arready,
+   output logic              [DRAM_TILES-1:0] s_axi_arvalid,
+   output logic  [DRAM_TILES*S_AXI_ID_SZ-1:0] s_axi_arid,
+   output logic [DRAM_TILES*S_AXI_ADR_SZ-1:0] s_axi_araddr,
+   output logic [DRAM_TILES*S_AXI_LEN_SZ-1:0] s_axi_arlen,
+   output logic [DRAM_TILES*S_AXI_SZE_SZ-1:0] s_axi_arsize,
+   output logic [DRAM_TILES*S_AXI_BRT_SZ-1:0] s_axi_arburst,
+   output logic              [DRAM_TILES-1:0] s_axi_arlock,
+   output logic [DRAM_TILES*S_AXI_CAC_SZ-1:0] s_axi_arcache,
+   output logic [DRAM_TILES*S_AXI_PRT_SZ-1:0] s_axi_arprot,
+   output logic [DRAM_TILES*S_AXI_QOS_SZ-1:0] s_axi_arqos,
    //- RESPONSE READ
-   output logic                    s_axi_rready,
-   input  logic                    s_axi_rvalid,
-   input  logic                    s_axi_rlast,
-   input  logic [S_AXI_DAT_SZ-1:0] s_axi_rdata,
-   input  logic [S_AXI_ID_SZ-1:0]  s_axi_rid,
-   input  logic [S_AXI_RSP_SZ-1:0] s_axi_rresp,
+   output logic              [DRAM_TILES-1:0] s_axi_rready,
+   input  logic              [DRAM_TILES-1:0] s_axi_rvalid,
+   input  logic              [DRAM_TILES-1:0] s_axi_rlast,
+   input  logic [DRAM_TILES*S_AXI_DAT_SZ-1:0] s_axi_rdata,
+   input  logic  [DRAM_TILES*S_AXI_ID_SZ-1:0] s_axi_rid,
+   input  logic [DRAM_TILES*S_AXI_RSP_SZ-1:0] s_axi_rresp,
 
    input logic clk_memory,
    input logic clk_memory_rst,
@@ -180,8 +181,12 @@ localparam [BITS_TILE_TYPE*TILES-1:0] TILE_TYPE = `TILE_TYPE;
 //- Used for the AXI Controller 
 localparam AXI_UX_ADDR_TILE = `AXI_UX_ADDR_TILE; //- Bits to address tiles in the AXI CONTROLLER ~log2(TILES)
 localparam AXI_TILES        = `AXI_TILES;        //- Number of tiles that the Controller sees 
+`ifdef DDR4_CTRL
+localparam DRAM_COLS        = `DRAM_COLS;        //- Columns served by each DRAM tile
+`endif
 localparam AXI_OUTADR       = `AXI_OUTADR;       
 localparam NOC_BUFFER_ADDR_W  = `NOC_BUFFER_ADDR_W;
+localparam BARRIER_GROUPS = 4; //- Set by rvControl[7:4] in the pico tiles
 ///////////////////////////////////////
 // Signals
 ///////////////////////////////////////
@@ -266,6 +271,11 @@ logic       [3:0] stream_in_TLAST  [0:TILES-1];
 logic  [4*BW-1:0] stream_in_TDATA  [0:TILES-1];
 logic [4*BWB-1:0] stream_in_TKEEP  [0:TILES-1];
 
+//- Barrier network
+logic [TILES*BARRIER_GROUPS-1:0] barrier_member;
+logic [TILES*BARRIER_GROUPS-1:0] barrier_arrive;
+logic       [BARRIER_GROUPS-1:0] barrier_sense;
+
 `ifdef DDR4_CTRL
   //- DDR4 manager
   logic     [COL-1:0] stream_out_mem_mgr_TVALID;
@@ -424,6 +434,17 @@ generate
   end
 endgenerate
 
+Barrier#(
+  .ROW    (ROW),
+  .COL    (COL),
+  .GROUPS (BARRIER_GROUPS)
+) barrier (
+  .clk_control         (clk_control),
+  .clk_control_rst_low (clk_control_rst_low),
+  .barrier_member      (barrier_member),
+  .barrier_arrive      (barrier_arrive),
+  .barrier_sense       (barrier_sense));
+
 S_RESETTER_line S_RESET_clk_line(
 	.clk                 	 (clk_line),
 	.rst                 	 (clk_line_rst),
@@ -569,14 +590,6 @@ S_CONTROLLER_USS#(
 
 `ifdef DDR4_CTRL
 
-  assign tile_S_AXI_AWADDR[TILES]= tile_S_AXI_AWADDR_v[(AXI_OUTADR*(TILES+1))-1:AXI_OUTADR*TILES]; 
-  assign tile_S_AXI_WDATA[TILES] = tile_S_AXI_WDATA_v[(BW_AXI*(TILES+1))-1:BW_AXI*TILES]; 
-  assign tile_S_AXI_WSTRB[TILES] = tile_S_AXI_WSTRB_v[(BWB_AXI*(TILES+1))-1:BWB_AXI*TILES]; 
-  assign tile_S_AXI_BRESP_v[(2*(TILES+1))-1:2*TILES] = tile_S_AXI_BRESP[TILES]; 
-  assign tile_S_AXI_ARADDR[TILES]= tile_S_AXI_ARADDR_v[(AXI_OUTADR*(TILES+1))-1:AXI_OUTADR*TILES]; 
-  assign tile_S_AXI_RDATA_v[(BW*(TILES+1))-1:BW*TILES]=tile_S_AXI_RDATA[TILES]; 
-  assign tile_S_AXI_RRESP_v[(2*(TILES+1))-1:2*TILES]=tile_S_AXI_RRESP[TILES];
-
   S_RESETTER_control S_RESET_clk_memory(
 	  .clk                 	 (clk_memory ),
 	  .rst                 	 (clk_memory_rst ),
@@ -584,91 +597,107 @@ S_CONTROLLER_USS#(
 	  .reset_out_active_low	 (clk_memory_rst_low ),
 	  .init_done           	 (clk_memory_init_done ));
 
-  Tile_mem_mgr#(
-    .AXI_ADDR (AXI_OUTADR),
-    .COL      (COL)
-  ) tile_mem_mgr_inst(
-   .stream_in_TVALID        (stream_in_mem_mgr_TVALID),
-   .stream_in_TREADY        (stream_in_mem_mgr_TREADY),
-   .stream_in_TDATA         (stream_in_mem_mgr_TDATA),
-   .stream_in_TKEEP         (stream_in_mem_mgr_TKEEP),
-   .stream_in_TLAST         (stream_in_mem_mgr_TLAST),
-   .stream_out_TVALID       (stream_out_mem_mgr_TVALID),
-   .stream_out_TREADY       (stream_out_mem_mgr_TREADY),
-   .stream_out_TDATA        (stream_out_mem_mgr_TDATA),
-   .stream_out_TKEEP        (stream_out_mem_mgr_TKEEP),
-   .stream_out_TLAST        (stream_out_mem_mgr_TLAST),
-   //- AXI bus
-   .control_S_AXI_AWADDR 	  (tile_S_AXI_AWADDR[TILES]), 
-   .control_S_AXI_AWVALID	  (tile_S_AXI_AWVALID[TILES]),
-   .control_S_AXI_AWREADY	  (tile_S_AXI_AWREADY[TILES]),
-   .control_S_AXI_WDATA  	  (tile_S_AXI_WDATA[TILES]),
-   .control_S_AXI_WSTRB 	  (tile_S_AXI_WSTRB[TILES]),
-   .control_S_AXI_WVALID	  (tile_S_AXI_WVALID[TILES]),
-   .control_S_AXI_WREADY	  (tile_S_AXI_WREADY[TILES]),
-   .control_S_AXI_BRESP 	  (tile_S_AXI_BRESP[TILES]),
-   .control_S_AXI_BVALID	  (tile_S_AXI_BVALID[TILES]),
-   .control_S_AXI_BREADY	  (tile_S_AXI_BREADY[TILES]),
-   .control_S_AXI_ARADDR	  (tile_S_AXI_ARADDR[TILES]),
-   .control_S_AXI_ARVALID	  (tile_S_AXI_ARVALID[TILES]),
-   .control_S_AXI_ARREADY	  (tile_S_AXI_ARREADY[TILES]),
-   .control_S_AXI_RDATA 	  (tile_S_AXI_RDATA[TILES]),
-   .control_S_AXI_RRESP 	  (tile_S_AXI_RRESP[TILES]),
-   .control_S_AXI_RVALID	  (tile_S_AXI_RVALID[TILES]),
-   .control_S_AXI_RREADY 	  (tile_S_AXI_RREADY[TILES]),
-	//- MEMORY CONTROLLER
-   //- ADDRESS WRITE
-   .s_axi_awready      (s_axi_awready),
-   .s_axi_awvalid      (s_axi_awvalid),
-   .s_axi_awid         (s_axi_awid),
-   .s_axi_awaddr       (s_axi_awaddr),
-   .s_axi_awlen        (s_axi_awlen),
-   .s_axi_awsize       (s_axi_awsize),
-   .s_axi_awburst      (s_axi_awburst),
-   .s_axi_awlock       (s_axi_awlock),
-   .s_axi_awcache      (s_axi_awcache),
-   .s_axi_awprot       (s_axi_awprot),
-   .s_axi_awqos        (s_axi_awqos),
-  //- DATA WRITE
-   .s_axi_wready      (s_axi_wready),
-   .s_axi_wvalid      (s_axi_wvalid),
-   .s_axi_wlast       (s_axi_wlast),
-   .s_axi_wdata       (s_axi_wdata),
-   .s_axi_wstrb       (s_axi_wstrb),
-  //- VALID WRITE
-   .s_axi_bready      (s_axi_bready),
-   .s_axi_bvalid      (s_axi_bvalid),
-   .s_axi_bid         (s_axi_bid),
-   .s_axi_bresp       (s_axi_bresp),
-  //- ADDRESS READ
-   .s_axi_arready     (s_axi_arready),
-   .s_axi_arvalid     (s_axi_arvalid),
-   .s_axi_arid        (s_axi_arid),
-   .s_axi_araddr      (s_axi_araddr),
-   .s_axi_arlen       (s_axi_arlen),
-   .s_axi_arsize      (s_axi_arsize),
-   .s_axi_arburst     (s_axi_arburst),
-   .s_axi_arlock      (s_axi_arlock),
-   .s_axi_arcache     (s_axi_arcache),
-   .s_axi_arprot      (s_axi_arprot),
-   .s_axi_arqos       (s_axi_arqos),
-  //- RESPONSE READ
-   .s_axi_rready      (s_axi_rready),
-   .s_axi_rvalid      (s_axi_rvalid),
-   .s_axi_rlast       (s_axi_rlast),
-   .s_axi_rdata       (s_axi_rdata),
-   .s_axi_rid         (s_axi_rid),
-   .s_axi_rresp       (s_axi_rresp),
-  //- Clock and reset
-	 .clk_memory           (clk_memory),
-	 .clk_memory_rst_high  (clk_memory_rst_high),
-   .clk_memory_rst_low   (clk_memory_rst_low),  
-   .clk_control    	     (clk_control),
-   .clk_control_rst_low  (clk_control_rst_low),
-   .clk_control_rst_high (clk_control_rst_high),
-   .clk_line             (clk_line),
-   .clk_line_rst_high    (clk_line_rst_high),
-   .clk_line_rst_low     (clk_line_rst_low));
+  //- One DRAM tile per memory channel, each one on DRAM_COLS columns
+  genvar k;
+  generate
+  for (k = 0; k < DRAM_TILES; k = k + 1) begin: g_mem_mgr
+    assign tile_S_AXI_AWADDR[TILES+k]= tile_S_AXI_AWADDR_v[(AXI_OUTADR*(TILES+k+1))-1:AXI_OUTADR*(TILES+k)]; 
+    assign tile_S_AXI_WDATA[TILES+k] = tile_S_AXI_WDATA_v[(BW_AXI*(TILES+k+1))-1:BW_AXI*(TILES+k)]; 
+    assign tile_S_AXI_WSTRB[TILES+k] = tile_S_AXI_WSTRB_v[(BWB_AXI*(TILES+k+1))-1:BWB_AXI*(TILES+k)]; 
+    assign tile_S_AXI_BRESP_v[(2*(TILES+k+1))-1:2*(TILES+k)] = tile_S_AXI_BRESP[TILES+k]; 
+    assign tile_S_AXI_ARADDR[TILES+k]= tile_S_AXI_ARADDR_v[(AXI_OUTADR*(TILES+k+1))-1:AXI_OUTADR*(TILES+k)]; 
+    assign tile_S_AXI_RDATA_v[(BW*(TILES+k+1))-1:BW*(TILES+k)]=tile_S_AXI_RDATA[TILES+k]; 
+    assign tile_S_AXI_RRESP_v[(2*(TILES+k+1))-1:2*(TILES+k)]=tile_S_AXI_RRESP[TILES+k];
+
+    Tile_mem_mgr#(
+      .AXI_ADDR (AXI_OUTADR),
+      .COL      (DRAM_COLS),
+      .Y0       (k*DRAM_COLS),
+      .CHANNEL  (k)
+    ) tile_mem_mgr_inst(
+     .stream_in_TVALID        (stream_in_mem_mgr_TVALID[k*DRAM_COLS +: DRAM_COLS]),
+     .stream_in_TREADY        (stream_in_mem_mgr_TREADY[k*DRAM_COLS +: DRAM_COLS]),
+     .stream_in_TDATA         (stream_in_mem_mgr_TDATA[k*DRAM_COLS*BW +: DRAM_COLS*BW]),
+     .stream_in_TKEEP         (stream_in_mem_mgr_TKEEP[k*DRAM_COLS*BWB +: DRAM_COLS*BWB]),
+     .stream_in_TLAST         (stream_in_mem_mgr_TLAST[k*DRAM_COLS +: DRAM_COLS]),
+     .stream_out_TVALID       (stream_out_mem_mgr_TVALID[k*DRAM_COLS +: DRAM_COLS]),
+     .stream_out_TREADY       (stream_out_mem_mgr_TREADY[k*DRAM_COLS +: DRAM_COLS]),
+     .stream_out_TDATA        (stream_out_mem_mgr_TDATA[k*DRAM_COLS*BW +: DRAM_COLS*BW]),
+     .stream_out_TKEEP        (stream_out_mem_mgr_TKEEP[k*DRAM_COLS*BWB +: DRAM_COLS*BWB]),
+     .stream_out_TLAST        (stream_out_mem_mgr_TLAST[k*DRAM_COLS +: DRAM_COLS]),
+     //- AXI bus
+     .control_S_AXI_AWADDR 	  (tile_S_AXI_AWADDR[TILES+k]), 
+     .control_S_AXI_AWVALID	  (tile_S_AXI_AWVALID[TILES+k]),
+     .control_S_AXI_AWREADY	  (tile_S_AXI_AWREADY[TILES+k]),
+     .control_S_AXI_WDATA  	  (tile_S_AXI_WDATA[TILES+k]),
+     .control_S_AXI_WSTRB 	  (tile_S_AXI_WSTRB[TILES+k]),
+     .control_S_AXI_WVALID	  (tile_S_AXI_WVALID[TILES+k]),
+     .control_S_AXI_WREADY	  (tile_S_AXI_WREADY[TILES+k]),
+     .control_S_AXI_BRESP 	  (tile_S_AXI_BRESP[TILES+k]),
+     .control_S_AXI_BVALID	  (tile_S_AXI_BVALID[TILES+k]),
+     .control_S_AXI_BREADY	  (tile_S_AXI_BREADY[TILES+k]),
+     .control_S_AXI_ARADDR	  (tile_S_AXI_ARADDR[TILES+k]),
+     .control_S_AXI_ARVALID	  (tile_S_AXI_ARVALID[TILES+k]),
+     .control_S_AXI_ARREADY	  (tile_S_AXI_ARREADY[TILES+k]),
+     .control_S_AXI_RDATA 	  (tile_S_AXI_RDATA[TILES+k]),
+     .control_S_AXI_RRESP 	  (tile_S_AXI_RRESP[TILES+k]),
+     .control_S_AXI_RVALID	  (tile_S_AXI_RVALID[TILES+k]),
+     .control_S_AXI_RREADY 	  (tile_S_AXI_RREADY[TILES+k]),
+     //- MEMORY CONTROLLER
+     //- ADDRESS WRITE
+     .s_axi_awready      (s_axi_awready[k]),
+     .s_axi_awvalid      (s_axi_awvalid[k]),
+     .s_axi_awid         (s_axi_awid[k*S_AXI_ID_SZ +: S_AXI_ID_SZ]),
+     .s_axi_awaddr       (s_axi_awaddr[k*S_AXI_ADR_SZ +: S_AXI_ADR_SZ]),
+     .s_axi_awlen        (s_axi_awlen[k*S_AXI_LEN_SZ +: S_AXI_LEN_SZ]),
+     .s_axi_awsize       (s_axi_awsize[k*S_AXI_SZE_SZ +: S_AXI_SZE_SZ]),
+     .s_axi_awburst      (s_axi_awburst[k*S_AXI_BRT_SZ +: S_AXI_BRT_SZ]),
+     .s_axi_awlock       (s_axi_awlock[k]),
+     .s_axi_awcache      (s_axi_awcache[k*S_AXI_CAC_SZ +: S_AXI_CAC_SZ]),
+     .s_axi_awprot       (s_axi_awprot[k*S_AXI_PRT_SZ +: S_AXI_PRT_SZ]),
+     .s_axi_awqos        (s_axi_awqos[k*S_AXI_QOS_SZ +: S_AXI_QOS_SZ]),
+    //- DATA WRITE
+     .s_axi_wready      (s_axi_wready[k]),
+     .s_axi_wvalid      (s_axi_wvalid[k]),
+     .s_axi_wlast       (s_axi_wlast[k]),
+     .s_axi_wdata       (s_axi_wdata[k*S_AXI_DAT_SZ +: S_AXI_DAT_SZ]),
+     .s_axi_wstrb       (s_axi_wstrb[k*S_AXI_STB_SZ +: S_AXI_STB_SZ]),
+    //- VALID WRITE
+     .s_axi_bready      (s_axi_bready[k]),
+     .s_axi_bvalid      (s_axi_bvalid[k]),
+     .s_axi_bid         (s_axi_bid[k*S_AXI_ID_SZ +: S_AXI_ID_SZ]),
+     .s_axi_bresp       (s_axi_bresp[k*S_AXI_RSP_SZ +: S_AXI_RSP_SZ]),
+    //- ADDRESS READ
+     .s_axi_arready     (s_axi_arready[k]),
+     .s_axi_arvalid     (s_axi_arvalid[k]),
+     .s_axi_arid        (s_axi_arid[k*S_AXI_ID_SZ +: S_AXI_ID_SZ]),
+     .s_axi_araddr      (s_axi_araddr[k*S_AXI_ADR_SZ +: S_AXI_ADR_SZ]),
+     .s_axi_arlen       (s_axi_arlen[k*S_AXI_LEN_SZ +: S_AXI_LEN_SZ]),
+     .s_axi_arsize      (s_axi_arsize[k*S_AXI_SZE_SZ +: S_AXI_SZE_SZ]),
+     .s_axi_arburst     (s_axi_arburst[k*S_AXI_BRT_SZ +: S_AXI_BRT_SZ]),
+     .s_axi_arlock      (s_axi_arlock[k]),
+     .s_axi_arcache     (s_axi_arcache[k*S_AXI_CAC_SZ +: S_AXI_CAC_SZ]),
+     .s_axi_arprot      (s_axi_arprot[k*S_AXI_PRT_SZ +: S_AXI_PRT_SZ]),
+     .s_axi_arqos       (s_axi_arqos[k*S_AXI_QOS_SZ +: S_AXI_QOS_SZ]),
+    //- RESPONSE READ
+     .s_axi_rready      (s_axi_rready[k]),
+     .s_axi_rvalid      (s_axi_rvalid[k]),
+     .s_axi_rlast       (s_axi_rlast[k]),
+     .s_axi_rdata       (s_axi_rdata[k*S_AXI_DAT_SZ +: S_AXI_DAT_SZ]),
+     .s_axi_rid         (s_axi_rid[k*S_AXI_ID_SZ +: S_AXI_ID_SZ]),
+     .s_axi_rresp       (s_axi_rresp[k*S_AXI_RSP_SZ +: S_AXI_RSP_SZ]),
+    //- Clock and reset
+     .clk_memory           (clk_memory),
+     .clk_memory_rst_high  (clk_memory_rst_high),
+     .clk_memory_rst_low   (clk_memory_rst_low),  
+     .clk_control    	     (clk_control),
+     .clk_control_rst_low  (clk_control_rst_low),
+     .clk_control_rst_high (clk_control_rst_high),
+     .clk_line             (clk_line),
+     .clk_line_rst_high    (clk_line_rst_high),
+     .clk_line_rst_low     (clk_line_rst_low));
+  end
+  endgenerate
 `endif
 
 
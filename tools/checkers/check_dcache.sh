@@ -0,0 +1,46 @@
+# *************************************************************************
+# 
+# *** Copyright Notice ***
+#
+# P38 heterogeneous multi-tiled system with support for message queues 
+# (MoSAIC) Copyright (c) 2024, The Regents of the University of California, 
+# through Lawrence Berkeley National Laboratory (subject to receipt of
+# any required approvals from the U.S. Dept. of Energy). All rights reserved.
+# 
+# If you have questions about your rights to use or distribute this software,
+# please contact Berkeley Lab's Intellectual Property Office at
+# IPO@lbl.gov.
+#
+# NOTICE.  This Software was developed under funding from the U.S. Department
+# of Energy and the U.S. Government consequently retains certain rights.  As
+# such, the U.S. Government has been granted for itself and others acting on
+# its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+# Software to reproduce, distribute copies to the public, prepare derivative 
+# works, and perform publicly and display publicly, and to permit others 
+# to do so.
+#
+# *************************************************************************
+thepath=$1
+
+#- The words read through the data cache are in the scratchpad
+mem_file="$thepath/tile_01.dat"
+echo 'INFO: Checking for the D0C0 words in the scratchpad'
+c=$(grep -c d0c000 $mem_file)
+if [ $c -ge 32 ]
+then
+  echo "SUCCESS: There are $c>=32 D0C000xx words in the scratchpad at tile 01\n"
+else
+  echo "FAIL: there are $c D0C000xx words in the scratchpad at tile 01. Expecting 32\n"
+fi
+
+#- The pico checked the loads and the hit/miss counters
+mem_file="$thepath/tile_00.dat"
+echo 'INFO: Checking for the data cache result at tile 00'
+c=$(grep -c 900d900d $mem_file)
+b=$(grep -c bad0bad0 $mem_file)
+if [[ $c -ge 16 && $b -eq 0 ]]
+then
+  echo "SUCCESS: There are $c>=16 900D900D words at tile 00\n"
+else
+  echo "FAIL: there are $c 900D900D and $b BAD0BAD0 words at tile 00. Expecting 16 and 0\n"
+fi
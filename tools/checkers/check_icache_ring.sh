@@ -0,0 +1,46 @@
+# *************************************************************************
+# 
+# *** Copyright Notice ***
+#
+# P38 heterogeneous multi-tiled system with support for message queues 
+# (MoSAIC) Copyright (c) 2024, The Regents of the University of California, 
+# through Lawrence Berkeley National Laboratory (subject to receipt of
+# any required approvals from the U.S. Dept. of Energy). All rights reserved.
+# 
+# If you have questions about your rights to use or distribute this software,
+# please contact Berkeley Lab's Intellectual Property Office at
+# IPO@lbl.gov.
+#
+# NOTICE.  This Software was developed under funding from the U.S. Department
+# of Energy and the U.S. Government consequently retains certain rights.  As
+# such, the U.S. Government has been granted for itself and others acting on
+# its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+# Software to reproduce, distribute copies to the public, prepare derivative 
+# works, and perform publicly and display publicly, and to permit others 
+# to do so.
+#
+# *************************************************************************
+thepath=$1
+
+#- send_msg.c fetched through the instruction cache: every pico passes
+#  the ball once and writes its words in the scratchpad at tile 01
+mem_file="$thepath/tile_01.dat"
+echo 'INFO: Checking the ring of send_msg in the scratchpad'
+for w in f0ca cafe
+do
+  c=$(grep -c ${w}00 $mem_file)
+  if [ $c -ge 15 ]
+  then
+    echo "SUCCESS: There are $c>=15 ${w} words in the scratchpad at tile 01\n"
+  else
+    echo "FAIL: there are $c ${w} words in the scratchpad at tile 01. Expecting 15\n"
+  fi
+done
+
+c=$(grep -c beef00 $mem_file)
+if [ $c -ge 270 ]
+then
+  echo "SUCCESS: There are $c>=270 BEEF words in the scratchpad at tile 01\n"
+else
+  echo "FAIL: there are $c BEEF words in the scratchpad at tile 01. Expecting 270 (18 per pico)\n"
+fi
@@ -49,10 +49,13 @@ our $axi_tile_addr_bits  = 8;
 our $axi_tile_addr_range = 256;
 our $axi_ux_addr         = 4;
 
+#- Name => [id, module, parameters]
 our %tile_type = ( 'pico' => [0, 'Tile_picorv32'],
                    'spad' => [1, 'Tile_scratchpad'], #- Scratchpad
                    'spad' => [2, 'Tile_scratchpad'], #- Scratchpad
-                   'sne' => [3, 'Tile_sne']
+                   'sne' => [3, 'Tile_sne'],
+                   'pico_fp' => [4, 'Tile_picorv32', '.FPU (1)'], #- Pico with a double precision unit
+                   'pico_pipe' => [5, 'Tile_picorv32', '.CORE (1)'] #- Pico slot with the pipelined RV32IM core
                  );
 
 
@@ -299,11 +302,29 @@ sub gen_file_list{
       print $FH "../src/Tile.HDL/cache_ctrl/dm_cache_fsm.sv\n";
       print $FH "../src/Tile.HDL/cache_ctrl/dm_cache_tag.sv\n";
    }
+   if ($param{'ddr4_flag'} & $param{'ddr_mshrs'} > 0) {
+      print $FH "../src/Tile.HDL/cache_ctrl/nb_cache.sv\n";
+   }
+
+   #- Picos with a double precision unit, fp64 accumulate in the scratchpads
+   my $pico_fp = grep { $_ eq 'pico_fp' } map { @{$_} } @{$param{'tile_array'}};
+   if ($pico_fp || $param{'spad_accum'}){
+      print $FH "../src/Tile.HDL/fp_tile/FP_adder_64_13cc.v\n";
+   }
+   if ($pico_fp){
+      print $FH "../src/Tile.HDL/fp_tile/FP_multiplier_64_10cc.v\n";
+   }
 
    if ($param{'instruction_mem'}){
+      print $FH "../src/Tile.HDL/cache_ctrl/sa_icache.sv\n";
+      print $FH "../src/Tile.HDL/cache_ctrl/icache_stream_buffer.sv\n";
       print $FH "../src/Tile.HDL/picorv32_tile/instr_mem.sv\n";
    }
 
+   if ($param{'spad_banks'} > 1){
+      print $FH "../src/Tile.HDL/scratchpad_tile/spad_banked.sv\n";
+   }
+
    if ($param{'ddr4_flag'}){
       print $FH "\n\#- ADDING FILES FOR MEMORY MANAGER\n";
       print $FH "../src/Tile.HDL/dram_tile/Tile_mem_mgr.sv\n";
@@ -311,7 +332,13 @@ sub gen_file_list{
       print $FH "../src/Tile.HDL/dram_tile/mem_mgr_axi.sv\n";
       print $FH "../src/Tile.HDL/dram_tile/mem_mgr_noc_decoder.sv\n";
       print $FH "../src/Tile.HDL/dram_tile/mem_mgr_noc_encoder.sv\n";
+      print $FH "../src/Tile.HDL/dram_tile/mem_mgr_bulk.sv\n";
+      print $FH "../src/Tile.HDL/dram_tile/mem_mgr_resp.sv\n" if ($param{'ddr_mshrs'} > 0);
+      print $FH "../src/Tile.HDL/dram_tile/mem_mgr_wcb.sv\n" if ($param{'ddr_wcb'} > 0);
+      print $FH "../src/Tile.HDL/dram_tile/mem_mgr_pf.sv\n" if ($param{'ddr_pf_streams'} > 0);
+      print $FH "../src/Tile.HDL/dram_tile/mem_mgr_stats.sv\n" if ($param{'ddr_stats'});
       print $FH "../src/Testbench/tb_memory_controller.sv\n";
+      print $FH "../src/Testbench/tb_axi_mem.sv\n" if ($param{'ddr_model'} eq 'fast');
    }
 
    close($FH);
@@ -566,13 +593,204 @@ sub check_params{
     $param{'ddr4_flag'} = 0;
   }
 
+  #- DRAM tiles along the bottom edge, each one on its own memory channel and
+  #- COL/dram_tiles columns. Addresses are interleaved every 2**dram_interleave bytes
+  if (exists $param{'dram_tiles'}){
+    die "ERROR: dram_tiles must be 1, 2 or 4\n" unless ($param{'dram_tiles'} =~ /^(1|2|4)$/);
+  }else{
+    $param{'dram_tiles'} = 1;
+  }
+  if (exists $param{'dram_interleave'}){
+    die "ERROR: dram_interleave must be 6 (64B) to 20 (1MB)\n" unless ($param{'dram_interleave'} =~ /^\d+$/ && $param{'dram_interleave'} >= 6 && $param{'dram_interleave'} <= 20);
+  }else{
+    $param{'dram_interleave'} = 12;
+  }
+  if ($param{'dram_tiles'} > 1){
+    die "ERROR: dram_tiles needs ddr4_flag\n" unless ($param{'ddr4_flag'});
+    die "ERROR: the columns must be a multiple of dram_tiles\n" if ($param{'c'} % $param{'dram_tiles'});
+    die "ERROR: dram_tiles > 1 is not supported with vivado_ip_dram\n" if ($param{'vivado_ip_dram'} && $param{'vivado'});
+  }
+
+  #- Memory behind the DRAM tiles in simulation: 'stub' (random data) or 'fast' (tb_axi_mem).
+  #- vivado_ip_dram keeps the detailed DDR4 model.
+  if (exists $param{'ddr_model'}){
+    die "ERROR: ddr_model must be stub or fast\n" unless ($param{'ddr_model'} =~ /^(stub|fast)$/);
+  }else{
+    $param{'ddr_model'} = 'stub';
+  }
+  if (exists $param{'ddr_lat_min'}){
+    die "ERROR: ddr_lat_min must be 1 to 4096 cycles\n" unless ($param{'ddr_lat_min'} =~ /^\d+$/ && $param{'ddr_lat_min'} >= 1 && $param{'ddr_lat_min'} <= 4096);
+  }else{
+    $param{'ddr_lat_min'} = 40;
+  }
+  if (exists $param{'ddr_lat_max'}){
+    die "ERROR: ddr_lat_max must be ddr_lat_min to 4096 cycles\n" unless ($param{'ddr_lat_max'} =~ /^\d+$/ && $param{'ddr_lat_max'} >= $param{'ddr_lat_min'} && $param{'ddr_lat_max'} <= 4096);
+  }else{
+    $param{'ddr_lat_max'} = $param{'ddr_lat_min'};
+  }
+  if (exists $param{'ddr_bw_pct'}){
+    die "ERROR: ddr_bw_pct must be 1 to 100\n" unless ($param{'ddr_bw_pct'} =~ /^\d+$/ && $param{'ddr_bw_pct'} >= 1 && $param{'ddr_bw_pct'} <= 100);
+  }else{
+    $param{'ddr_bw_pct'} = 100;
+  }
+  if (exists $param{'ddr_outstanding'}){
+    die "ERROR: ddr_outstanding must be 1 to 64\n" unless ($param{'ddr_outstanding'} =~ /^\d+$/ && $param{'ddr_outstanding'} >= 1 && $param{'ddr_outstanding'} <= 64);
+  }else{
+    $param{'ddr_outstanding'} = 16;
+  }
+
+  #- DRAM tile cache capacity: ddr_cache_kb (64-byte lines) overrides ddr_cache_lines
+  if (exists $param{'ddr_cache_kb'}){
+    die "ERROR: ddr_cache_kb must be a power of 2 from 1 to 1024\n" unless ($param{'ddr_cache_kb'} =~ /^(1|2|4|8|16|32|64|128|256|512|1024)$/);
+    $param{'ddr_cache_lines'} = $param{'ddr_cache_kb'}*16;
+  }
   if (exists $param{'ddr_cache_lines'}){
   }else{
     print "INFO: Setting ddr_cache_lines to default 16\n";
     $param{'ddr_cache_lines'} = 16;
   }
 
-  
+  #- Miss registers of the DRAM tile cache, 0 keeps the blocking cache
+  if (exists $param{'ddr_mshrs'}){
+    die "ERROR: ddr_mshrs must be 0, 2, 4 or 8\n" unless ($param{'ddr_mshrs'} =~ /^(0|2|4|8)$/);
+  }else{
+    $param{'ddr_mshrs'} = 0;
+  }
+
+  #- Write-combining lines in front of the DRAM tile cache (non-blocking cache only)
+  if (exists $param{'ddr_wcb'}){
+    die "ERROR: ddr_wcb must be 0, 1, 2, 4 or 8\n" unless ($param{'ddr_wcb'} =~ /^(0|1|2|4|8)$/);
+    die "ERROR: ddr_wcb needs ddr_mshrs > 0\n" if ($param{'ddr_wcb'} > 0 && $param{'ddr_mshrs'} == 0);
+  }else{
+    $param{'ddr_wcb'} = 0;
+  }
+  if (exists $param{'ddr_wcb_timeout'}){
+    die "ERROR: ddr_wcb_timeout must be 1 to 1024 cycles\n" unless ($param{'ddr_wcb_timeout'} =~ /^\d+$/ && $param{'ddr_wcb_timeout'} >= 1 && $param{'ddr_wcb_timeout'} <= 1024);
+  }else{
+    $param{'ddr_wcb_timeout'} = 64;
+  }
+
+  #- Stride prefetcher of the DRAM tile cache (non-blocking cache only)
+  if (exists $param{'ddr_pf_streams'}){
+    die "ERROR: ddr_pf_streams must be 0, 1, 2, 4 or 8\n" unless ($param{'ddr_pf_streams'} =~ /^(0|1|2|4|8)$/);
+    die "ERROR: ddr_pf_streams needs ddr_mshrs > 0\n" if ($param{'ddr_pf_streams'} > 0 && $param{'ddr_mshrs'} == 0);
+  }else{
+    $param{'ddr_pf_streams'} = 0;
+  }
+  if (exists $param{'ddr_pf_distance'}){
+    die "ERROR: ddr_pf_distance must be 1 to 16 lines\n" unless ($param{'ddr_pf_distance'} =~ /^\d+$/ && $param{'ddr_pf_distance'} >= 1 && $param{'ddr_pf_distance'} <= 16);
+  }else{
+    $param{'ddr_pf_distance'} = 4;
+  }
+  if (exists $param{'ddr_pf_degree'}){
+    die "ERROR: ddr_pf_degree must be 1 to 8 lines\n" unless ($param{'ddr_pf_degree'} =~ /^\d+$/ && $param{'ddr_pf_degree'} >= 1 && $param{'ddr_pf_degree'} <= 8);
+  }else{
+    $param{'ddr_pf_degree'} = 2;
+  }
+
+  #- Performance counters of the DRAM tiles, dumped by the testbench at the end
+  if (exists $param{'ddr_stats'}){
+    die "ERROR: ddr_stats must be 0 or 1\n" unless ($param{'ddr_stats'} =~ /^(0|1)$/);
+  }else{
+    $param{'ddr_stats'} = 0;
+  }
+
+  #- Ways and banks of the DRAM tile cache (non-blocking cache only), data in URAM
+  if (exists $param{'ddr_cache_ways'}){
+    die "ERROR: ddr_cache_ways must be 1, 2, 4 or 8\n" unless ($param{'ddr_cache_ways'} =~ /^(1|2|4|8)$/);
+  }else{
+    $param{'ddr_cache_ways'} = 1;
+  }
+  if (exists $param{'ddr_cache_banks'}){
+    die "ERROR: ddr_cache_banks must be 1, 2, 4 or 8\n" unless ($param{'ddr_cache_banks'} =~ /^(1|2|4|8)$/);
+  }else{
+    $param{'ddr_cache_banks'} = 1;
+  }
+  if (exists $param{'ddr_cache_uram'}){
+  }else{
+    $param{'ddr_cache_uram'} = 0;
+  }
+  if ($param{'ddr4_flag'}){
+    my $lines = $param{'ddr_cache_lines'};
+    die "ERROR: ddr_cache_lines must be a power of 2\n" if ($lines < 2 || ($lines & ($lines-1)));
+    if ($param{'ddr_cache_ways'} > 1 || $param{'ddr_cache_banks'} > 1){
+      die "ERROR: ddr_cache_ways and ddr_cache_banks need ddr_mshrs > 0\n" if ($param{'ddr_mshrs'} == 0);
+    }
+    die "ERROR: the DRAM tile cache needs at least 2 sets per bank\n" if ($lines/($param{'ddr_cache_ways'}*$param{'ddr_cache_banks'}) < 2);
+  }
+
+  #- Instruction cache of the picos (instruction_mem): 1 to 16 KB, 1/2/4/8 ways
+  if (exists $param{'icache_kb'}){
+    die "ERROR: icache_kb must be 1, 2, 4, 8 or 16\n" unless ($param{'icache_kb'} =~ /^(1|2|4|8|16)$/);
+  }else{
+    $param{'icache_kb'} = 4;
+  }
+  if (exists $param{'icache_ways'}){
+    die "ERROR: icache_ways must be 1, 2, 4 or 8\n" unless ($param{'icache_ways'} =~ /^(1|2|4|8)$/);
+  }else{
+    $param{'icache_ways'} = 2;
+  }
+  #- Lines prefetched after an instruction cache miss, 0 disables the prefetcher
+  if (exists $param{'icache_prefetch'}){
+    die "ERROR: icache_prefetch must be 0 to 4\n" unless ($param{'icache_prefetch'} =~ /^[0-4]$/);
+  }else{
+    $param{'icache_prefetch'} = 2;
+  }
+  if ($param{'icache_kb'}*1024/(64*$param{'icache_ways'}) < 2){
+    die "ERROR: the instruction cache needs at least 2 sets\n";
+  }
+
+  #- Read-only cache of the picos for remote loads: 8-word lines, 0 lines disables it
+  if (exists $param{'dcache_lines'}){
+    die "ERROR: dcache_lines must be 0, 8, 16, 32, 64 or 128\n" unless ($param{'dcache_lines'} =~ /^(0|8|16|32|64|128)$/);
+  }else{
+    $param{'dcache_lines'} = 0;
+  }
+  if (exists $param{'dcache_ways'}){
+    die "ERROR: dcache_ways must be 1, 2, 4 or 8\n" unless ($param{'dcache_ways'} =~ /^(1|2|4|8)$/);
+  }else{
+    $param{'dcache_ways'} = 2;
+  }
+  if ($param{'dcache_lines'} > 0){
+    die "ERROR: the data cache needs at least 2 sets\n" if ($param{'dcache_lines'}/$param{'dcache_ways'} < 2);
+    die "ERROR: the data cache is not supported with instruction_mem\n" if ($param{'instruction_mem'});
+    #- Line fills take the tile from the address, they do not go through dram_map
+    die "ERROR: the data cache is not supported with dram_tiles > 1\n" if ($param{'dram_tiles'} > 1);
+  }
+
+
+  #- Word-interleaved banks of the scratchpad tiles, 1 keeps noc_decoder + one DPRAM
+  if (exists $param{'spad_banks'}){
+    die "ERROR: spad_banks must be 1, 2, 4 or 8\n" unless ($param{'spad_banks'} =~ /^(1|2|4|8)$/);
+  }else{
+    $param{'spad_banks'} = 1;
+  }
+  #- Scratchpad tile capacity. Short packets reach the first 16 KB, mPutX/mGetX all of it
+  if (exists $param{'spad_kb'}){
+    die "ERROR: spad_kb must be a power of 2 from 16 to 4096\n" unless ($param{'spad_kb'} =~ /^\d+$/ && $param{'spad_kb'} >= 16 && $param{'spad_kb'} <= 4096 && !($param{'spad_kb'} & ($param{'spad_kb'}-1)));
+  }else{
+    $param{'spad_kb'} = 16;
+  }
+  if (exists $param{'spad_uram'}){
+    die "ERROR: spad_uram must be 0 or 1\n" unless ($param{'spad_uram'} =~ /^(0|1)$/);
+  }else{
+    $param{'spad_uram'} = 0;
+  }
+  #- Gather and scatter-add packets in the scratchpad tiles (banked scratchpad only)
+  if (exists $param{'spad_gather'}){
+    die "ERROR: spad_gather must be 0 or 1\n" unless ($param{'spad_gather'} =~ /^(0|1)$/);
+    die "ERROR: spad_gather needs spad_banks > 1\n" if ($param{'spad_gather'} && $param{'spad_banks'} == 1);
+  }else{
+    $param{'spad_gather'} = 0;
+  }
+  #- Min/max/fp64 add pairs in the scatter packets (banked scratchpad only)
+  if (exists $param{'spad_accum'}){
+    die "ERROR: spad_accum must be 0 or 1\n" unless ($param{'spad_accum'} =~ /^(0|1)$/);
+    die "ERROR: spad_accum needs spad_banks > 1\n" if ($param{'spad_accum'} && $param{'spad_banks'} == 1);
+  }else{
+    $param{'spad_accum'} = 0;
+  }
+
   #- Create build directory 
   if (-e "$param{mosaic_path}/build"){
     print "DEBUG: Build directory exists\n"
@@ -680,7 +898,10 @@ sub gen_tiles{
   #- For new tiles
   my %param = %{$_[0]};
   
-  my $new_id = 3;
+  my $new_id = 0;
+  foreach my $key (keys %tile_type){
+    $new_id = $tile_type{$key}[0] + 1 if ($tile_type{$key}[0] >= $new_id);
+  }
   if (exists $param{'new_tile'}){
     my %new_tile = %{$param{'new_tile'}};
     foreach my $key (keys %new_tile){
@@ -696,10 +917,12 @@ sub gen_tiles{
   my $fflag = 0;
   my $ctr = 0;
   foreach my $key (keys %tile_type){
-    $ctr = $ctr + 1;
     my @tile_info = @{$tile_type{$key}};
     my $num = $tile_info[0];
     my $mod = $tile_info[1];
+    my $mod_param = '';
+    $mod_param = ",\n      $tile_info[2]" if (defined $tile_info[2]);
+    $ctr = $num + 1 if ($num >= $ctr);
 
     if ($fflag == 0){
       print $FH "if (TILE_TYPE[(((i*COL+j)+1)*BITS_TILE_TYPE)-1:(i*COL+j)*BITS_TILE_TYPE]== $num ) begin : $key\n";
@@ -710,7 +933,7 @@ sub gen_tiles{
     print $FH "   $mod#(
       .AXI_ADDR (AXI_OUTADR),
       .NOC_BUFFER_ADDR_W (NOC_BUFFER_ADDR_W),
-      .BW                (BW)
+      .BW                (BW)$mod_param
     ) tile_inst(
       .plain_start_of_processing	 (sop_plain_start_of_processing),
       .stream_in_TVALID            (stream_in_TVALID[i*COL+j]),
@@ -747,7 +970,19 @@ sub gen_tiles{
       .clk_line_rst_high   	(clk_line_rst_high),
       .clk_line_rst_low     (clk_line_rst_low),
       .clk_control_rst_low 	(clk_control_rst_low),
-      .clk_control_rst_high (clk_control_rst_high));\n";
+      .clk_control_rst_high (clk_control_rst_high)";
+    #- Only the picos take part in the barrier network
+    if ($mod eq 'Tile_picorv32'){
+      print $FH ",
+      //- Barrier network
+      .barrier_member       (barrier_member[(i*COL+j)*BARRIER_GROUPS+:BARRIER_GROUPS]),
+      .barrier_arrive       (barrier_arrive[(i*COL+j)*BARRIER_GROUPS+:BARRIER_GROUPS]),
+      .barrier_sense        (barrier_sense));\n";
+    }else{
+      print $FH ");\n";
+      print $FH "   assign barrier_member[(i*COL+j)*BARRIER_GROUPS+:BARRIER_GROUPS] = 'h0;\n";
+      print $FH "   assign barrier_arrive[(i*COL+j)*BARRIER_GROUPS+:BARRIER_GROUPS] = 'h0;\n";
+    }
   }
   print $FH "end\n";
   close($FH);
@@ -765,10 +1000,14 @@ sub gen_checker{ #- FIXME: how to generalize?
    foreach my $row (@tile_array){
       my $j=0;
       foreach my $item (@{$row}){
-         if (${item} eq 'pico'){
-            print $FH "\t\$writememh(\"$param{'launch_path'}/tile_$i${j}.dat\", mosaic.row[$i].col[$j].pico.tile_inst.acc_picorv32.dp_ram.mem);\n";
+         if (${item} eq 'pico' || ${item} eq 'pico_fp' || ${item} eq 'pico_pipe'){
+            print $FH "\t\$writememh(\"$param{'launch_path'}/tile_$i${j}.dat\", mosaic.row[$i].col[$j].${item}.tile_inst.acc_picorv32.dp_ram.mem);\n";
          }elsif (${item} eq 'spad'){
-           print $FH "\t\$writememh(\"$param{'launch_path'}/tile_$i${j}.dat\", mosaic.row[$i].col[$j].spad.tile_inst.acc_scratchpad.dp_ram.mem);\n";
+           if ($param{'spad_banks'} > 1){
+             spad_banked_image($FH, $param{'spad_banks'}, $param{'spad_kb'}, "$param{'launch_path'}/tile_$i${j}.dat", "mosaic.row[$i].col[$j].spad.tile_inst.acc_scratchpad", 0);
+           }else{
+             print $FH "\t\$writememh(\"$param{'launch_path'}/tile_$i${j}.dat\", mosaic.row[$i].col[$j].spad.tile_inst.acc_scratchpad.dp_ram.mem);\n";
+           }
          }else{
            print "DEBUG: Not printing the content of tile $i$j of type $item for final checkers.\n";
          }
@@ -782,6 +1021,30 @@ sub gen_checker{ #- FIXME: how to generalize?
    close($FH);
 }
 
+#- Banked scratchpad: the words of the flat image are interleaved over
+#  the banks, copy them through a flat array to load ($load=1) or dump
+sub spad_banked_image{
+   my ($FH, $banks, $kb, $file, $path, $load) = @_;
+   my $words = $kb*1024/4;
+   my $per_bank = $words/$banks - 1; #- DPRAM keeps MEMSIZE_KB*256-1 words
+   my $last = $per_bank*$banks - 1;
+   print $FH "\tbegin\n";
+   print $FH "\t\treg [31:0] spad_img [0:$last];\n";
+   print $FH "\t\tinteger k;\n";
+   print $FH "\t\t\$readmemh(\"$file\", spad_img);\n" if ($load);
+   print $FH "\t\tfor (k=0; k<$per_bank; k=k+1) begin\n";
+   for (my $b=0; $b<$banks; $b=$b+1){
+      if ($load){
+         print $FH "\t\t\t$path.spad_banked.bank[$b].dp_ram.mem[k] = spad_img[k*$banks+$b];\n";
+      }else{
+         print $FH "\t\t\tspad_img[k*$banks+$b] = $path.spad_banked.bank[$b].dp_ram.mem[k];\n";
+      }
+   }
+   print $FH "\t\tend\n";
+   print $FH "\t\t\$writememh(\"$file\", spad_img);\n" unless ($load);
+   print $FH "\tend\n";
+}
+
 sub gen_global_defines{
 
   my %param = %{$_[0]};
@@ -812,13 +1075,33 @@ sub gen_global_defines{
       my $bin_y = sprintf("%03b", 0);
       print $FH "\`define X_DRAM $bin_x\n";
       print $FH "\`define Y_DRAM $bin_y\n";
+      my $dram_cols = $param{'c'}/$param{'dram_tiles'};
+      print $FH "\`define DRAM_TILES $param{'dram_tiles'}\n";
+      print $FH "\`define DRAM_COLS $dram_cols\n";
+      print $FH "\`define DRAM_IL $param{'dram_interleave'}\n";
       if ($param{vivado_ip_dram} & $param{vivado}){
          print $FH "\`define VIVADO_IP_DRAM\n";
+      }elsif ($param{'ddr_model'} eq 'fast'){
+         print $FH "\`define DDR_FAST_MODEL\n";
+         print $FH "\`define DDR_LAT_MIN $param{'ddr_lat_min'}\n";
+         print $FH "\`define DDR_LAT_MAX $param{'ddr_lat_max'}\n";
+         print $FH "\`define DDR_BW_PCT $param{'ddr_bw_pct'}\n";
+         print $FH "\`define DDR_OUTSTANDING $param{'ddr_outstanding'}\n";
       }
    }
 
    #- For compilation FIXME
    print $FH "\`define CACHE_LINES $param{'ddr_cache_lines'}\n";
+   print $FH "\`define DDR_MSHRS $param{'ddr_mshrs'}\n";
+   print $FH "\`define DDR_WCB $param{'ddr_wcb'}\n";
+   print $FH "\`define DDR_WCB_TIMEOUT $param{'ddr_wcb_timeout'}\n";
+   print $FH "\`define DDR_PF_STREAMS $param{'ddr_pf_streams'}\n";
+   print $FH "\`define DDR_PF_DIST $param{'ddr_pf_distance'}\n";
+   print $FH "\`define DDR_PF_DEGREE $param{'ddr_pf_degree'}\n";
+   print $FH "\`define DDR_STATS $param{'ddr_stats'}\n";
+   print $FH "\`define DDR_CACHE_WAYS $param{'ddr_cache_ways'}\n";
+   print $FH "\`define DDR_CACHE_BANKS $param{'ddr_cache_banks'}\n";
+   print $FH "\`define DDR_CACHE_URAM $param{'ddr_cache_uram'}\n";
 
   my $bits = $t*$bits_tile_type;
   print $FH "\`define BITS_TILE_TYPE $bits_tile_type\n";
@@ -847,7 +1130,17 @@ sub gen_global_defines{
 
   if ($param{'instruction_mem'}){
      print $FH "\`define INSTRUCTION_MEM\n";
+     print $FH "\`define ICACHE_KB $param{'icache_kb'}\n";
+     print $FH "\`define ICACHE_WAYS $param{'icache_ways'}\n";
+     print $FH "\`define ICACHE_PREFETCH $param{'icache_prefetch'}\n";
   }
+  print $FH "\`define DCACHE_LINES $param{'dcache_lines'}\n";
+  print $FH "\`define DCACHE_WAYS $param{'dcache_ways'}\n";
+  print $FH "\`define SPAD_BANKS $param{'spad_banks'}\n" if ($param{'spad_banks'} > 1);
+  print $FH "\`define SPAD_KB $param{'spad_kb'}\n";
+  print $FH "\`define SPAD_GATHER $param{'spad_gather'}\n";
+  print $FH "\`define SPAD_ACCUM $param{'spad_accum'}\n";
+  print $FH "\`define SPAD_URAM $param{'spad_uram'}\n";
 
   #print $FH "\n/////////////////////\n";
   #print $FH "// TESTCASE DEFINES  //\n";
@@ -890,7 +1183,7 @@ sub gen_pico_testcase{
          my $full_path = $param{'firmware_path'};
          if ($file ne ''){
             my $full_path2 = $full_path."/${file}";
-            if ($type eq 'pico'){
+            if ($type eq 'pico' || $type eq 'pico_fp' || $type eq 'pico_pipe'){
                if ($param{'instruction_mem'}){
                   $file =~ s/\.hex//; 
                   $full_path2 = $full_path."/${file}_data.hex";
@@ -911,7 +1204,11 @@ sub gen_pico_testcase{
                      print $FH "\t\$display(\"Writing tile $i,$j\");\n";
                      print $FH "\tinitialize_mem_tile_AXI(\"$full_path2\",$adr);\n\n"; #FIXME: adr
                   }else{
-                     print $FH "\t\$readmemh(\"$full_path2\", mosaic.row[$i].col[$j].${type}.tile_inst.acc_scratchpad.dp_ram.mem);\n\n";
+                     if ($param{'spad_banks'} > 1){
+                        spad_banked_image($FH, $param{'spad_banks'}, $param{'spad_kb'}, $full_path2, "mosaic.row[$i].col[$j].${type}.tile_inst.acc_scratchpad", 1);
+                     }else{
+                        print $FH "\t\$readmemh(\"$full_path2\", mosaic.row[$i].col[$j].${type}.tile_inst.acc_scratchpad.dp_ram.mem);\n\n";
+                     }
                   }
                }else{
                   die "ERROR: $full_path2 file does not exist\n";
@@ -927,11 +1224,14 @@ sub gen_pico_testcase{
   if ($param{'ddr4_flag'}){
     if (exists $param{'ddr_init_file'}){
       my $file = $param{'ddr_init_file'};
-      my $id = $r*$c;
-      my $adr = $id*$axi_tile_addr_range;
       print $FH "\twait(c0_init_calib_complete)\n";
-      print $FH "\n\t\$display(\"Writing tile memory manager\");\n";
-      print $FH "\tinitialize_mem_tile_AXI(\"$param{'firmware_path'}/$file\",$adr);\n";
+      #- Every DRAM tile keeps the words of its channel
+      for (my $k=0; $k<$param{'dram_tiles'}; $k=$k+1){
+        my $id = $r*$c+$k;
+        my $adr = $id*$axi_tile_addr_range;
+        print $FH "\n\t\$display(\"Writing tile memory manager $k\");\n";
+        print $FH "\tinitialize_mem_tile_AXI(\"$param{'firmware_path'}/$file\",$adr);\n";
+      }
     }
   }
   close($FH);
@@ -946,7 +1246,7 @@ sub set_axi_parameters{
   $axi_tile_addr_bits  = floor(log2($axi_addr_range/$t1));
 
   if ($param{'ddr4_flag'}){
-    $t1 = $t+1;
+    $t1 = $t+$param{'dram_tiles'};
     $axi_tile_addr_bits  = floor(log2($axi_addr_range/$t1));
   }
 
@@ -997,11 +1297,14 @@ sub gen_axi_coord_init{
   }
 
   if ($param{'ddr4_flag'}){
-      my $bin_x = sprintf("%03b", $r);
-      my $bin_y = sprintf("%03b", 0);
-      my $bin_t = sprintf("%026b",0);
-      my $bin = $bin_t.$bin_y.$bin_x;
-      print $FH "$bin\n";
+    #- DRAM tile k sits below its first column
+    for (my $k=0; $k<$param{'dram_tiles'}; $k=$k+1){
+        my $bin_x = sprintf("%03b", $r);
+        my $bin_y = sprintf("%03b", $k*$c/$param{'dram_tiles'});
+        my $bin_t = sprintf("%026b",0);
+        my $bin = $bin_t.$bin_y.$bin_x;
+        print $FH "$bin\n";
+    }
   }
   close($FH);
 }
@@ -1068,7 +1371,7 @@ sub gen_axi_ux_resp{
 
   my $t1 = $t;
   if ($param{'ddr4_flag'}){
-    $t1 = $t+1;
+    $t1 = $t+$param{'dram_tiles'};
   }
 
   print $FH "\nalways @(*) begin\n";
@@ -0,0 +1,78 @@
+#!/usr/bin/perl
+# *************************************************************************
+# 
+# *** Copyright Notice ***
+#
+# P38 heterogeneous multi-tiled system with support for message queues 
+# (MoSAIC) Copyright (c) 2024, The Regents of the University of California, 
+# through Lawrence Berkeley National Laboratory (subject to receipt of
+# any required approvals from the U.S. Dept. of Energy). All rights reserved.
+# 
+# If you have questions about your rights to use or distribute this software,
+# please contact Berkeley Lab's Intellectual Property Office at
+# IPO@lbl.gov.
+#
+# NOTICE.  This Software was developed under funding from the U.S. Department
+# of Energy and the U.S. Government consequently retains certain rights.  As
+# such, the U.S. Government has been granted for itself and others acting on
+# its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+# Software to reproduce, distribute copies to the public, prepare derivative 
+# works, and perform publicly and display publicly, and to permit others 
+# to do so.
+#
+# *************************************************************************
+
+use lib "$ENV{PWD}";
+use gen_mosaic;
+use POSIX;
+
+###########################################
+#- Set hash for parameters: Do not modify
+###########################################
+
+%param;
+
+###########################################
+#- Test case: Modify
+###########################################
+
+#- 2x2 Tile array: a pico with the double precision unit in tile 00
+$param{'r'} = 2;
+$param{'c'} = 2;
+
+@tile_array = (['pico_fp', 'spad'],
+               ['loop', 'pico']);
+
+$path = `pwd`;
+chomp($path);
+$fw_path = "$path/../picorv_c/c";
+
+$param{'firmware_path'} = $fw_path; 
+
+@pico_program  = ('pico_fpu32.hex', '', '', 'test_tile_nop.hex');
+
+#- Simulation Time
+$param{'sim_loop'}     = 600;
+
+#- Checkers: results of the double precision unit
+@checkers = ('check_pico_fpu.sh');
+
+#- Running with Icarus
+$param{'run_sim'} = 1;
+
+#- generate hex code
+chdir $fw_path or die "$!. $fw_path\n";
+$cmd = "make SRC_FNAME=pico_fpu";
+`$cmd`;
+chdir $path or die "$!. $path\n";
+
+###########################################
+#- Generate: Do not modify  
+###########################################
+
+$param{'checkers'} = \@checkers;
+$param{'testcase'} = $0;
+$param{'tile_array'} = \@tile_array;
+$param{'pico_program'} = \@pico_program; 
+
+gen_all(\%param);
@@ -56,6 +56,9 @@ $param{'r'} = 4;
 $param{'c'} = 4;
 $param{'c_file'} = $c_file;
 $param{'instruction_mem'} = 1;
+$param{'icache_kb'}       = 4;  #- Instruction cache: 1 to 16 KB
+$param{'icache_ways'}     = 2;  #- 1, 2, 4 or 8 ways
+$param{'icache_prefetch'} = 2;  #- Next lines prefetched after a miss (0 to 4)
 
 #-- Generate tile array
 ($ta, $pp) = generic_tile_array(\%param);
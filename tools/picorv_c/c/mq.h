@@ -45,23 +45,177 @@
 #define mq_DO_MLOAD 6
 #define mq_DO_MSTORE 7
 
+#define mq_DO_NO   0
+#define mq_DO_PUTH 1
+#define mq_DO_PUTD 2
+#define mq_DO_H 1
+#define mq_DO_D 2
+#define mq_DO_BARRIER 1
+#define mq_DO_HX 5
+#define mq_DO_FENCE 2
+#define mq_DO_PENDING 1
+#define mq_DO_SPILL 3
+#define mq_DO_DMA 3
+#define mq_DO_DMAX 7
+#define mq_DO_DMASTAT 1
+#define mq_DO_STATS 2
+#define mq_DO_DCACHE 3
+
 #define XCUSTOM_MQ 1
 
 #define qPut(destination_qid, source_data) \
-  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, destination_qid, source_data, mq_DO_QPUT);
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, destination_qid, source_data, mq_DO_QPUT, mq_DO_NO);
 
 #define qPoll(destination_qid, cr_pcpi) \
-  PCPI_INSTRUCTION_R_R_0(XCUSTOM_MQ, cr_pcpi, destination_qid, mq_DO_QPOLL);
+  PCPI_INSTRUCTION_R_R_0(XCUSTOM_MQ, cr_pcpi, destination_qid, mq_DO_QPOLL, mq_DO_NO);
 
 #define qGet(destination_qid, sr_pcpi) \
-  PCPI_INSTRUCTION_R_R_0(XCUSTOM_MQ, sr_pcpi, destination_qid, mq_DO_QGET);
+  PCPI_INSTRUCTION_R_R_0(XCUSTOM_MQ, sr_pcpi, destination_qid, mq_DO_QGET, mq_DO_NO);
 
 #define qWait(destination_qid, dr_pcpi) \
-  PCPI_INSTRUCTION_R_R_0(XCUSTOM_MQ, dr_pcpi, destination_qid, mq_DO_QWAIT);
+  PCPI_INSTRUCTION_R_R_0(XCUSTOM_MQ, dr_pcpi, destination_qid, mq_DO_QWAIT, mq_DO_NO);
 
 #define mGet(remote_dest, local_dest) \
-  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, remote_dest, local_dest, mq_DO_MGET);
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, remote_dest, local_dest, mq_DO_MGET, mq_DO_NO);
 
 #define mPut(source, addr) \
-  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, addr, source, mq_DO_MPUT);
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, addr, source, mq_DO_MPUT, mq_DO_NO);
+
+#define qPutH(destination_qid, pktSizeCode) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, destination_qid, pktSizeCode, mq_DO_QPUT, mq_DO_PUTH);
+
+#define qPutD(source_data1, source_data2) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, source_data1, source_data2, mq_DO_QPUT, mq_DO_PUTD);
+
+#define mPutH(source, pktSizeCode) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, source, pktSizeCode, mq_DO_MPUT, mq_DO_PUTH);
+
+#define mPutD(addr1, addr2) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, addr1, addr2, mq_DO_MPUT, mq_DO_PUTD);
+
+#define mGetH(remote_dest, pktSizeCode) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, remote_dest, pktSizeCode, mq_DO_MGET, mq_DO_H);
+
+/* Extended addressing: remote_addr is the full 32-bit word address in the
+ * destination tile (byte address / 4 for the DRAM tile) and dest_tile is
+ * the (y << 3 | x) tile id. Follow them with mPutD/mGetD as mPutH/mGetH. */
+#define mPutX(remote_addr, dest_tile, pktSizeCode) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, remote_addr, ((dest_tile) << 4) | (pktSizeCode), mq_DO_MPUT, mq_DO_HX);
+
+#define mGetX(remote_addr, dest_tile, pktSizeCode) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, remote_addr, ((dest_tile) << 4) | (pktSizeCode), mq_DO_MGET, mq_DO_HX);
+
+/* Data linked in a SPADX<id> region (a scratchpad tile past its first
+ * 16KB, see gen_mem_map in c_spmv/gen_hex.pm) is not in the array
+ * address map: use mPutX/mGetX with these tile id and word address. */
+#define spadX_tile(p) ((((uint32_t)(p)) >> 24) & 0x3F)
+#define spadX_addr(p) ((((uint32_t)(p)) & 0x00FFFFFF) >> 2)
+
+/* Non-temporal mPutX/mGetX: a DRAM tile moves the packet in AXI bursts
+ * without going through its cache. The program must not have the same
+ * lines in the cache (no coherence). mq_NT in the pktSizeCode of mDma
+ * makes its packets non-temporal. */
+#define mq_NT 0x80000000
+
+#define mPutB(remote_addr, dest_tile, pktSizeCode) \
+  mPutX(remote_addr, dest_tile, mq_NT | (pktSizeCode))
+
+#define mGetB(remote_addr, dest_tile, pktSizeCode) \
+  mGetX(remote_addr, dest_tile, mq_NT | (pktSizeCode))
+
+/* Scratchpad tiles built with spad_gather (mq_IDX sets header bit 31,
+ * mq_NT is ignored by a scratchpad).
+ * Gather: the 1 << pktSizeCode words mem[base + mem[idx_addr + k]] of
+ * the scratchpad come back to local_dest as the reply of an mGet:
+ *   mGatherX(idx_addr, dest_tile, pktSizeCode); mGetD(local_dest, base);
+ * Scatter-add: mem[base + idx] += value for each of the
+ * 1 << (pktSizeCode-1) pairs:
+ *   mScatterAddX(base, dest_tile, pktSizeCode); mPutD(idx, value); ...
+ * idx_addr and base are word addresses in the scratchpad. */
+#define mq_IDX 0x40000000
+
+#define mGatherX(idx_addr, dest_tile, pktSizeCode) \
+  mGetX(idx_addr, dest_tile, mq_IDX | (pktSizeCode))
+
+#define mScatterAddX(base, dest_tile, pktSizeCode) \
+  mPutX(base, dest_tile, mq_IDX | (pktSizeCode))
+
+/* Accumulate (spad_accum): the top bits of idx select what a pair of
+ * mScatterAddX does to mem[base + idx], so many tiles reduce into one
+ * word with a single packet each:
+ *   mScatterAddX(base, dest_tile, 1); mAccD(mq_ACC_MAX, idx, value);
+ * An fp64 add is two pairs (pktSizeCode 2), low word first:
+ *   mScatterAddX(base, dest_tile, 2); mAccF64D(idx, lo, hi); */
+#define mq_ACC_ADD 0x00000000
+#define mq_ACC_MIN 0x20000000
+#define mq_ACC_MAX 0x40000000
+#define mq_ACC_FLO 0x60000000
+#define mq_ACC_FHI 0x80000000
+
+#define mAccD(op, idx, value) \
+  mPutD((op) | (idx), value)
+
+#define mAccF64D(idx, lo, hi) \
+  do { \
+    mPutD(mq_ACC_FLO | (idx), lo) \
+    mPutD(mq_ACC_FHI | (idx), hi) \
+  } while (0)
+
+#define mGetD(local_dest, data) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, local_dest, data, mq_DO_MGET, mq_DO_D);
+
+/* Blocks until every tile of the barrier group (0-3) executes mBarrier.
+ * The host excludes a tile from group g setting rvControl[4+g]. */
+#define mBarrier(group) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, group, 0, mq_DO_QWAIT, mq_DO_BARRIER);
+
+/* Blocks until every mGet issued by this tile got its response and every
+ * mPut left the tile. Only mGets whose reply comes to this tile are
+ * counted: a long mGet whose mGetD local_dest is in another tile (for
+ * example spad data sent straight to an FP tile) is not waited for. */
+#define mFence() \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, 0, 0, mq_DO_QWAIT, mq_DO_FENCE);
+
+/* Non-blocking: pending = (outstanding mPut << 16) | outstanding mGet */
+#define mPending(pending) \
+  PCPI_INSTRUCTION_R_R_0(XCUSTOM_MQ, pending, 0, mq_DO_QPOLL, mq_DO_PENDING);
+
+/* Queue messages that do not fit in the inbound FIFO are written to
+ * 1 << sizeW words of data memory starting at word address base and
+ * moved back to the FIFO as it drains. sizeW = 0 disables spilling.
+ * The region must not be used by the program. */
+#define qSpill(base, sizeW) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, base, sizeW, mq_DO_QPUT, mq_DO_SPILL);
+
+/* Send DMA: sends len words from the local word address local_addr to
+ * the word address remote_addr of dest_tile (y << 3 | x) as mPutX
+ * packets of up to 1 << pktSizeCode words (pktSizeCode <= 7). The
+ * processor keeps running; mFence also waits for the DMA. */
+#define mDmaA(local_addr, len) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, local_addr, len, mq_DO_MPUT, mq_DO_DMA);
+
+#define mDma(remote_addr, dest_tile, pktSizeCode) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, remote_addr, ((dest_tile) << 4) | (pktSizeCode), mq_DO_MPUT, mq_DO_DMAX);
+
+/* status = (busy << 16) | words left to send */
+#define mDmaStatus(status) \
+  PCPI_INSTRUCTION_R_R_0(XCUSTOM_MQ, status, 0, mq_DO_QGET, mq_DO_DMASTAT);
+
+/* value = counter idx of the message instruction counters: 2*c issued
+ * instructions and 2*c+1 waiting cycles of class c (0 qPut, 1 qGet/qPoll,
+ * 2 qWait, 3 mPut, 4 mGet, 5 mBarrier, 6 mFence, 7 mLoad, 8 mStore,
+ * 9 others). Setting bit 31 of idx clears all the counters. */
+#define mqStats(idx, value) \
+  PCPI_INSTRUCTION_R_R_0(XCUSTOM_MQ, value, idx, mq_DO_QPOLL, mq_DO_STATS);
+
+/* Remote loads go through a read-only cache of 8-word lines (built with
+ * dcache_lines > 0). Its lines are kept in the dcache_lines * 8 words of
+ * data memory starting at word address base, which the program must not
+ * use. enable = 0 turns it off. Both instructions drop every cached line:
+ * call dCacheInval() before reading data that other tiles changed. */
+#define dCache(base, enable) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, base, enable, mq_DO_QWAIT, mq_DO_DCACHE);
+
+#define dCacheInval() \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_MQ, 0, 0, mq_DO_QPOLL, mq_DO_DCACHE);
 #endif
@@ -0,0 +1,234 @@
+// *************************************************************************
+//
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+//
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative
+// works, and perform publicly and display publicly, and to permit others
+// to do so.
+//
+// *************************************************************************
+
+/////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : C++17 message queue API
+// File        : mq.hpp
+// Notes       :
+// - Header only, wraps the instructions in mq.h.
+// - Tiles, addresses and packet size codes are computed at
+//   compile time: Packet<N> is a long packet of N words and
+//   Packet<N>::code is the size code of its header.
+// - Flits<T> serializes any trivially copyable type (double,
+//   structs) into 32-bit words.
+// - Compile with make SRC_FNAME=<code> SRC_EXT=cpp, add
+//   NOC_BUFFER_ADDR_W=<w> when the system is generated with
+//   a noc_buffer_addr_w other than 8.
+////////////////////////////////////////////////////////////////
+
+#ifndef SRC_MAIN_C_MQ_HPP
+#define SRC_MAIN_C_MQ_HPP
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+#include "mq.h"
+
+#ifndef NOC_BUFFER_ADDR_W
+#define NOC_BUFFER_ADDR_W 8   //- noc_buffer_addr_w of the generator
+#endif
+
+namespace mq {
+
+//- Number of bits of the word offset in the short addresses (OFFSET_SZ)
+constexpr uint32_t OFFSET_SZ = 12;
+constexpr uint32_t XY_SZ     = 3;
+//- Largest packet that fits in the NoC buffers: the biggest power of two
+//  below 1 << NOC_BUFFER_ADDR_W words once the header and address are in
+constexpr uint32_t MAX_PKT_WORDS = 1u << (NOC_BUFFER_ADDR_W - 1);
+
+/******************************
+ * Tiles and addresses
+ ******************************/
+
+struct Tile {
+   uint32_t x;
+   uint32_t y;
+   //- Tile id used by qPut, mPutX and mDma
+   constexpr uint32_t id() const { return (y << XY_SZ) | x; }
+   //- Short address used by mPut, mGet, mPutH and mGetH
+   constexpr uint32_t addr(uint32_t word) const { return (id() << OFFSET_SZ) | word; }
+};
+
+template <uint32_t X, uint32_t Y>
+constexpr Tile tile = Tile{X, Y};
+
+//- Word address of a local object
+template <typename T>
+inline uint32_t word_addr(const T *p) { return ((uint32_t) (uintptr_t) p) >> 2; }
+
+/******************************
+ * Packet size codes
+ ******************************/
+
+constexpr uint32_t log2(uint32_t n) { return n <= 1 ? 0 : 1 + log2(n >> 1); }
+constexpr bool is_pow2(uint32_t n) { return n != 0 && (n & (n - 1)) == 0; }
+constexpr uint32_t pow2_ceil(uint32_t n) { return n <= 1 ? 1 : 2 * pow2_ceil((n + 1) >> 1); }
+
+//- Words of data in a received long packet (header[11:8] is the size code)
+constexpr uint32_t pkt_words(uint32_t header) { return 1u << ((header >> 8) & 0xF); }
+
+template <uint32_t N>
+struct Packet {
+   static_assert(is_pow2(N) && N >= 2, "Long packets carry a power of two (>= 2) words");
+   static_assert(N <= MAX_PKT_WORDS, "The packet does not fit in the NoC buffers");
+   static constexpr uint32_t words = N;
+   static constexpr uint32_t code  = log2(N);
+   uint32_t w[N];
+};
+
+/******************************
+ * Serialization
+ ******************************/
+
+template <typename T>
+struct Flits {
+   static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be sent");
+   static constexpr uint32_t words = (sizeof(T) + 3) / 4;
+   //- Smallest long packet that holds a T
+   using packet = Packet<(pow2_ceil(words) < 2 ? 2 : pow2_ceil(words))>;
+
+   static inline void pack(const T &v, uint32_t *w) { memcpy(w, &v, sizeof(T)); }
+   static inline void unpack(const uint32_t *w, T &v) { memcpy(&v, w, sizeof(T)); }
+};
+
+/******************************
+ * Instructions
+ ******************************/
+
+//- Message queues
+inline void q_put(Tile dest, uint32_t data) { uint32_t d = dest.id(); qPut(d, data); }
+
+template <uint32_t N>
+inline void q_put_h(Tile dest) { uint32_t d = dest.id(), c = Packet<N>::code; qPutH(d, c); }
+
+inline void q_put_d(uint32_t d1, uint32_t d2) { qPutD(d1, d2); }
+
+inline uint32_t q_poll() { uint32_t r, q = 0; qPoll(q, r); return r; }
+inline uint32_t q_get()  { uint32_t r, q = 0; qGet(q, r);  return r; }
+inline uint32_t q_wait() { uint32_t r, q = 0; qWait(q, r); return r; }
+
+inline void q_spill(const uint32_t *base, uint32_t size_w) { uint32_t b = word_addr(base); qSpill(b, size_w); }
+
+//- Remote memory
+inline void m_put(uint32_t data, uint32_t remote) { mPut(data, remote); }
+inline void m_get(uint32_t remote, uint32_t local) { mGet(remote, local); }
+
+template <uint32_t N>
+inline void m_put_h(uint32_t remote) { uint32_t c = Packet<N>::code; mPutH(remote, c); }
+
+template <uint32_t N>
+inline void m_put_x(Tile dest, uint32_t remote_word) { mPutX(remote_word, dest.id(), Packet<N>::code); }
+
+inline void m_put_d(uint32_t d1, uint32_t d2) { mPutD(d1, d2); }
+
+template <uint32_t N>
+inline void m_get_h(uint32_t remote, uint32_t local) { uint32_t c = Packet<N>::code, z = 0; mGetH(remote, c); mGetD(local, z); }
+
+template <uint32_t N>
+inline void m_get_x(Tile dest, uint32_t remote_word, uint32_t local) { uint32_t z = 0; mGetX(remote_word, dest.id(), Packet<N>::code); mGetD(local, z); }
+
+//- Synchronization
+inline void barrier(uint32_t group) { mBarrier(group); }
+inline void fence() { mFence(); }
+inline uint32_t pending() { uint32_t r; mPending(r); return r; }
+
+//- Send DMA
+template <uint32_t N = MAX_PKT_WORDS>
+inline void dma(Tile dest, uint32_t remote_word, const uint32_t *local, uint32_t len) {
+   uint32_t l = word_addr(local);
+   mDmaA(l, len);
+   mDma(remote_word, dest.id(), Packet<N>::code);
+}
+inline uint32_t dma_status() { uint32_t r; mDmaStatus(r); return r; }
+
+//- Instruction counters
+enum class Stat : uint32_t { q_put, q_get, q_wait, m_put, m_get, barrier, fence, m_load, m_store, other };
+inline uint32_t stat_count(Stat c) { uint32_t r, i = 2 * (uint32_t) c; mqStats(i, r); return r; }
+inline uint32_t stat_cycles(Stat c) { uint32_t r, i = 2 * (uint32_t) c + 1; mqStats(i, r); return r; }
+inline void stat_clear() { uint32_t r, i = 1u << 31; mqStats(i, r); }
+//- Events: 0 I-cache hits, 1 I-cache misses, 2/3 useful/useless prefetches, 4 D-cache hits, 5 D-cache misses
+inline uint32_t stat_event(uint32_t e) { uint32_t r, i = 2 * ((uint32_t) Stat::other + 1) + e; mqStats(i, r); return r; }
+
+//- Remote data cache, its lines use the words starting at base
+inline void dcache(const uint32_t *base, bool enable) { uint32_t b = word_addr(base), en = enable; dCache(b, en); }
+inline void dcache_inval() { dCacheInval(); }
+
+/******************************
+ * Packets
+ ******************************/
+
+//- Long message to the queue of dest
+template <uint32_t N>
+inline void q_send(Tile dest, const Packet<N> &p) {
+   q_put_h<N>(dest);
+   for (uint32_t i = 0; i < N; i += 2)
+      q_put_d(p.w[i], p.w[i + 1]);
+}
+
+//- Blocks until a long message arrives, returns its first header word
+template <uint32_t N>
+inline uint32_t q_recv(Packet<N> &p) {
+   q_wait();
+   uint32_t header = q_get();
+   q_get();  //- Second header word
+   for (uint32_t i = 0; i < N; i++)
+      p.w[i] = q_get();
+   return header;
+}
+
+//- Long write to a remote memory
+template <uint32_t N>
+inline void m_send(uint32_t remote, const Packet<N> &p) {
+   m_put_h<N>(remote);
+   for (uint32_t i = 0; i < N; i += 2)
+      m_put_d(p.w[i], p.w[i + 1]);
+}
+
+//- Any trivially copyable value
+template <typename T>
+inline void q_send(Tile dest, const T &v) {
+   typename Flits<T>::packet p = {};
+   Flits<T>::pack(v, p.w);
+   q_send(dest, p);
+}
+
+template <typename T>
+inline void q_recv(T &v) {
+   typename Flits<T>::packet p;
+   q_recv(p);
+   Flits<T>::unpack(p.w, v);
+}
+
+template <typename T>
+inline void m_send(uint32_t remote, const T &v) {
+   typename Flits<T>::packet p = {};
+   Flits<T>::pack(v, p.w);
+   m_send(remote, p);
+}
+
+} // namespace mq
+
+#endif
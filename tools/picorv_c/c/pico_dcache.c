@@ -0,0 +1,93 @@
+// *************************************************************************
+// 
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues 
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California, 
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+// 
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative 
+// works, and perform publicly and display publicly, and to permit others 
+// to do so.
+//
+// *************************************************************************
+
+/* ////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : The pico in tile 00 reads the scratchpad in tile 01
+//               with loads through the remote data cache
+// File        : pico_dcache.c
+// Notes       :
+// - Needs dcache_lines >= 8: N words (N/8 lines) fit in the cache.
+// - The words are written with mPut, then read twice with loads to
+//   remote addresses. The first pass misses once a line, the second
+//   pass only hits (mqStats counters 24 hits and 25 misses).
+// - result: 16 x 900D900D (data and counters right) or BAD0BAD0.
+// ///////////////////////////////////////////////////////////////*/
+
+#include "mq.h"
+#include <stdlib.h>
+
+#define SPAD_TILE 8     //- Tile 01
+#define SPAD_BASE 1536  //- Word address in the scratchpad, line aligned
+#define N         32    //- Words read, 4 lines
+#define LINES     8     //- dcache_lines of the testcase
+
+volatile uint32_t dc_lines[LINES*8];   //- Line slots, not used by the program
+volatile uint32_t result[16];
+
+uint32_t main (int argc, char *argv[])
+{
+   //- Declare variables
+   uint32_t local_tile_id;
+   uint32_t remote;
+   volatile uint32_t *rptr;
+   uint32_t hits;
+   uint32_t misses;
+   uint32_t errors = 0;
+
+   //- Parse Options
+   local_tile_id = atoi(argv[1]);
+   remote = (SPAD_TILE << 12) + SPAD_BASE;
+
+   //- Data in the scratchpad
+   for (int i=0; i<N; i++){
+      mPut(0xD0C00000 | i, remote + i);
+   }
+   mFence();
+
+   //- Cache on, counters cleared
+   dCache(((uint32_t) dc_lines) >> 2, 1);
+   mqStats(0x80000000, hits);
+
+   //- Two passes of remote loads
+   rptr = (volatile uint32_t *) (remote << 2);
+   for (int pass=0; pass<2; pass++){
+      for (int i=0; i<N; i++){
+         if (rptr[i] != (0xD0C00000 | i)) errors++;
+      }
+   }
+
+   mqStats(24, hits);
+   mqStats(25, misses);
+   if (misses != N/8 || hits != 2*N - N/8) errors++;
+
+   for (int i=0; i<16; i++){
+      result[i] = (errors == 0) ? 0x900D900D : 0xBAD0BAD0;
+   }
+
+  return 1;
+}
+//   000-000 0
+//   001-000 8
+//   000-001 1
+//   001-001 9
@@ -0,0 +1,94 @@
+// *************************************************************************
+// 
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues 
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California, 
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+// 
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative 
+// works, and perform publicly and display publicly, and to permit others 
+// to do so.
+//
+// *************************************************************************
+
+/* ////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : The pico in tile 00 moves blocks to and from the
+//               DRAM tile with non-temporal (AXI burst) packets
+// File        : pico_ddr_burst.c
+// Notes       :
+// - Block 0 goes out with mPutB (one 64-word packet), block 1 with
+//   an mDma of mq_NT packets of 32 words. Both come back with
+//   mGetB and are compared with the source.
+// - result: 16 x 900D900D or BAD0BAD0.
+// ///////////////////////////////////////////////////////////////*/
+
+#include "mq.h"
+#include <stdlib.h>
+
+#define DRAM_TILE 2     //- Tile 02, below tile 00
+#define DDR_WORD  4096  //- Word address of the blocks in DRAM
+#define N         64    //- Words a block (size code 6)
+
+volatile uint32_t src[N];
+volatile uint32_t copy[2][N];
+volatile uint32_t result[16];
+
+uint32_t main (int argc, char *argv[])
+{
+   //- Declare variables
+   uint32_t local_tile_id;
+   uint32_t local;
+   uint32_t errors = 0;
+
+   //- Parse Options
+   local_tile_id = atoi(argv[1]);
+
+   for (int k=0; k<N; k++){
+      src[k] = 0xB5700000 | k;
+   }
+
+   //- Block 0: one long non-temporal mPut
+   mPutB(DDR_WORD, DRAM_TILE, 6);
+   for (int k=0; k<N; k+=2){
+      mPutD(src[k], src[k+1]);
+   }
+   //- Block 1: DMA in non-temporal packets of 32 words
+   mDmaA(((uint32_t) src) >> 2, N);
+   mDma(DDR_WORD + N, DRAM_TILE, mq_NT | 5);
+   mFence();
+
+   //- Read both blocks back
+   for (int b=0; b<2; b++){
+      local = (((uint32_t) copy[b]) >> 2) + (local_tile_id << 12);
+      mGetB(DDR_WORD + b*N, DRAM_TILE, 6);
+      mGetD(local, 0);
+   }
+   mFence();
+
+   for (int b=0; b<2; b++){
+      for (int k=0; k<N; k++){
+         if (copy[b][k] != (0xB5700000 | k)) errors++;
+      }
+   }
+   for (int i=0; i<16; i++){
+      result[i] = (errors == 0) ? 0x900D900D : 0xBAD0BAD0;
+   }
+
+  return 1;
+}
+//   000-000 'h0
+//   001-000 'h8
+//   000-001 'h1
+//   001-001 'h9
+//   000-010 'h2
@@ -0,0 +1,108 @@
+// *************************************************************************
+// 
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues 
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California, 
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+// 
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative 
+// works, and perform publicly and display publicly, and to permit others 
+// to do so.
+//
+// *************************************************************************
+
+/* ////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : The picos in tiles 00 and 11 share the FP adder
+//               tile in tile 01
+// File        : pico_fp_clients.c
+// Notes       :
+// - Each pico sends P packets of 4 additions back to back, so the
+//   operations of both picos are in flight in the adder together.
+//   Tile 00 adds 0.5 and tile 11 adds 0.25 to 1.0 ... 16.0.
+// - The replies (qPut: two header words, then low and high word of
+//   each result) come back in issue order and are compared with
+//   the expected doubles. All the low words are 0.
+// - result: 16 x 900D900D or BAD0BAD0.
+// ///////////////////////////////////////////////////////////////*/
+
+#include "mq.h"
+#include <stdlib.h>
+
+#define FP_TILE 8   //- Tile 01, fp_add
+#define P       4   //- Packets of 4 operations (size code 4)
+#define OPS     4
+
+//- High words of 1.0 ... 16.0, of a + 0.5 and of a + 0.25
+static const uint32_t a_hi[P*OPS]  = {
+   0x3FF00000, 0x40000000, 0x40080000, 0x40100000, 0x40140000, 0x40180000,
+   0x401C0000, 0x40200000, 0x40220000, 0x40240000, 0x40260000, 0x40280000,
+   0x402A0000, 0x402C0000, 0x402E0000, 0x40300000};
+static const uint32_t r5_hi[P*OPS] = {
+   0x3FF80000, 0x40040000, 0x400C0000, 0x40120000, 0x40160000, 0x401A0000,
+   0x401E0000, 0x40210000, 0x40230000, 0x40250000, 0x40270000, 0x40290000,
+   0x402B0000, 0x402D0000, 0x402F0000, 0x40308000};
+static const uint32_t r25_hi[P*OPS] = {
+   0x3FF40000, 0x40020000, 0x400A0000, 0x40110000, 0x40150000, 0x40190000,
+   0x401D0000, 0x40208000, 0x40228000, 0x40248000, 0x40268000, 0x40288000,
+   0x402A8000, 0x402C8000, 0x402E8000, 0x40304000};
+
+volatile uint32_t result[16];
+
+uint32_t main (int argc, char *argv[])
+{
+   //- Declare variables
+   uint32_t local_tile_id;
+   uint32_t b_hi;
+   const uint32_t *r_hi;
+   uint32_t header;
+   uint32_t lo;
+   uint32_t hi;
+   uint32_t errors = 0;
+
+   //- Parse Options
+   local_tile_id = atoi(argv[1]);
+   b_hi = (local_tile_id == 0) ? 0x3FE00000 : 0x3FD00000;   //- 0.5, 0.25
+   r_hi = (local_tile_id == 0) ? r5_hi : r25_hi;
+
+   //- Requests: the results come back to this tile
+   for (int p=0; p<P; p++){
+      mPutH(FP_TILE << 12, 4);
+      for (int j=0; j<OPS; j++){
+         mPutD(0, a_hi[p*OPS + j]);
+         mPutD(0, b_hi);
+      }
+   }
+
+   //- Replies
+   for (int p=0; p<P; p++){
+      qWait(0, header);
+      qGet(0, header);
+      qGet(0, header);
+      for (int j=0; j<OPS; j++){
+         qGet(0, lo);
+         qGet(0, hi);
+         if (lo != 0 || hi != r_hi[p*OPS + j]) errors++;
+      }
+   }
+
+   for (int i=0; i<16; i++){
+      result[i] = (errors == 0) ? 0x900D900D : 0xBAD0BAD0;
+   }
+
+  return 1;
+}
+//   000-000 0
+//   001-000 8
+//   000-001 1
+//   001-001 9
@@ -0,0 +1,86 @@
+// *************************************************************************
+// 
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues 
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California, 
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+// 
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative 
+// works, and perform publicly and display publicly, and to permit others 
+// to do so.
+//
+// *************************************************************************
+
+/* ////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : The pico_fp in tile 00 uses its double precision
+//               unit on the PCPI port
+// File        : pico_fpu.c
+// Notes       :
+// - fpu.h is a copy of c_fp_acc/fpu.h.
+// - N adds, subtracts and multiplies are issued before the first
+//   result is read (fpStat counts them), then the results are
+//   popped in issue order and compared bit by bit.
+// - result: 16 x 900D900D or BAD0BAD0.
+// ///////////////////////////////////////////////////////////////*/
+
+#include "mq.h"
+#include "fpu.h"
+#include <stdlib.h>
+
+#define N 6   //- Operations in flight, at most 8
+
+static const double   fa[N] = {1.5, 3.0, 5.0, 0.25, 10.0, -2.0};
+static const double   fb[N] = {2.25, 2.5, 0.5, 0.25, 6.0, 4.0};
+static const uint32_t op[N] = {fp_DO_ADD, fp_DO_MUL, fp_DO_SUB,
+                               fp_DO_ADD, fp_DO_MUL, fp_DO_SUB};
+//- High words of the results, the low words are 0:
+//  3.75, 7.5, 4.5, 0.5, 60.0, -6.0
+static const uint32_t res_hi[N] = {0x400E0000, 0x401E0000, 0x40120000,
+                                   0x3FE00000, 0x404E0000, 0xC0180000};
+
+volatile uint32_t result[16];
+
+uint32_t main (int argc, char *argv[])
+{
+   //- Declare variables
+   uint32_t n;
+   uint32_t errors = 0;
+   fp_pair  r;
+
+   //- Issue every operation
+   for (int k=0; k<N; k++){
+      fp_issue(fa[k], fb[k], op[k]);
+   }
+   fpStat(n);
+   if (n != N) errors++;
+
+   //- Results in issue order
+   for (int k=0; k<N; k++){
+      fpRes(r.w[0]);
+      fpResH(r.w[1]);
+      if (r.w[0] != 0 || r.w[1] != res_hi[k]) errors++;
+   }
+   fpStat(n);
+   if (n != 0) errors++;
+
+   for (int i=0; i<16; i++){
+      result[i] = (errors == 0) ? 0x900D900D : 0xBAD0BAD0;
+   }
+
+  return 1;
+}
+//   000-000 0
+//   001-000 8
+//   000-001 1
+//   001-001 9
@@ -0,0 +1,102 @@
+// *************************************************************************
+// 
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues 
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California, 
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+// 
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative 
+// works, and perform publicly and display publicly, and to permit others 
+// to do so.
+//
+// *************************************************************************
+
+/* ////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Picos in tiles 00 and 11 exchange blocks through
+//               the scratchpad in tile 01 with mDma, mFence and
+//               mBarrier
+// File        : pico_mq_sync.c
+// Notes       :
+// - Each pico DMAs a tagged block to its slot in the scratchpad,
+//   waits for it with mFence and meets the other pico at a
+//   barrier. Then it reads the other pico's block with mGet,
+//   waits with mFence and checks it.
+// - result: 16 x 900D900D (block and mPending right) or BAD0BAD0.
+//   done: 16 x F1F1F1F1 after a second barrier (sense reversal).
+// ///////////////////////////////////////////////////////////////*/
+
+#include "mq.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SPAD_TILE 8     //- Tile 01
+#define SPAD_BASE 2048  //- Word address of the slots in the scratchpad
+#define N         16
+
+volatile uint32_t src[N];
+volatile uint32_t copy[N];
+volatile uint32_t result[N];
+volatile uint32_t done[N];
+
+uint32_t main (int argc, char *argv[])
+{
+   //- Declare variables
+   uint32_t local_tile_id;
+   uint32_t other_tile_id;
+   uint32_t local_copy;
+   uint32_t remote;
+   uint32_t pending;
+   uint32_t errors = 0;
+
+   //- Parse Options
+   local_tile_id = atoi(argv[1]);
+   other_tile_id = (local_tile_id == 0) ? 9 : 0;
+
+   //- Send the block to the scratchpad
+   for (int i=0; i<N; i++){
+      src[i] = 0xDA7A0000 | (local_tile_id << 8) | i;
+   }
+   mDmaA(((uint32_t) src) >> 2, N);
+   mDma(SPAD_BASE + local_tile_id*N, SPAD_TILE, 3);
+   mFence();
+
+   //- The other block is in the scratchpad after the barrier
+   mBarrier(0);
+
+   local_copy = (((uint32_t) copy) >> 2) + (local_tile_id << 12);
+   remote     = SPAD_BASE + other_tile_id*N + (SPAD_TILE << 12);
+   for (int i=0; i<N; i++){
+      mGet(remote + i, local_copy + i);
+   }
+   mFence();
+   mPending(pending);
+
+   for (int i=0; i<N; i++){
+      if (copy[i] != (0xDA7A0000 | (other_tile_id << 8) | i)) errors++;
+   }
+   for (int i=0; i<N; i++){
+      result[i] = (errors == 0 && pending == 0) ? 0x900D900D : 0xBAD0BAD0;
+   }
+
+   mBarrier(0);
+   for (int i=0; i<N; i++){
+      done[i] = 0xF1F1F1F1;
+   }
+
+  return 1;
+}
+//   000-000 0
+//   001-000 8
+//   000-001 1
+//   001-001 9
@@ -0,0 +1,106 @@
+// *************************************************************************
+// 
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues 
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California, 
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+// 
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative 
+// works, and perform publicly and display publicly, and to permit others 
+// to do so.
+//
+// *************************************************************************
+
+/* ////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : The picos in tiles 00 and 11 reduce into the same
+//               words of the scratchpad in tile 01 (spad_accum)
+// File        : pico_spad_accum.c
+// Notes       :
+// - Tile 00 sets the words, then each pico sends one add/min/max
+//   packet and one fp64 add packet with mScatterAddX.
+// - After a barrier both picos read the words back and check:
+//   add 5CA00000 + 1 + 10, min 1, max 10 and 1.0 + 1.0 + 1.0.
+// - result: 16 x 900D900D or BAD0BAD0.
+// ///////////////////////////////////////////////////////////////*/
+
+#include "mq.h"
+#include <stdlib.h>
+
+#define SPAD_TILE 8     //- Tile 01
+#define ACC_BASE  1200  //- Word address of the words in the scratchpad
+#define WORDS     6     //- add, min, max, spare, fp64 (low, high)
+#define N         16
+
+volatile uint32_t acc[WORDS];
+volatile uint32_t result[N];
+
+uint32_t main (int argc, char *argv[])
+{
+   //- Declare variables
+   uint32_t local_tile_id;
+   uint32_t local;
+   uint32_t remote;
+   uint32_t v;
+   uint32_t errors = 0;
+
+   //- Parse Options
+   local_tile_id = atoi(argv[1]);
+   remote = SPAD_TILE << 12;
+   v = local_tile_id + 1;
+
+   //- Initial values
+   if (local_tile_id == 0){
+      mPut(0x5CA00000, remote + ACC_BASE);
+      mPut(0x00001000, remote + ACC_BASE + 1);
+      mPut(0x00000000, remote + ACC_BASE + 2);
+      mPut(0x00000000, remote + ACC_BASE + 3);
+      mPut(0x00000000, remote + ACC_BASE + 4);   //- 1.0
+      mPut(0x3FF00000, remote + ACC_BASE + 5);
+      mFence();
+   }
+   mBarrier(0);
+
+   //- Four pairs (size code 3) and one fp64 add (size code 2)
+   mScatterAddX(ACC_BASE, SPAD_TILE, 3);
+   mAccD(mq_ACC_ADD, 0, v);
+   mAccD(mq_ACC_MIN, 1, v);
+   mAccD(mq_ACC_MAX, 2, v);
+   mAccD(mq_ACC_ADD, 3, 0);
+   mScatterAddX(ACC_BASE, SPAD_TILE, 2);
+   mAccF64D(4, 0x00000000, 0x3FF00000);
+   mFence();
+   mBarrier(0);
+
+   //- Read the words back
+   local = (((uint32_t) acc) >> 2) + (local_tile_id << 12);
+   for (int j=0; j<WORDS; j++){
+      mGet(remote + ACC_BASE + j, local + j);
+   }
+   mFence();
+
+   if (acc[0] != 0x5CA0000B) errors++;
+   if (acc[1] != 1)          errors++;
+   if (acc[2] != 10)         errors++;
+   if (acc[4] != 0)          errors++;
+   if (acc[5] != 0x40080000) errors++;   //- 3.0
+   for (int k=0; k<N; k++){
+      result[k] = (errors == 0) ? 0x900D900D : 0xBAD0BAD0;
+   }
+
+  return 1;
+}
+//   000-000 0
+//   001-000 8
+//   000-001 1
+//   001-001 9
@@ -0,0 +1,110 @@
+// *************************************************************************
+// 
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues 
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California, 
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+// 
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative 
+// works, and perform publicly and display publicly, and to permit others 
+// to do so.
+//
+// *************************************************************************
+
+/* ////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : The pico in tile 00 gathers and scatter-adds
+//               words of the scratchpad in tile 01 (spad_gather)
+// File        : pico_spad_gather.c
+// Notes       :
+// - A table of N words and a list of N indices are written in the
+//   scratchpad with mPut. mGatherX + mGetD brings back
+//   table[idx[k]] and the pico checks them.
+// - mScatterAddX sends 2*ACC (index, value) pairs that add k to
+//   acc[k % ACC]: acc[j] ends as 5CA00000 + 2j + ACC.
+// - result: 16 x 900D900D (gather and scatter-add right) or
+//   BAD0BAD0. The scratchpad keeps the 8 5CA000xx words.
+// ///////////////////////////////////////////////////////////////*/
+
+#include "mq.h"
+#include <stdlib.h>
+
+#define SPAD_TILE 8     //- Tile 01
+#define TAB_BASE  1024  //- Word addresses in the scratchpad
+#define IDX_BASE  1100
+#define ACC_BASE  1200
+#define N         16    //- Gathered words (size code 4)
+#define ACC       8     //- Accumulated words, 2*ACC pairs (size code 5)
+
+volatile uint32_t gathered[N];
+volatile uint32_t acc[ACC];
+volatile uint32_t result[N];
+
+uint32_t main (int argc, char *argv[])
+{
+   //- Declare variables
+   uint32_t local_tile_id;
+   uint32_t local;
+   uint32_t remote;
+   uint32_t errors = 0;
+
+   //- Parse Options
+   local_tile_id = atoi(argv[1]);
+   remote = SPAD_TILE << 12;
+
+   //- Table, indices and accumulators in the scratchpad
+   for (int k=0; k<N; k++){
+      mPut(0x7AB00000 | k, remote + TAB_BASE + k);
+      mPut((k*5) % N, remote + IDX_BASE + k);
+   }
+   for (int j=0; j<ACC; j++){
+      mPut(0x5CA00000, remote + ACC_BASE + j);
+   }
+   mFence();
+
+   //- Gather: table[idx[k]]
+   local = (((uint32_t) gathered) >> 2) + (local_tile_id << 12);
+   mGatherX(IDX_BASE, SPAD_TILE, 4);
+   mGetD(local, TAB_BASE);
+   mFence();
+   for (int k=0; k<N; k++){
+      if (gathered[k] != (0x7AB00000 | ((k*5) % N))) errors++;
+   }
+
+   //- Scatter-add: acc[k % ACC] += k
+   mScatterAddX(ACC_BASE, SPAD_TILE, 5);
+   for (int k=0; k<2*ACC; k++){
+      mPutD(k % ACC, k);
+   }
+   mFence();
+
+   //- Read the accumulators back
+   local = (((uint32_t) acc) >> 2) + (local_tile_id << 12);
+   for (int j=0; j<ACC; j++){
+      mGet(remote + ACC_BASE + j, local + j);
+   }
+   mFence();
+   for (int j=0; j<ACC; j++){
+      if (acc[j] != 0x5CA00000 + 2*j + ACC) errors++;
+   }
+
+   for (int k=0; k<N; k++){
+      result[k] = (errors == 0) ? 0x900D900D : 0xBAD0BAD0;
+   }
+
+  return 1;
+}
+//   000-000 0
+//   001-000 8
+//   000-001 1
+//   001-001 9
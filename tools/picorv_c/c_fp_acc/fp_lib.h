@@ -47,6 +47,28 @@ double fp_generic(double a, double b, uint32_t type)
    return res;
 }
 
+#ifdef PICO_FPU
+/* pico_fp tiles: add, subtract and multiply in the local unit */
+#include "fpu.h"
+
+double __adddf3(double a, double b)
+{
+   fp_issue(a,b,fp_DO_ADD);
+   return fp_result();
+}
+
+double __subdf3(double a, double b)
+{
+   fp_issue(a,b,fp_DO_SUB);
+   return fp_result();
+}
+
+double __muldf3(double a, double b)
+{
+   fp_issue(a,b,fp_DO_MUL);
+   return fp_result();
+}
+#else
 double __adddf3(double a, double b)
 {
    double res = fp_generic(a,b,FP_ADD10);
@@ -58,6 +80,7 @@ double __muldf3(double a, double b)
    double res = fp_generic(a,b,FP_MUL9);
    return res;
 }
+#endif
 
 double __divdf3(double a, double b)
 {
@@ -0,0 +1,97 @@
+// *************************************************************************
+// 
+// *** Copyright Notice ***
+//
+// P38 heterogeneous multi-tiled system with support for message queues 
+// (MoSAIC) Copyright (c) 2024, The Regents of the University of California, 
+// through Lawrence Berkeley National Laboratory (subject to receipt of
+// any required approvals from the U.S. Dept. of Energy). All rights reserved.
+// 
+// If you have questions about your rights to use or distribute this software,
+// please contact Berkeley Lab's Intellectual Property Office at
+// IPO@lbl.gov.
+//
+// NOTICE.  This Software was developed under funding from the U.S. Department
+// of Energy and the U.S. Government consequently retains certain rights.  As
+// such, the U.S. Government has been granted for itself and others acting on
+// its behalf a paid-up, nonexclusive, irrevocable, worldwide license in the
+// Software to reproduce, distribute copies to the public, prepare derivative 
+// works, and perform publicly and display publicly, and to permit others 
+// to do so.
+//
+// *************************************************************************
+
+/////////////////////////////////////////////////////////////////
+// Date        : Oct 18 2026
+// Description : Double precision unit of the pico (pico_fp tiles)
+// File        : fpu.h
+// Notes       :
+// - A double is a register pair {hi, lo}, as in the soft-float ABI.
+// - fpAdd/fpSub/fpMul do not wait for the result. Up to 8
+//   operations can be in flight; fpRes/fpResH return the results
+//   in issue order (fpResH pops the result).
+////////////////////////////////////////////////////////////////
+
+#ifndef SRC_MAIN_C_FPU_H
+#define SRC_MAIN_C_FPU_H
+
+#include "xcustom.h"
+
+#define XCUSTOM_FP 2
+
+#define fp_DO_A    0
+#define fp_DO_ADD  1
+#define fp_DO_SUB  2
+#define fp_DO_MUL  3
+#define fp_DO_RES  4
+#define fp_DO_RESH 5
+#define fp_DO_STAT 6
+
+#define fpA(lo, hi) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_FP, lo, hi, fp_DO_A, 0);
+
+#define fpAdd(lo, hi) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_FP, lo, hi, fp_DO_ADD, 0);
+
+#define fpSub(lo, hi) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_FP, lo, hi, fp_DO_SUB, 0);
+
+#define fpMul(lo, hi) \
+  PCPI_INSTRUCTION_0_R_R(XCUSTOM_FP, lo, hi, fp_DO_MUL, 0);
+
+#define fpRes(lo) \
+  PCPI_INSTRUCTION_R_R_0(XCUSTOM_FP, lo, 0, fp_DO_RES, 0);
+
+#define fpResH(hi) \
+  PCPI_INSTRUCTION_R_R_0(XCUSTOM_FP, hi, 0, fp_DO_RESH, 0);
+
+/* Operations issued and not popped yet */
+#define fpStat(n) \
+  PCPI_INSTRUCTION_R_R_0(XCUSTOM_FP, n, 0, fp_DO_STAT, 0);
+
+typedef union {
+   double   d;
+   uint32_t w[2];
+} fp_pair;
+
+/* Issue a <op> b, the result is read with fp_result() */
+static inline void fp_issue(double a, double b, uint32_t op)
+{
+   fp_pair x, y;
+   x.d = a;
+   y.d = b;
+   fpA(x.w[0], x.w[1]);
+   if (op == fp_DO_ADD)      { fpAdd(y.w[0], y.w[1]); }
+   else if (op == fp_DO_SUB) { fpSub(y.w[0], y.w[1]); }
+   else                      { fpMul(y.w[0], y.w[1]); }
+}
+
+static inline double fp_result(void)
+{
+   fp_pair r;
+   fpRes(r.w[0]);
+   fpResH(r.w[1]);
+   return r.d;
+}
+
+#endif
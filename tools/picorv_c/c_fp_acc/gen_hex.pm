@@ -124,7 +124,7 @@ sub gen_defines{
       my @row = @{$tile_array[$i]};
       for (my $j=0; $j<$param{'c'}; $j=$j+1){
          my $type = $row[$j];
-         if ($type eq 'pico'){
+         if ($type eq 'pico' || $type eq 'pico_fp' || $type eq 'pico_pipe'){
             $pico_count = $pico_count + 1;
          }
          $type = uc($type);
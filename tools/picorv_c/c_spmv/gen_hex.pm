@@ -39,6 +39,7 @@ use strict;
 ##################################
 
 our $addr_range = 16384;
+our $spadx_base = 0x80000000; #- SPADX<id> regions: $spadx_base + (id << 24)
 our $temp_dir = "temp_files";
 our $end = 8;
 
@@ -91,11 +92,11 @@ sub clean_temp{
    my %param = %{$_[0]};
    my $id    = $_[1];
 
-   #- Address range for this tile
-   my $addr = sprintf("%08x", ($id * $addr_range)/4);
-   #- Extract the header
-   my @addr_a = split('',$addr);
-   $addr = join('',@addr_a[0..4]);
+   #- Word address ranges for this tile: its window in the array and,
+   #  for a large scratchpad, its SPADX region. Both start at word 0.
+   my $base   = ($id * $addr_range)/4;
+   my $xbase  = ($spadx_base + ($id << 24))/4;
+   my $xwords = $param{'spad_kb'}*1024/4;
 
    my $file = $param{'c_code'}."32.hex";
    open(my $FH, '<', $file) or die "Couldn't open $file $!\n";
@@ -104,18 +105,22 @@ sub clean_temp{
    my $valid_line = 0;
    while(<$FH>){
       my $line = $_;
-      if ($line =~ /\@$addr/){ #- Address
+      if ($line =~ /^\@([0-9a-fA-F]+)/){ #- Address
+         my $a = hex($1);
          $valid_line = 1;
-         print $FH1 $line;
-      }elsif ($line =~ /\@/){
-         $valid_line = 0;
+         if ($a >= $base && $a < $base + $addr_range/4){
+            printf $FH1 "\@%08x\n", $a - $base;
+         }elsif ($a >= $xbase && $a < $xbase + $xwords){
+            printf $FH1 "\@%08x\n", $a - $xbase;
+         }else{
+            $valid_line = 0;
+         }
       }elsif($valid_line){
          print $FH1 $line;
       }
    }
    close($FH);
    close($FH1);
-   `sed -i s\/\@$addr\/\@00000\/ $param{'c_code'}32_$id.hex`;
    if ($param{'keep'}){
       `mv $file $temp_dir/$new_file`;
    }
@@ -168,6 +173,12 @@ sub check_params{
       print "INFO: Set the tile array size to default 4x4\n";
       $param{'c'} = $param{'r'};
    };
+
+   #- Scratchpad tile capacity, as spad_kb in the MoSAIC testcase
+   if (exists $param{'spad_kb'}){
+   }else{
+      $param{'spad_kb'} = 16;
+   };
    
    return \%param;
 
@@ -226,6 +237,14 @@ sub gen_mem_map{
 
          my $addr_hex = sprintf("%08x", $origin);
          print $FH "\t$name : ORIGIN = 0x$addr_hex, LENGTH = $length\n";
+
+         #- Scratchpad past its first 16KB: only reached with mPutX/mGetX,
+         #  see spadX_tile/spadX_addr in mq.h
+         if ($type eq 'SPAD' && $param{'spad_kb'} > 16){
+            my $x_origin = sprintf("%08x", $spadx_base + ($id << 24) + $addr_range);
+            my $x_length = sprintf("%06X", $param{'spad_kb'}*1024 - $addr_range);
+            print $FH "\tSPADX$id (rw) : ORIGIN = 0x$x_origin, LENGTH = 0x$x_length\n";
+         }
       }
    }
 
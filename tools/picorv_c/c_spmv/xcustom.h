@@ -49,18 +49,18 @@
 #define CUSTOM_2 0b1011011
 #define CUSTOM_3 0b1111011
 
-#define PCPI_INSTRUCTION_0_R_R(x, rs1, rs2, func3)                                   \
+#define PCPI_INSTRUCTION_0_R_R(x, rs1, rs2, func3, func2)                            \
   {                                                                                  \
     asm volatile(                                                                    \
-        ".insn r " STR(CAT(CUSTOM_, x)) ", " STR(func3) ", " STR(0x0) ", x0, %0, %1" \
+        ".insn r " STR(CAT(CUSTOM_, x)) ", " STR(func3) ", " STR(func2) ", x0, %0, %1" \
         :                                                                            \
         : "r"(rs1), "r"(rs2));                                                       \
   }
 
-#define PCPI_INSTRUCTION_R_R_0(x, rd, rs1, func3)                                    \
+#define PCPI_INSTRUCTION_R_R_0(x, rd, rs1, func3, func2)                             \
   {                                                                                  \
     asm volatile(                                                                    \
-        ".insn r " STR(CAT(CUSTOM_, x)) ", " STR(func3) ", " STR(0x0) ", %0, %1, x0" \
+        ".insn r " STR(CAT(CUSTOM_, x)) ", " STR(func3) ", " STR(func2) ", %0, %1, x0" \
         : "=r"(rd)                                                                   \
         : "r"(rs1));                                                                 \
   }